@@ -911,7 +911,7 @@ func (rt *CmdRunner) executeRadioParam(cc *CommandContext, cmd *RadioParamCmd) {
 			fval.SetFloat(newVal)
 		}
 		if isChanged {
-			rm.OnParametersModified()
+			sim.Dispatcher().OnRadioModelParametersModified()
 		}
 	})
 }
@@ -1312,6 +1312,12 @@ func (rt *CmdRunner) executeSave(cc *CommandContext, cmd *SaveCmd) {
 	rt.postAsyncWait(cc, func(sim *simulation.Simulation) {
 		networkConfig := sim.ExportNetwork()
 		nodesConfig := sim.ExportNodes(&networkConfig)
+		if cmd.Operation == "checkpoint" {
+			if err = sim.ExportNodesFlash(nodesConfig); err != nil {
+				err = fmt.Errorf("checkpoint of node flash failed: %v", err)
+				return
+			}
+		}
 
 		root := simulation.YamlConfigFile{
 			NetworkConfig: networkConfig,
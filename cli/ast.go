@@ -566,9 +566,9 @@ type LoadCmd struct {
 
 // noinspection GoVetStructTag
 type SaveCmd struct {
-	Cmd       struct{} `"save"`                   //nolint
-	Filename  string   `@String`                  //nolint
-	Operation string   `[ @("all"|"topo"|"py") ]` //nolint
+	Cmd       struct{} `"save"`                                //nolint
+	Filename  string   `@String`                               //nolint
+	Operation string   `[ @("all"|"topo"|"py"|"checkpoint") ]` //nolint
 }
 
 // noinspection GoVetStructTag
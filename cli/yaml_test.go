@@ -56,6 +56,7 @@ nodes:
       type: router
       version: v12
       pos: [200, 100, 0]
+      flash: /wBapf8=
 `
 
 func TestYamlArrayUnmarshall(t *testing.T) {
@@ -74,4 +75,6 @@ func TestYamlConfigUnmarshall(t *testing.T) {
 	assert.Equal(t, 3, len(cfgFile.NetworkConfig.Position))
 	assert.Equal(t, 4, len(cfgFile.NodesList))
 	assert.Equal(t, "v11", *cfgFile.NodesList[2].Version)
+	assert.Equal(t, "", cfgFile.NodesList[2].Flash)
+	assert.Equal(t, "/wBapf8=", cfgFile.NodesList[3].Flash)
 }
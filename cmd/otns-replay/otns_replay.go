@@ -28,11 +28,13 @@ package main
 
 import (
 	"context"
+	"encoding/json"
 	"flag"
 	"net"
 	"net/http"
 	"os"
 
+	"github.com/openthread/ot-ns/dispatcher"
 	"github.com/openthread/ot-ns/logger"
 	"github.com/openthread/ot-ns/progctx"
 	"github.com/openthread/ot-ns/visualize/grpc/pb"
@@ -43,9 +45,11 @@ import (
 
 var args struct {
 	ReplayFile string
+	Trace      bool
 }
 
 func parseArgs() {
+	flag.BoolVar(&args.Trace, "trace", false, "replay an event trace (recorded with 'otns -trace') against the dispatcher only, and print the benchmark result as JSON")
 	flag.Parse()
 
 	if len(flag.Args()) != 1 {
@@ -62,6 +66,10 @@ func main() {
 	logger.SetLevel(logger.InfoLevel)
 
 	ctx := progctx.New(context.Background())
+	if args.Trace {
+		replayTrace(ctx)
+		return
+	}
 
 	server := grpc.NewServer(grpc.ReadBufferSize(1024*8), grpc.WriteBufferSize(1024*1024*1))
 	gs := &grpcService{replayFile: args.ReplayFile}
@@ -99,3 +107,13 @@ func checkReplayFile(filename string) {
 		logger.Panicf("%s is not a valid replay", filename)
 	}
 }
+
+func replayTrace(ctx *progctx.ProgCtx) {
+	logger.SetLevel(logger.WarnLevel)
+	res, err := dispatcher.ReplayTrace(ctx, args.ReplayFile)
+	logger.PanicIfError(err)
+
+	enc := json.NewEncoder(os.Stdout)
+	enc.SetIndent("", "  ")
+	logger.PanicIfError(enc.Encode(res))
+}
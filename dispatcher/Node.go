@@ -80,6 +80,14 @@ type Node struct {
 
 	conn          net.Conn
 	msgId         uint64
+	txCodec       HeaderCodec         // header format and state of events sent to the node
+	txBuf         []byte              // reused buffer for serializing events sent to the node
+	radioState    RadioStateEventData // last radio state reported by the node
+	logLevel      RfSimParamValue     // last log level set on the node, or RfSimValueInvalid if not yet set
+	logLevelRsps  int                 // pending responses to log level set events
+	profCounters  map[string]uint64   // last profiling counters pushed by the node, or nil if none
+	isWakeupsUsed bool                // if the node reports its wake-up deadlines in its sleep events
+	rxDispatchSeq uint64              // Dispatcher.rxDispatchSeq value of the last frame dispatched to the node
 	err           error
 	failureCtrl   *FailureCtrl
 	isFailed      bool
@@ -119,6 +127,7 @@ func newNode(d *Dispatcher, nodeid NodeId, cfg *NodeConfig) *Node {
 		RadioNode:   radiomodel.NewRadioNode(nodeid, radioCfg),
 		joinerState: OtJoinerStateIdle,
 		logger:      logger.GetNodeLogger(d.cfg.OutputDir, d.cfg.SimulationId, cfg),
+		logLevel:    RfSimValueInvalid,
 	}
 
 	nc.failureCtrl = newFailureCtrl(nc, NonFailTime)
@@ -198,7 +207,8 @@ func (node *Node) sendEvent(evt *Event) {
 		}
 	}
 
-	err := node.sendRawData(evt.Serialize())
+	node.txBuf = evt.SerializeTo(node.txBuf[:0], &node.txCodec)
+	err := node.sendRawData(node.txBuf)
 	if err != nil {
 		node.logger.Error(err)
 		node.err = err
@@ -229,6 +239,12 @@ func (node *Node) IsConnected() bool {
 	return node.conn != nil
 }
 
+// GetProfileCounters returns the profiling counters last pushed by the node, which happens on each get of
+// the ParamProfile RfSim parameter while profiling is enabled. It returns nil if the node pushed none yet.
+func (node *Node) GetProfileCounters() map[string]uint64 {
+	return node.profCounters
+}
+
 func (node *Node) Fail() {
 	if !node.isFailed {
 		node.isFailed = true
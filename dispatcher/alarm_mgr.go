@@ -29,6 +29,7 @@ package dispatcher
 import (
 	"container/heap"
 
+	"github.com/openthread/ot-ns/event"
 	"github.com/openthread/ot-ns/logger"
 	. "github.com/openthread/ot-ns/types"
 )
@@ -114,6 +115,25 @@ func (am *alarmMgr) SetTimestamp(nodeid int, timestamp uint64) {
 	}
 }
 
+// SetWakeups merges the wake-up deadlines reported by a node at time now into its next alarm, which is the
+// earliest unconditional deadline. Conditional deadlines don't wake up the node. It returns the number of
+// conditional deadlines that were skipped.
+func (am *alarmMgr) SetWakeups(nodeid NodeId, now uint64, wakeups []event.SleepWakeup) int {
+	timestamp := Ever
+	numSkipped := 0
+	for _, w := range wakeups {
+		if w.Flags&event.WakeupFlagUnconditional == 0 {
+			numSkipped++
+			continue
+		}
+		if w.Delay < Ever-now && now+w.Delay < timestamp {
+			timestamp = now + w.Delay
+		}
+	}
+	am.SetTimestamp(nodeid, timestamp)
+	return numSkipped
+}
+
 func (am *alarmMgr) GetTimestamp(nodeid int) uint64 {
 	e := am.events[nodeid]
 	logger.AssertNotNil(e)
@@ -27,6 +27,7 @@
 package dispatcher
 
 import (
+	"bytes"
 	"encoding/binary"
 	"errors"
 	"fmt"
@@ -89,6 +90,7 @@ type Dispatcher struct {
 		UartWriteEvents  uint64
 		LogWriteEvents   uint64
 		HostEvents       uint64
+		TrelEvents       uint64
 		OtherEvents      uint64
 		// Packet-related event dispatching counters
 		DispatchByExtAddrSucc   uint64
@@ -96,6 +98,10 @@ type Dispatcher struct {
 		DispatchByShortAddrSucc uint64
 		DispatchByShortAddrFail uint64
 		DispatchAllInRange      uint64
+		DispatchTrelSucc        uint64
+		DispatchTrelFail        uint64
+		// Node execution counters
+		SkippedWakeups uint64 // conditional wake-up deadlines reported by nodes, for which no wake-up is done
 		// Other counters
 		TopologyChanges uint64
 	}
@@ -114,10 +120,18 @@ type Dispatcher struct {
 	eventQueue            *sendQueue
 	nodes                 map[NodeId]*Node
 	nodesArray            []*Node
+	neighbors             *neighborIndex
+	partitions            *partitionSet
+	pdesAheadTime         uint64 // in PDES mode, the latest time up to which a partition was processed.
+	rxDispatchSeq         uint64
 	deletedNodes          map[NodeId]struct{}
 	aliveNodes            map[NodeId]struct{}
 	pcap                  pcap.File
 	pcapFrameChan         chan pcap.Frame
+	pcapNodes             map[NodeId]struct{}
+	pcapChannels          map[ChannelId]struct{}
+	trace                 *traceWriter // nil if no event trace is recorded.
+	trel                  *trelState
 	vis                   visualize.Visualizer
 	taskChan              chan func()
 	speed                 float64
@@ -155,11 +169,16 @@ func NewDispatcher(ctx *progctx.ProgCtx, cfg *Config, cbHandler CallbackHandler)
 		alarmMgr:           newAlarmMgr(),
 		nodes:              make(map[NodeId]*Node),
 		nodesArray:         make([]*Node, 0),
+		neighbors:          newNeighborIndex(),
+		partitions:         newPartitionSet(),
+		trel:               newTrelState(),
 		deletedNodes:       map[NodeId]struct{}{},
 		aliveNodes:         make(map[NodeId]struct{}),
 		extaddrMap:         map[uint64]*Node{},
 		rloc16Map:          rloc16Map{},
 		pcapFrameChan:      make(chan pcap.Frame, 100000),
+		pcapNodes:          map[NodeId]struct{}{},
+		pcapChannels:       map[ChannelId]struct{}{},
 		speed:              cfg.Speed,
 		speedStartRealTime: time.Now(),
 		vis:                vis,
@@ -173,11 +192,25 @@ func NewDispatcher(ctx *progctx.ProgCtx, cfg *Config, cbHandler CallbackHandler)
 	}
 	d.speed = d.normalizeSpeed(d.speed)
 	if d.cfg.PcapEnabled {
-		d.pcap, err = pcap.NewFile("current.pcap", cfg.PcapFrameType, true)
+		d.pcap, err = pcap.NewFileWithOptions("current.pcap", cfg.PcapFrameType, true, cfg.PcapOptions)
 		logger.PanicIfError(err)
+		for _, id := range cfg.PcapNodes {
+			d.pcapNodes[id] = struct{}{}
+		}
+		for _, ch := range cfg.PcapChannels {
+			d.pcapChannels[ch] = struct{}{}
+		}
 		d.waitGroup.Add(1)
 		go d.pcapFrameWriter()
 	}
+	if d.cfg.TraceFile != "" {
+		if d.cfg.Pdes {
+			logger.Warnf("event trace is not recorded in PDES mode")
+		} else {
+			d.trace, err = newTraceWriter(d.cfg.TraceFile, d.cfg.RandomSeed)
+			logger.PanicIfError(err)
+		}
+	}
 
 	d.waitGroup.Add(1)
 	go d.eventsReader()
@@ -218,6 +251,11 @@ func (d *Dispatcher) Stop() {
 	close(d.pcapFrameChan)
 	logger.Tracef("waiting for dispatcher threads to stop ...")
 	d.waitGroup.Wait()
+	if d.trace != nil {
+		if err := d.trace.Close(); err != nil {
+			logger.Errorf("failed to write event trace: %v", err)
+		}
+	}
 }
 
 func (d *Dispatcher) isStopping() bool {
@@ -349,11 +387,16 @@ func (d *Dispatcher) goSimulateForDuration(duration goDuration) {
 	logger.AssertTrue(d.CurTime <= d.pauseTime)
 
 	for d.CurTime <= d.pauseTime {
-		d.handleTasks()
-
-		if d.currentGoDuration.cancel || d.isStopping() {
+		if d.isStopping() {
 			break
 		}
+		// tasks may interact with nodes, so are only handled when no partition runs ahead in time.
+		if d.pdesAheadTime <= d.CurTime {
+			d.handleTasks()
+			if d.currentGoDuration.cancel {
+				break
+			}
+		}
 
 		// keep receiving events from OT nodes until all are asleep i.e. will not produce more events.
 		d.RecvEvents()
@@ -383,19 +426,33 @@ func (d *Dispatcher) goSimulateForDuration(duration goDuration) {
 
 // handleRecvEvent is the central handler for all events externally received from nodes/entities.
 // It may only process events immediately that are to be executed at time d.CurTime. Future events
-// will need to be queued (scheduled).
+// will need to be queued (scheduled). Pooled events are released here, unless they are queued for
+// later processing (see processNextEvent) or passed on to the CallbackHandler.
 func (d *Dispatcher) handleRecvEvent(evt *Event) {
 	nodeid := evt.NodeId
 	node := d.nodes[nodeid]
 	if node == nil {
 		logger.Warnf("Event (type %v) received from unknown Node %v, discarding.", evt.Type, evt.NodeId)
+		evt.Release()
 		return
 	}
+	isRetained := false
 
 	if node.conn == nil {
 		node.conn = evt.Conn // store socket connection for this node.
 	}
+	if node.CurTime > d.CurTime {
+		// in PDES mode, the node's partition may run ahead: handle the event at the node's time.
+		gvt := d.CurTime
+		d.CurTime = node.CurTime
+		defer func() {
+			d.CurTime = gvt
+		}()
+	}
 	evt.Timestamp = d.CurTime // timestamp the incoming event
+	if d.trace != nil {
+		d.trace.recordEvent(d.CurTime, evt)
+	}
 
 	// TODO document this use (for alarm messages)
 	delay := evt.Delay
@@ -404,17 +461,44 @@ func (d *Dispatcher) handleRecvEvent(evt *Event) {
 	}
 
 	switch evt.Type {
+	case EventTypeRadioStateSleep:
+		// a combined event is handled as a radio-state event (if any state is reported), then as sleep event.
+		if evt.RadioStateSleepData.Fields&RadioStateFieldReport != 0 {
+			d.Counters.RadioEvents += 1
+			evt.RadioStateSleepData.ApplyTo(&node.radioState)
+			d.eventQueue.Add(&Event{
+				Type:           EventTypeRadioState,
+				NodeId:         nodeid,
+				Timestamp:      d.CurTime,
+				Delay:          evt.RadioStateSleepData.RadioStateDelay,
+				MsgId:          evt.MsgId,
+				RadioStateData: node.radioState,
+			})
+		}
+		fallthrough
 	case EventTypeAlarmFired:
 		d.Counters.AlarmEvents += 1
 		if evt.MsgId == node.msgId { // if OT-node has seen my last sent event (so is done processing)
 			d.setSleeping(node.Id)
 		}
-		d.alarmMgr.SetTimestamp(nodeid, d.CurTime+delay) // schedule future wake-up of node
+		if evt.Type == EventTypeRadioStateSleep && evt.RadioStateSleepData.Fields&RadioStateFieldWakeups != 0 {
+			// the wake-up list includes all deadlines, also those of radio-state events sent before.
+			node.isWakeupsUsed = true
+			skipped := d.alarmMgr.SetWakeups(nodeid, d.CurTime, evt.RadioStateSleepData.Wakeups)
+			d.Counters.SkippedWakeups += uint64(skipped)
+		} else {
+			d.alarmMgr.SetTimestamp(nodeid, d.CurTime+delay) // schedule future wake-up of node
+		}
+	case EventTypeRadioState:
+		d.Counters.RadioEvents += 1
+		node.radioState = evt.RadioStateData
+		d.eventQueue.Add(evt)
+		isRetained = true
 	case EventTypeRadioCommStart,
-		EventTypeRadioState,
 		EventTypeRadioChannelSample:
 		d.Counters.RadioEvents += 1
 		d.eventQueue.Add(evt)
+		isRetained = true
 	case EventTypeStatusPush:
 		d.Counters.StatusPushEvents += 1
 		d.handleStatusPush(node, string(evt.Data))
@@ -423,13 +507,79 @@ func (d *Dispatcher) handleRecvEvent(evt *Event) {
 		d.cbHandler.OnUartWrite(node.Id, evt.Data)
 	case EventTypeLogWrite:
 		d.Counters.LogWriteEvents += 1
-		d.cbHandler.OnLogWrite(node.Id, evt.Data)
+		// a single event may contain multiple log lines, each terminated by a newline.
+		data := evt.Data
+		for len(data) > 0 {
+			n := bytes.IndexByte(data, '\n') + 1
+			if n == 0 {
+				n = len(data)
+			}
+			d.cbHandler.OnLogWrite(node.Id, data[:n])
+			data = data[n:]
+		}
 	case EventTypeExtAddr:
 		d.Counters.OtherEvents += 1
 		var extaddr = binary.BigEndian.Uint64(evt.Data[0:8])
 		node.onStatusPushExtAddr(extaddr)
 	case EventTypeNodeInfo:
 		d.Counters.OtherEvents += 1
+		if sc, ok := node.conn.(*shmConn); ok {
+			d.acceptShmTransport(node, sc)
+		}
+		d.updateNodeLogLevel(node)
+	case EventTypeRadioRfSimParamRsp:
+		if node.logLevelRsps > 0 && (evt.RfSimParamData.Param == ParamLogLevel ||
+			evt.RfSimParamData.Param == ParamUnknown) {
+			// response to a log level set by the dispatcher; not passed on. Older nodes respond 'unknown'.
+			d.Counters.OtherEvents += 1
+			node.logLevelRsps -= 1
+			break
+		}
+		d.Counters.OtherEvents += 1
+		d.cbHandler.OnRfSimEvent(node.Id, evt)
+		isRetained = true
+	case EventTypeRadioStateSleepOffer:
+		d.Counters.OtherEvents += 1
+		node.sendEvent(&Event{
+			Timestamp: d.CurTime,
+			Type:      EventTypeRadioStateSleepAccept,
+		})
+	case EventTypeSleepWakeupsOffer:
+		d.Counters.OtherEvents += 1
+		node.sendEvent(&Event{
+			Timestamp: d.CurTime,
+			Type:      EventTypeSleepWakeupsAccept,
+		})
+	case EventTypeRadioEnergyOffer:
+		d.Counters.OtherEvents += 1
+		if d.energyAnalyser != nil {
+			radioEnergy := d.energyAnalyser.GetNode(node.Id)
+			logger.AssertNotNil(radioEnergy)
+			radioEnergy.StartRadioEnergyReports(d.CurTime)
+			interval := make([]byte, 8)
+			binary.LittleEndian.PutUint64(interval, energy.ComputePeriod)
+			node.sendEvent(&Event{
+				Timestamp: d.CurTime,
+				Type:      EventTypeRadioEnergyAccept,
+				Data:      interval,
+			})
+		}
+	case EventTypeRadioEnergy:
+		d.Counters.OtherEvents += 1
+		if d.energyAnalyser != nil {
+			radioEnergy := d.energyAnalyser.GetNode(node.Id)
+			logger.AssertNotNil(radioEnergy)
+			r := evt.RadioEnergyData
+			radioEnergy.SetRadioEnergy(r.EnergyState, r.DisabledUs, r.SleepUs, r.RxUs, r.TxUs, d.CurTime)
+		}
+	case EventTypeHeaderFormatOffer:
+		d.Counters.OtherEvents += 1
+		if d.cfg.CompactHeader && len(evt.Data) >= 1 && evt.Data[0] == HeaderFormatCompact {
+			d.setHeaderFormat(node, HeaderFormatCompact)
+		}
+	case EventTypeHeaderFormat:
+		d.Counters.OtherEvents += 1
+		node.logger.Debugf("node uses event header format %d", evt.Data[0])
 	case EventTypeNodeDisconnected:
 		d.Counters.OtherEvents += 1
 		logger.Debugf("%s socket disconnected.", node)
@@ -440,17 +590,72 @@ func (d *Dispatcher) handleRecvEvent(evt *Event) {
 		d.Counters.HostEvents += 1
 		d.sendMsgToHost(node, evt)
 		d.cbHandler.OnMsgToHost(node.Id, evt)
+		isRetained = true
 	case EventTypeUdpFromHost,
 		EventTypeIp6FromHost:
 		d.Counters.HostEvents += 1
 		evt.MustDispatch = true // asap resend again to the target (BR) node.
 		d.eventQueue.Add(evt)
+		isRetained = true
+	case EventTypeTrelBrowse,
+		EventTypeTrelService,
+		EventTypeTrelData:
+		d.Counters.TrelEvents += 1
+		d.handleTrelEvent(node, evt)
 	default:
 		d.Counters.OtherEvents += 1
 		d.cbHandler.OnRfSimEvent(node.Id, evt)
+		isRetained = true
+	}
+
+	if !isRetained {
+		evt.Release()
 	}
 }
 
+// acceptShmTransport notifies the node that its offered shared-memory transport is used from now on.
+func (d *Dispatcher) acceptShmTransport(node *Node, sc *shmConn) {
+	node.sendEvent(&Event{
+		Timestamp: d.CurTime,
+		Type:      EventTypeShmAccept,
+	})
+	sc.activate(&node.txCodec)
+	node.logger.Debugf("using shared-memory event transport")
+}
+
+// updateNodeLogLevel sets the node's log level to the highest level that is displayed or logged
+// to file for it, such that the node does not send log lines that would be discarded anyway.
+func (d *Dispatcher) updateNodeLogLevel(node *Node) {
+	if node.conn == nil {
+		return // set when the node connects.
+	}
+	level := node.logger.MaxLevel()
+	if level > logger.DebugLevel {
+		level = logger.DebugLevel // highest OT log level
+	} else if level < logger.PanicLevel {
+		level = logger.PanicLevel // OT log level 'none'
+	}
+	value := RfSimParamValue(level)
+	if value == node.logLevel {
+		return
+	}
+	node.logLevel = value
+	node.logLevelRsps += 1
+	_ = node.SendRfSimEvent(true, ParamLogLevel, value)
+}
+
+// setHeaderFormat notifies the node that the given event header format is used from now on, for
+// the events sent to it. The node responds in the same way, once it uses the format too.
+func (d *Dispatcher) setHeaderFormat(node *Node, format HeaderFormat) {
+	node.sendEvent(&Event{
+		Timestamp: d.CurTime,
+		Type:      EventTypeHeaderFormat,
+		Data:      []byte{format},
+	})
+	node.txCodec.Format = format
+	node.logger.Debugf("using event header format %d", format)
+}
+
 // RecvEvents receives events from nodes, and handles these, until there is no more alive node.
 func (d *Dispatcher) RecvEvents() int {
 	done := d.ctx.Done()
@@ -540,65 +745,30 @@ func (d *Dispatcher) processNextEvent(simSpeed float64) bool {
 	if nextEventTime > d.pauseTime {
 		return false
 	}
-	d.cbHandler.OnNextEventTime(nextEventTime)
+	if nextEventTime >= d.pdesAheadTime { // in PDES mode, the handler may already have moved to a later time.
+		d.cbHandler.OnNextEventTime(nextEventTime)
+	}
 	d.radioModel.OnNextEventTime(nextEventTime)
 	d.advanceTime(nextEventTime)
+	if d.trace != nil {
+		d.trace.recordStep(nextEventTime)
+	}
+
+	if d.cfg.Pdes {
+		d.processPartitionEvents()
+		return len(d.nodes) > 0
+	}
 
 	// process (if any) all queued events, that happen at exactly procUntilTime
 	procUntilTime := nextEventTime
 	for nextEventTime <= procUntilTime {
 		if nextAlarmTime <= nextSendTime {
-			// process next alarm
-			nextAlarm := d.alarmMgr.NextAlarm()
-			logger.AssertNotNil(nextAlarm)
-			node := d.nodes[nextAlarm.NodeId]
-			if node != nil {
-				d.advanceNodeTime(node, nextAlarm.Timestamp, false)
-			}
+			d.processAlarm(d.alarmMgr.NextAlarm())
 		} else {
-			// process next event from the queue
 			evt := d.eventQueue.PopNext()
 			logger.AssertTrue(evt.Timestamp == nextEventTime)
 			logger.AssertTrue(nextAlarmTime == d.CurTime || nextSendTime == d.CurTime)
-			node := d.nodes[evt.NodeId]
-			if node != nil {
-				// execute event - either a msg to be dispatched, or handled internally.
-				if !evt.MustDispatch {
-					switch evt.Type {
-					case EventTypeAlarmFired:
-						d.advanceNodeTime(node, evt.Timestamp, false)
-					case EventTypeRadioLog:
-						node.logger.Tracef("%s", string(evt.Data))
-					case EventTypeRadioCommStart:
-						if evt.RadioCommData.Error == OT_TX_TYPE_INTF {
-							// for interference transmissions, visualized here.
-							d.visSendInterference(evt.NodeId, BroadcastNodeId, evt.RadioCommData)
-						}
-						d.radioModel.HandleEvent(node.RadioNode, d.eventQueue, evt)
-					case EventTypeRadioState:
-						d.handleRadioState(node, evt)
-						d.radioModel.HandleEvent(node.RadioNode, d.eventQueue, evt)
-					default:
-						d.radioModel.HandleEvent(node.RadioNode, d.eventQueue, evt)
-					}
-				} else {
-					switch evt.Type {
-					case EventTypeRadioCommStart:
-						d.sendRadioCommRxStartEvents(node, evt)
-					case EventTypeRadioRxDone:
-						d.sendRadioCommRxDoneEvents(node, evt)
-					case EventTypeUdpFromHost,
-						EventTypeIp6FromHost:
-						node.sendEvent(evt) // TODO no loss on external network is simulated currently.
-					default:
-						if d.radioModel.OnEventDispatch(node.RadioNode, node.RadioNode, evt) {
-							node.sendEvent(evt)
-						}
-					}
-				}
-			} else if evt.NodeId > 0 {
-				logger.Warnf("processNextEvent() with deleted/unknown node %v: %v", evt.NodeId, evt)
-			}
+			d.processEvent(evt)
 		}
 		nextAlarmTime = d.alarmMgr.NextTimestamp()
 		nextSendTime = d.eventQueue.NextTimestamp()
@@ -608,6 +778,141 @@ func (d *Dispatcher) processNextEvent(simSpeed float64) bool {
 	return len(d.nodes) > 0
 }
 
+// processAlarm fires the alarm of a node, at the current time.
+func (d *Dispatcher) processAlarm(alarm *alarmEvent) {
+	logger.AssertNotNil(alarm)
+	node := d.nodes[alarm.NodeId]
+	if node != nil {
+		d.advanceNodeTime(node, alarm.Timestamp, false)
+	}
+}
+
+// processEvent executes an event from the eventQueue, at the current time.
+func (d *Dispatcher) processEvent(evt *Event) {
+	node := d.nodes[evt.NodeId]
+	if node != nil {
+		// execute event - either a msg to be dispatched, or handled internally.
+		if !evt.MustDispatch {
+			switch evt.Type {
+			case EventTypeAlarmFired:
+				d.advanceNodeTime(node, evt.Timestamp, false)
+			case EventTypeRadioLog:
+				node.logger.Tracef("%s", string(evt.Data))
+			case EventTypeRadioCommStart:
+				if evt.RadioCommData.Error == OT_TX_TYPE_INTF {
+					// for interference transmissions, visualized here.
+					d.visSendInterference(evt.NodeId, BroadcastNodeId, evt.RadioCommData)
+				}
+				d.radioModel.HandleEvent(node.RadioNode, d.eventQueue, evt)
+			case EventTypeRadioState:
+				d.handleRadioState(node, evt)
+				d.radioModel.HandleEvent(node.RadioNode, d.eventQueue, evt)
+			default:
+				d.radioModel.HandleEvent(node.RadioNode, d.eventQueue, evt)
+			}
+		} else {
+			switch evt.Type {
+			case EventTypeRadioCommStart:
+				d.sendRadioCommRxStartEvents(node, evt)
+			case EventTypeRadioRxDone:
+				d.sendRadioCommRxDoneEvents(node, evt)
+			case EventTypeUdpFromHost,
+				EventTypeIp6FromHost:
+				node.sendEvent(evt) // TODO no loss on external network is simulated currently.
+			case EventTypeTrelPeer,
+				EventTypeTrelData:
+				node.sendEvent(evt)
+			default:
+				if d.radioModel.OnEventDispatch(node.RadioNode, node.RadioNode, evt) {
+					node.sendEvent(evt)
+				}
+			}
+		}
+	} else if evt.NodeId > 0 {
+		logger.Warnf("processNextEvent() with deleted/unknown node %v: %v", evt.NodeId, evt)
+	}
+	evt.Release() // handlers above only keep copies of evt.
+}
+
+// processPartitionEvents processes the events of the time window that starts at the current time, in PDES
+// mode. Per partition, all events of its earliest time instant in the window are processed. The nodes of
+// different partitions then run in parallel, each at their own time; since partitions are radio-isolated,
+// this keeps the same causal order of events as processing one time instant at a time. Later events of a
+// partition are deferred to a next round. The window length, the lookahead, bounds how far a partition may
+// run ahead of the others. The radio model handles the events of each partition at the partition's own time,
+// while the callback handler only moves forward in time, to the latest time instant processed.
+func (d *Dispatcher) processPartitionEvents() {
+	gvt := d.CurTime
+	modelTime := gvt
+	if gvt > d.pdesAheadTime {
+		d.pdesAheadTime = gvt
+	}
+	windowEnd := gvt + d.partitions.getLookahead(d)
+	if windowEnd > d.pauseTime {
+		windowEnd = d.pauseTime + 1
+	}
+	instants := map[NodeId]uint64{} // per partition, the time instant processed in this round.
+	var deferredAlarms []alarmEvent
+	var deferredEvents []sendQueueEntry
+
+	// claim returns true if the node's event at time ts can be processed in this round.
+	claim := func(nodeid NodeId, ts uint64) bool {
+		node := d.nodes[nodeid]
+		if node == nil {
+			return true // event is discarded.
+		}
+		p := d.partitions.get(d, node)
+		if t, ok := instants[p]; ok && t != ts {
+			return false
+		}
+		instants[p] = ts
+		return true
+	}
+
+	for {
+		nextAlarmTime := d.alarmMgr.NextTimestamp()
+		nextSendTime := d.eventQueue.NextTimestamp()
+		ts := min(nextAlarmTime, nextSendTime)
+		if ts >= windowEnd {
+			break
+		}
+		d.CurTime = ts
+		if ts != modelTime {
+			modelTime = ts
+			d.radioModel.OnEventTime(ts)
+		}
+		if ts > d.pdesAheadTime {
+			d.pdesAheadTime = ts
+			d.cbHandler.OnNextEventTime(ts)
+		}
+		if nextAlarmTime <= nextSendTime {
+			alarm := d.alarmMgr.NextAlarm()
+			if claim(alarm.NodeId, ts) {
+				d.processAlarm(alarm)
+			} else {
+				deferredAlarms = append(deferredAlarms, *alarm)
+				d.alarmMgr.SetTimestamp(alarm.NodeId, Ever)
+			}
+		} else {
+			if claim(d.eventQueue.peek().nodeId, ts) {
+				d.processEvent(d.eventQueue.PopNext())
+			} else {
+				deferredEvents = append(deferredEvents, d.eventQueue.popEntry())
+			}
+		}
+	}
+
+	for _, alarm := range deferredAlarms {
+		if !d.IsAlive(alarm.NodeId) { // if woken up in this round, the node will report its new alarm time.
+			d.alarmMgr.SetTimestamp(alarm.NodeId, alarm.Timestamp)
+		}
+	}
+	for _, entry := range deferredEvents {
+		d.eventQueue.addEntry(entry) // keeps the original order of events.
+	}
+	d.CurTime = gvt
+}
+
 func (d *Dispatcher) eventsReader() {
 	defer d.waitGroup.Done()
 	defer logger.Tracef("dispatcher node socket threads stopped.")
@@ -634,44 +939,81 @@ func (d *Dispatcher) eventsReader() {
 			defer d.waitGroupNodes.Done()
 			defer myConn.Close()
 
-			buf := make([]byte, 65536)
+			framer := newEventFramer()
 			myNodeId := 0
+			var evtConn net.Conn = myConn
+			var myShmConn *shmConn
+			rxCodec := HeaderCodec{}
 
-			for {
-				n, err := myConn.Read(buf)
-
-				if errors.Is(err, io.EOF) {
-					break
-				} else if err != nil {
-					logger.NodeLogf(myNodeId, logger.ErrorLevel, "closing socket after read error: %+v", err)
-					break
-				}
-
+			// handleEvents handles the complete events in data, and returns the number of bytes used.
+			var handleEvents func(data []byte) int
+			handleEvents = func(data []byte) int {
 				bufIdx := 0
-				for bufIdx < n {
-					evt := &Event{}
-					nextEventOffset := evt.Deserialize(buf[bufIdx:n])
-					if nextEventOffset == 0 { // a complete event wasn't found.
-						logger.Panicf("Node %d - Too many events, or incorrect event data - may increase 'buf' size in Dispatcher.eventsReader()", myNodeId)
+				for bufIdx < len(data) {
+					evt := NewPooledEvent()
+					nextEventOffset := evt.DeserializeWith(data[bufIdx:], &rxCodec)
+					if nextEventOffset == 0 { // a complete event wasn't found; wait for more data of a batch.
+						evt.Release()
+						break
+					}
+					if d.trace != nil && evt.Type != EventTypeShmData {
+						evt.TraceData = rxCodec.ToDefaultFormat(data[bufIdx:], evt)
 					}
 					bufIdx += nextEventOffset
+
+					// shm-data event announces events in the node's shared-memory ring.
+					if evt.Type == EventTypeShmData && myShmConn != nil {
+						shmData, err := myShmConn.readEvents(int(binary.LittleEndian.Uint32(evt.Data)))
+						if err != nil {
+							logger.Panicf("Node %d - %v", myNodeId, err)
+						}
+						logger.AssertTrue(handleEvents(shmData) == len(shmData))
+						evt.Release()
+						continue
+					}
+
+					// the node's events that follow use the new header format.
+					if evt.Type == EventTypeHeaderFormat {
+						logger.AssertTrue(len(evt.Data) >= 1)
+						rxCodec.Format = evt.Data[0]
+					}
+
 					// First event received should be NodeInfo type. From this, we learn nodeId.
 					if myNodeId == 0 && evt.Type == EventTypeNodeInfo {
 						myNodeId = evt.NodeInfoData.NodeId
 						logger.AssertTrue(myNodeId > 0)
 						logger.Debugf("Init event received from new Node %d", myNodeId)
+						if d.cfg.ShmTransport && evt.NodeInfoData.ShmName != "" {
+							if shm, err := openShmTransport(evt.NodeInfoData.ShmName); err == nil {
+								myShmConn = newShmConn(myConn, shm)
+								evtConn = myShmConn
+							} else {
+								logger.NodeLogf(myNodeId, logger.WarnLevel, "shared-memory transport not used: %v", err)
+							}
+						}
 					}
 					evt.NodeId = myNodeId
-					evt.Conn = myConn
+					evt.Conn = evtConn
 					d.eventChan <- evt
 				}
+				return bufIdx
+			}
+
+			for {
+				err := framer.read(myConn, handleEvents)
 
-				if n > len(buf)/2 { // increase buf size when needed
-					buf = make([]byte, len(buf)*2)
-					logger.NodeLogf(myNodeId, logger.WarnLevel, "increasing eventsReader() buf size to: %d KB", len(buf)/1024)
+				if errors.Is(err, io.EOF) {
+					break
+				} else if err != nil {
+					logger.NodeLogf(myNodeId, logger.ErrorLevel, "closing socket after read error: %+v", err)
+					break
 				}
 			}
 
+			if myShmConn != nil {
+				myShmConn.closeShm()
+			}
+
 			// Once the socket is disconnected, signal one last event.
 			d.eventChan <- &Event{
 				Delay:  0,
@@ -711,7 +1053,7 @@ func (d *Dispatcher) sendRadioCommRxStartEvents(srcNode *Node, evt *Event) {
 	}
 
 	// record the to-be-received frame in Pcap file
-	if d.cfg.PcapEnabled {
+	if d.cfg.PcapEnabled && d.isPcapCaptured(srcNode, evt.RadioCommData.Channel) {
 		d.pcapFrameChan <- pcap.Frame{
 			Timestamp: evt.Timestamp,
 			Data:      evt.Data[RadioMessagePsduOffset:],
@@ -725,17 +1067,21 @@ func (d *Dispatcher) sendRadioCommRxStartEvents(srcNode *Node, evt *Event) {
 		d.dumpPacket(evt)
 	}
 
-	// dispatch the message to all in range that are receiving.
-	neighborNodes := map[NodeId]*Node{}
-	for _, dstNode := range d.nodesArray {
+	// dispatch the message to all in range that are receiving. Reached nodes are marked with the
+	// current rxDispatchSeq, for the visualization below.
+	d.rxDispatchSeq++
+	for _, dstNode := range d.getRadioCandidates(srcNode) {
 		if d.checkRadioReachable(srcNode, dstNode) {
 			d.sendOneRadioFrame(evt, srcNode, dstNode)
-			neighborNodes[dstNode.Id] = dstNode
+			dstNode.rxDispatchSeq = d.rxDispatchSeq
 		}
 	}
 	d.Counters.DispatchAllInRange++
 
 	// visualize the transmission and (intended) reception of the frame, based on addressing.
+	if !d.isVisualizingFrames() {
+		return // avoid dissecting the frame if nobody is interested.
+	}
 	pktinfo := dissectpkt.Dissect(evt.Data)
 	pktFrame := pktinfo.MacFrame
 	dstAddrMode := pktFrame.FrameControl.DestAddrMode()
@@ -743,7 +1089,7 @@ func (d *Dispatcher) sendRadioCommRxStartEvents(srcNode *Node, evt *Event) {
 	if dstAddrMode == wpan.AddrModeExtended {
 		// unicast ExtAddr frame
 		dstNode := d.extaddrMap[pktFrame.DstAddrExtended]
-		if dstNode != nil && neighborNodes[dstNode.Id] != nil {
+		if dstNode != nil && dstNode.rxDispatchSeq == d.rxDispatchSeq {
 			d.visSendFrame(srcNode.Id, dstNode.Id, pktFrame, evt.RadioCommData)
 		} else {
 			// extAddr didn't exist or was out of range
@@ -755,7 +1101,7 @@ func (d *Dispatcher) sendRadioCommRxStartEvents(srcNode *Node, evt *Event) {
 
 		if len(dstNodes) > 0 {
 			for _, dstNode := range dstNodes {
-				if neighborNodes[dstNode.Id] != nil {
+				if dstNode.rxDispatchSeq == d.rxDispatchSeq {
 					d.visSendFrame(srcNode.Id, dstNode.Id, pktFrame, evt.RadioCommData)
 				}
 			}
@@ -818,7 +1164,7 @@ func (d *Dispatcher) sendRadioCommRxDoneEvents(srcNode *Node, evt *Event) {
 	// if not dispatched yet, dispatch to all nodes able to receive. Works e.g. for Acks that don't have
 	// a destination address.
 	if !dispatchedByDstAddr {
-		for _, dstNode := range d.nodesArray {
+		for _, dstNode := range d.getRadioCandidates(srcNode) {
 			if d.checkRadioReachable(srcNode, dstNode) {
 				d.sendOneRadioFrame(evt, srcNode, dstNode)
 			}
@@ -827,6 +1173,24 @@ func (d *Dispatcher) sendRadioCommRxDoneEvents(srcNode *Node, evt *Event) {
 	}
 }
 
+// getRadioCandidates gets the nodes that may be within radio reach of src, sorted on NodeId. If the radio
+// model doesn't limit the range, this is all nodes; otherwise the (cached) result of a spatial index lookup.
+// Radio state and channel are not considered here: each candidate is still checked by checkRadioReachable().
+func (d *Dispatcher) getRadioCandidates(src *Node) []*Node {
+	maxRange := d.radioModel.GetMaxRadioRange(src.RadioNode)
+	if math.IsInf(maxRange, 1) {
+		return d.nodesArray
+	}
+	return d.neighbors.GetCandidates(src, maxRange)
+}
+
+// getRadioNeighbors is the radiomodel.NeighborFinder of the radio model, using the spatial index.
+func (d *Dispatcher) getRadioNeighbors(src *radiomodel.RadioNode, maxRange float64) []*radiomodel.RadioNode {
+	node := d.nodes[src.Id]
+	logger.AssertNotNil(node)
+	return d.neighbors.GetRadioCandidates(node, maxRange)
+}
+
 func (d *Dispatcher) checkRadioReachable(src *Node, dst *Node) bool {
 	// the RadioModel will check distance and radio-state of receivers.
 	return src != dst && src != nil && dst != nil &&
@@ -910,8 +1274,14 @@ func (d *Dispatcher) syncAliveNodes() {
 	}
 
 	logger.Warnf("syncing %d alive nodes: %v", len(d.aliveNodes), d.aliveNodes)
+	gvt := d.CurTime
 	for nodeid := range d.aliveNodes {
-		d.advanceNodeTime(d.nodes[nodeid], d.CurTime, true)
+		node := d.nodes[nodeid]
+		if node.CurTime > gvt { // in PDES mode, the node's partition may run ahead.
+			d.CurTime = node.CurTime
+		}
+		d.advanceNodeTime(node, d.CurTime, true)
+		d.CurTime = gvt
 	}
 }
 
@@ -923,6 +1293,21 @@ func (d *Dispatcher) syncAllNodes() {
 	d.RecvEvents() // blocks until all nodes asleep again.
 }
 
+// isPcapCaptured checks if a frame sent by the node on the channel passes the capture filter.
+func (d *Dispatcher) isPcapCaptured(node *Node, channel ChannelId) bool {
+	if len(d.pcapNodes) > 0 {
+		if _, ok := d.pcapNodes[node.Id]; !ok {
+			return false
+		}
+	}
+	if len(d.pcapChannels) > 0 {
+		if _, ok := d.pcapChannels[channel]; !ok {
+			return false
+		}
+	}
+	return true
+}
+
 func (d *Dispatcher) pcapFrameWriter() {
 	defer d.waitGroup.Done()
 
@@ -971,6 +1356,8 @@ func (d *Dispatcher) handleStatusPush(node *Node, data string) {
 			logger.PanicIfError(err)
 			d.setNodeRole(node, OtDeviceRole(role))
 			d.Counters.TopologyChanges++
+		} else if sp[0] == "prof" {
+			node.profCounters = parseProfileCounters(sp[1])
 		} else if sp[0] == "rloc16" {
 			rloc16, err := strconv.Atoi(sp[1])
 			logger.PanicIfError(err)
@@ -1066,9 +1453,13 @@ func (d *Dispatcher) AddNode(nodeid NodeId, cfg *NodeConfig) *Node {
 	logger.Debugf("dispatcher AddNode id=%d", nodeid)
 	delete(d.deletedNodes, nodeid)
 
+	if d.trace != nil {
+		d.trace.recordAddNode(d.CurTime, nodeid, cfg)
+	}
 	node := newNode(d, nodeid, cfg)
 	d.nodes[nodeid] = node
 	d.reconstructNodesArray()
+	d.neighbors.Add(node)
 	d.Counters.TopologyChanges++
 	d.alarmMgr.AddNode(nodeid)
 	d.energyAnalyser.AddNode(nodeid, d.CurTime)
@@ -1121,6 +1512,14 @@ func (d *Dispatcher) visSendFrame(srcid NodeId, dstid NodeId, pktframe *wpan.Mac
 	})
 }
 
+// isVisualizingFrames returns true if the Visualizer may be interested in visSendFrame() calls.
+func (d *Dispatcher) isVisualizingFrames() bool {
+	if _, isNop := d.vis.(*visualize.NopVisualizer); isNop {
+		return false
+	}
+	return d.visOptions.AckMessage || d.visOptions.BroadcastMessage || d.visOptions.UnicastMessage
+}
+
 func (d *Dispatcher) visSendInterference(srcid NodeId, dstid NodeId, commData RadioCommEventData) {
 	d.visSend(srcid, dstid, &visualize.MsgVisualizeInfo{
 		Channel:         commData.Channel,
@@ -1210,6 +1609,7 @@ func (d *Dispatcher) WatchNode(nodeid NodeId, watchLevel logger.Level) {
 	node := d.nodes[nodeid]
 	if node != nil {
 		node.logger.SetDisplayLevel(watchLevel)
+		d.updateNodeLogLevel(node)
 	}
 }
 
@@ -1217,6 +1617,7 @@ func (d *Dispatcher) UnwatchNode(nodeid NodeId) {
 	node := d.nodes[nodeid]
 	if node != nil {
 		node.logger.SetDisplayLevel(logger.ErrorLevel)
+		d.updateNodeLogLevel(node)
 	}
 	delete(d.watchingNodes, nodeid)
 }
@@ -1250,8 +1651,12 @@ func (d *Dispatcher) SetNodePos(id NodeId, x, y, z int) {
 	node := d.nodes[id]
 	logger.AssertNotNil(node)
 
+	if d.trace != nil {
+		d.trace.recordNodePos(d.CurTime, id, x, y, z)
+	}
 	node.X, node.Y, node.Z = x, y, z
 	node.RadioNode.SetNodePos(x, y, z)
+	d.neighbors.Move(node)
 	d.vis.SetNodePos(id, x, y, z)
 }
 
@@ -1259,8 +1664,12 @@ func (d *Dispatcher) DeleteNode(id NodeId) {
 	node := d.nodes[id]
 	logger.AssertNotNil(node)
 
+	if d.trace != nil {
+		d.trace.recordDeleteNode(d.CurTime, id)
+	}
 	delete(d.nodes, id)
 	d.reconstructNodesArray()
+	d.neighbors.Remove(node)
 	d.Counters.TopologyChanges++
 	delete(d.aliveNodes, id)
 	delete(d.watchingNodes, id)
@@ -1272,6 +1681,7 @@ func (d *Dispatcher) DeleteNode(id NodeId) {
 		delete(d.extaddrMap, node.ExtAddr)
 	}
 	d.alarmMgr.DeleteNode(id)
+	d.deleteTrelNode(id)
 	d.deletedNodes[id] = struct{}{}
 	d.energyAnalyser.DeleteNode(id)
 	d.vis.DeleteNode(id)
@@ -1286,6 +1696,9 @@ func (d *Dispatcher) SetNodeFailed(id NodeId, fail bool) {
 	node := d.nodes[id]
 	logger.AssertNotNil(node)
 
+	if d.trace != nil {
+		d.trace.recordNodeFailed(d.CurTime, id, fail)
+	}
 	// if radio is set to on/off explicitly, failureCtrl should not be used anymore
 	node.SetFailTime(NonFailTime)
 
@@ -1480,6 +1893,18 @@ func (d *Dispatcher) SetRadioModel(model radiomodel.RadioModel) {
 		}
 	}
 	d.radioModel = model
+	d.radioModel.SetNeighborFinder(d.getRadioNeighbors)
+	d.neighbors.Invalidate()
+	if d.trace != nil {
+		d.trace.recordRadioModel(d.CurTime, model.GetName())
+	}
+}
+
+// OnRadioModelParametersModified must be called when one or more parameters of the current radio model
+// were modified.
+func (d *Dispatcher) OnRadioModelParametersModified() {
+	d.radioModel.OnParametersModified()
+	d.neighbors.Invalidate() // the max radio range may have changed.
 }
 
 func (d *Dispatcher) handleRadioState(node *Node, evt *Event) {
@@ -1500,7 +1925,8 @@ func (d *Dispatcher) handleRadioState(node *Node, evt *Event) {
 
 	// if a next radio-state transition time is indicated, make sure to schedule node wake-up for that time.
 	// This is independent from any alarm-time set by the node which is the OT's stack next-operation time.
-	if evt.Delay > 0 {
+	// A node that reports its wake-up deadlines when going to sleep is woken by the alarmMgr instead.
+	if evt.Delay > 0 && !node.isWakeupsUsed {
 		d.eventQueue.Add(&Event{
 			Type:      EventTypeAlarmFired,
 			NodeId:    node.Id,
@@ -29,6 +29,7 @@ package dispatcher
 import (
 	"github.com/openthread/ot-ns/logger"
 	"github.com/openthread/ot-ns/pcap"
+	. "github.com/openthread/ot-ns/types"
 )
 
 type Config struct {
@@ -37,11 +38,19 @@ type Config struct {
 	DumpPackets       bool
 	PcapEnabled       bool
 	PcapFrameType     pcap.FrameType
+	PcapOptions       pcap.Options
+	PcapNodes         []NodeId    // if not empty, only frames sent by these nodes are captured.
+	PcapChannels      []ChannelId // if not empty, only frames on these channels are captured.
 	DefaultWatchOn    bool
 	DefaultWatchLevel string
 	SimulationId      int
 	OutputDir         string
 	PhyTxStats        bool
+	ShmTransport      bool
+	CompactHeader     bool
+	Pdes              bool
+	TraceFile         string // if not empty, an event trace is recorded in this file, for ReplayTrace.
+	RandomSeed        int64  // root random seed of the simulation, which is recorded in an event trace.
 }
 
 func DefaultConfig() *Config {
@@ -51,10 +60,18 @@ func DefaultConfig() *Config {
 		DumpPackets:       false,
 		PcapEnabled:       true,
 		PcapFrameType:     pcap.FrameTypeWpan,
+		PcapOptions:       pcap.Options{},
+		PcapNodes:         nil,
+		PcapChannels:      nil,
 		DefaultWatchOn:    false,
 		DefaultWatchLevel: logger.OffLevelString,
 		SimulationId:      0,
 		OutputDir:         "tmp",
 		PhyTxStats:        false,
+		ShmTransport:      false,
+		CompactHeader:     false,
+		Pdes:              false,
+		TraceFile:         "",
+		RandomSeed:        0,
 	}
 }
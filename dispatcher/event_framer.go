@@ -0,0 +1,93 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"errors"
+	"io"
+)
+
+const (
+	// framerMinBufSize is the initial and minimum receive buffer size of an eventFramer; it holds at least one
+	// event of max size (OT_EVENT_MAX_SIZE in OT-RFSIM).
+	framerMinBufSize = 4096
+	// framerMaxBufSize is the max receive buffer size of an eventFramer.
+	framerMaxBufSize = 1 << 20
+	// framerShrinkReads is the number of consecutive reads with low buffer use, after which the buffer shrinks.
+	framerShrinkReads = 64
+)
+
+// eventFramer frames the byte stream of a node's event socket into events. A partial event at the end of
+// a read is carried over to the next read. The receive buffer is sized to the actual traffic: it starts small,
+// doubles when a read fills it up, and halves again after framerShrinkReads consecutive reads that used at
+// most a quarter of it. So, the memory use of mostly idle nodes stays small.
+type eventFramer struct {
+	buf      []byte
+	bufLen   int // length of the data in buf: a partial event left from the previous read.
+	lowReads int // number of consecutive reads with low buffer use.
+}
+
+func newEventFramer() *eventFramer {
+	return &eventFramer{
+		buf: make([]byte, framerMinBufSize),
+	}
+}
+
+// read does one read from r, and calls handle with all data available. The handle func returns the number
+// of bytes used, i.e. of the complete events it handled; the remainder is kept for the next read.
+func (f *eventFramer) read(r io.Reader, handle func(data []byte) int) error {
+	n, err := r.Read(f.buf[f.bufLen:])
+	if n <= 0 {
+		return err
+	}
+	n += f.bufLen
+	isFull := n == len(f.buf)
+
+	used := handle(f.buf[:n])
+	f.bufLen = copy(f.buf, f.buf[used:n])
+
+	if isFull && len(f.buf) < framerMaxBufSize {
+		f.resize(len(f.buf) * 2)
+	} else if f.bufLen == len(f.buf) {
+		return errors.New("event larger than max receive buffer size")
+	} else if n <= len(f.buf)/4 && len(f.buf) > framerMinBufSize {
+		f.lowReads++
+		if f.lowReads >= framerShrinkReads && f.bufLen <= len(f.buf)/2 {
+			f.resize(len(f.buf) / 2)
+		}
+	} else {
+		f.lowReads = 0
+	}
+	return err
+}
+
+func (f *eventFramer) resize(size int) {
+	newBuf := make([]byte, size)
+	copy(newBuf, f.buf[:f.bufLen])
+	f.buf = newBuf
+	f.lowReads = 0
+}
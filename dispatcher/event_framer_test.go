@@ -0,0 +1,138 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"bytes"
+	"io"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	. "github.com/openthread/ot-ns/event"
+)
+
+// chunkReader returns its chunks, one per Read call: like a socket that receives data in bursts.
+type chunkReader struct {
+	chunks [][]byte
+}
+
+func (r *chunkReader) Read(p []byte) (int, error) {
+	if len(r.chunks) == 0 {
+		return 0, io.EOF
+	}
+	n := copy(p, r.chunks[0])
+	r.chunks[0] = r.chunks[0][n:]
+	if len(r.chunks[0]) == 0 {
+		r.chunks = r.chunks[1:]
+	}
+	return n, nil
+}
+
+func readAllEvents(t *testing.T, f *eventFramer, r io.Reader) []*Event {
+	var evts []*Event
+	codec := HeaderCodec{}
+	handle := func(data []byte) int {
+		idx := 0
+		for idx < len(data) {
+			evt := &Event{}
+			n := evt.DeserializeWith(data[idx:], &codec)
+			if n == 0 {
+				break
+			}
+			evts = append(evts, evt)
+			idx += n
+		}
+		return idx
+	}
+	for {
+		err := f.read(r, handle)
+		if err == io.EOF {
+			break
+		}
+		assert.Nil(t, err)
+	}
+	return evts
+}
+
+func TestEventFramerPartialEvents(t *testing.T) {
+	var stream []byte
+	for i := 0; i < 100; i++ {
+		evt := &Event{Type: EventTypeUartWrite, MsgId: uint64(i), Data: bytes.Repeat([]byte{byte(i)}, i*10)}
+		stream = append(stream, evt.Serialize()...)
+	}
+
+	// split the stream in chunks, such that events straddle the chunk boundaries.
+	r := &chunkReader{}
+	for i := 0; i < len(stream); i += 77 {
+		end := i + 77
+		if end > len(stream) {
+			end = len(stream)
+		}
+		r.chunks = append(r.chunks, stream[i:end])
+	}
+
+	f := newEventFramer()
+	evts := readAllEvents(t, f, r)
+	assert.Equal(t, 100, len(evts))
+	for i, evt := range evts {
+		assert.Equal(t, uint64(i), evt.MsgId)
+		assert.Equal(t, i*10, len(evt.Data))
+	}
+	assert.Equal(t, 0, f.bufLen)
+	assert.Equal(t, framerMinBufSize, len(f.buf))
+}
+
+func TestEventFramerGrowAndShrink(t *testing.T) {
+	evt := &Event{Type: EventTypeUartWrite, Data: make([]byte, 1000)}
+	evtBytes := evt.Serialize()
+
+	// a burst of data that fills the buffer makes it grow.
+	r := &chunkReader{chunks: [][]byte{bytes.Repeat(evtBytes, 20)}}
+	f := newEventFramer()
+	evts := readAllEvents(t, f, r)
+	assert.Equal(t, 20, len(evts))
+	assert.True(t, len(f.buf) > framerMinBufSize)
+	grownSize := len(f.buf)
+
+	// low traffic makes it shrink back, gradually.
+	r = &chunkReader{}
+	for i := 0; i < framerShrinkReads; i++ {
+		r.chunks = append(r.chunks, evtBytes[:10], evtBytes[10:])
+	}
+	readAllEvents(t, f, r)
+	assert.True(t, len(f.buf) < grownSize)
+
+	for i := 0; i < 10; i++ {
+		r = &chunkReader{}
+		for j := 0; j < framerShrinkReads; j++ {
+			r.chunks = append(r.chunks, evtBytes)
+		}
+		readAllEvents(t, f, r)
+	}
+	assert.Equal(t, framerMinBufSize, len(f.buf))
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"math"
+	"sort"
+
+	"github.com/openthread/ot-ns/radiomodel"
+	. "github.com/openthread/ot-ns/types"
+)
+
+// neighborGridCellSize is the side length (in grid/pixel units) of a cell of the neighbor index. It is
+// chosen close to the default node radio range, so that a typical lookup only visits 3x3 cells.
+const neighborGridCellSize = 256.0
+
+type gridCell struct {
+	X, Y int
+}
+
+// neighborIndex is a uniform-grid spatial index over the node positions, used to find the nodes that are
+// (geometrically) within radio range of a transmitter without scanning all nodes. The Z coordinate is not
+// used for the grid cells, but it is used for the distance check. Per transmitter, the resulting candidate
+// list is cached until the topology changes.
+type neighborIndex struct {
+	cells      map[gridCell]map[NodeId]*Node
+	nodeCells  map[NodeId]gridCell
+	candidates map[NodeId]*candidateList
+	version    uint64 // incremented on each invalidation
+}
+
+// candidateList is the cached result of a lookup for a transmitter, for a given maxRange.
+type candidateList struct {
+	maxRange   float64
+	nodes      []*Node
+	radioNodes []*radiomodel.RadioNode // the RadioNodes of nodes, if requested
+}
+
+func newNeighborIndex() *neighborIndex {
+	return &neighborIndex{
+		cells:      map[gridCell]map[NodeId]*Node{},
+		nodeCells:  map[NodeId]gridCell{},
+		candidates: map[NodeId]*candidateList{},
+	}
+}
+
+func getGridCell(x, y float64) gridCell {
+	return gridCell{
+		X: int(math.Floor(x / neighborGridCellSize)),
+		Y: int(math.Floor(y / neighborGridCellSize)),
+	}
+}
+
+// Add adds a node to the index, at its current RadioNode position.
+func (ni *neighborIndex) Add(node *Node) {
+	c := getGridCell(node.RadioNode.X, node.RadioNode.Y)
+	if ni.cells[c] == nil {
+		ni.cells[c] = map[NodeId]*Node{}
+	}
+	ni.cells[c][node.Id] = node
+	ni.nodeCells[node.Id] = c
+	ni.Invalidate()
+}
+
+// Remove removes a node from the index.
+func (ni *neighborIndex) Remove(node *Node) {
+	c, ok := ni.nodeCells[node.Id]
+	if !ok {
+		return
+	}
+	delete(ni.cells[c], node.Id)
+	if len(ni.cells[c]) == 0 {
+		delete(ni.cells, c)
+	}
+	delete(ni.nodeCells, node.Id)
+	ni.Invalidate()
+}
+
+// Move updates the index after the RadioNode position of the node has changed.
+func (ni *neighborIndex) Move(node *Node) {
+	ni.Remove(node)
+	ni.Add(node)
+}
+
+// Invalidate clears all cached candidate lists, e.g. when node positions or the radio model changed.
+func (ni *neighborIndex) Invalidate() {
+	ni.version++
+	if len(ni.candidates) > 0 {
+		ni.candidates = map[NodeId]*candidateList{}
+	}
+}
+
+// GetCandidates returns all nodes, other than src, that are within maxRange distance of src. The result
+// is sorted on NodeId, i.e. in the same order as the Dispatcher's nodesArray, and is cached until the
+// next call of Invalidate(), or until a lookup for src with another maxRange.
+// The caller must not modify the returned slice.
+func (ni *neighborIndex) GetCandidates(src *Node, maxRange float64) []*Node {
+	return ni.getCandidateList(src, maxRange).nodes
+}
+
+// GetRadioCandidates is like GetCandidates, but returns the RadioNodes of the nodes.
+func (ni *neighborIndex) GetRadioCandidates(src *Node, maxRange float64) []*radiomodel.RadioNode {
+	cl := ni.getCandidateList(src, maxRange)
+	if cl.radioNodes == nil {
+		cl.radioNodes = make([]*radiomodel.RadioNode, len(cl.nodes))
+		for i, node := range cl.nodes {
+			cl.radioNodes[i] = node.RadioNode
+		}
+	}
+	return cl.radioNodes
+}
+
+func (ni *neighborIndex) getCandidateList(src *Node, maxRange float64) *candidateList {
+	if cl, ok := ni.candidates[src.Id]; ok && cl.maxRange == maxRange {
+		return cl
+	}
+
+	x, y := src.RadioNode.X, src.RadioNode.Y
+	cMin := getGridCell(x-maxRange, y-maxRange)
+	cMax := getGridCell(x+maxRange, y+maxRange)
+	list := make([]*Node, 0)
+
+	addCell := func(cell map[NodeId]*Node) {
+		for _, node := range cell {
+			if node != src && src.RadioNode.GetDistanceTo(node.RadioNode) <= maxRange {
+				list = append(list, node)
+			}
+		}
+	}
+
+	if float64(cMax.X-cMin.X+1)*float64(cMax.Y-cMin.Y+1) > float64(len(ni.cells)) {
+		// range covers more cells than are occupied: visit the occupied ones only.
+		for c, cell := range ni.cells {
+			if c.X >= cMin.X && c.X <= cMax.X && c.Y >= cMin.Y && c.Y <= cMax.Y {
+				addCell(cell)
+			}
+		}
+	} else {
+		for cx := cMin.X; cx <= cMax.X; cx++ {
+			for cy := cMin.Y; cy <= cMax.Y; cy++ {
+				addCell(ni.cells[gridCell{cx, cy}])
+			}
+		}
+	}
+	sort.Slice(list, func(i, j int) bool {
+		return list[i].Id < list[j].Id
+	})
+
+	cl := &candidateList{
+		maxRange: maxRange,
+		nodes:    list,
+	}
+	ni.candidates[src.Id] = cl
+	return cl
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/openthread/ot-ns/radiomodel"
+	. "github.com/openthread/ot-ns/types"
+)
+
+func newTestGridNode(id NodeId, x, y int) *Node {
+	return &Node{
+		Id:        id,
+		X:         x,
+		Y:         y,
+		RadioNode: radiomodel.NewRadioNode(id, &radiomodel.RadioNodeConfig{X: x, Y: y, RadioRange: 100}),
+	}
+}
+
+func getCandidateIds(list []*Node) []NodeId {
+	ids := []NodeId{}
+	for _, n := range list {
+		ids = append(ids, n.Id)
+	}
+	return ids
+}
+
+func TestNeighborIndex_GetCandidates(t *testing.T) {
+	ni := newNeighborIndex()
+	n1 := newTestGridNode(1, 0, 0)
+	n2 := newTestGridNode(2, 100, 0)
+	n3 := newTestGridNode(3, 101, 0)
+	n4 := newTestGridNode(4, -60, -80)
+	n5 := newTestGridNode(5, 2000, 2000)
+	for _, n := range []*Node{n5, n3, n1, n4, n2} {
+		ni.Add(n)
+	}
+
+	assert.Equal(t, []NodeId{2, 4}, getCandidateIds(ni.GetCandidates(n1, 100)))
+	assert.Equal(t, []NodeId{1, 3}, getCandidateIds(ni.GetCandidates(n2, 100)))
+	assert.Equal(t, []NodeId{}, getCandidateIds(ni.GetCandidates(n5, 100)))
+
+	// a very large range must find all other nodes.
+	ni.Invalidate()
+	assert.Equal(t, []NodeId{1, 2, 3, 4}, getCandidateIds(ni.GetCandidates(n5, 1e9)))
+}
+
+func TestNeighborIndex_Invalidate(t *testing.T) {
+	ni := newNeighborIndex()
+	n1 := newTestGridNode(1, 0, 0)
+	n2 := newTestGridNode(2, 50, 0)
+	ni.Add(n1)
+	ni.Add(n2)
+	assert.Equal(t, []NodeId{2}, getCandidateIds(ni.GetCandidates(n1, 100)))
+
+	// move n2 out of range, into another grid cell.
+	n2.RadioNode.SetNodePos(500, 500, 0)
+	ni.Move(n2)
+	assert.Equal(t, []NodeId{}, getCandidateIds(ni.GetCandidates(n1, 100)))
+
+	// move back and add a new node.
+	n2.RadioNode.SetNodePos(0, 99, 0)
+	ni.Move(n2)
+	n3 := newTestGridNode(3, -99, 0)
+	ni.Add(n3)
+	assert.Equal(t, []NodeId{2, 3}, getCandidateIds(ni.GetCandidates(n1, 100)))
+
+	ni.Remove(n2)
+	assert.Equal(t, []NodeId{3}, getCandidateIds(ni.GetCandidates(n1, 100)))
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"math"
+
+	. "github.com/openthread/ot-ns/types"
+)
+
+const (
+	// pdesShrPhrDurationUs is the duration of the SHR and PHY header of a frame, which must be received before
+	// any of the frame's contents; see OT_RADIO_SHR_PHR_DURATION_US in ot-rfsim.
+	pdesShrPhrDurationUs = 192
+
+	// pdesSpeedOfLight in m/us.
+	pdesSpeedOfLight = 299.792458
+)
+
+// partitionSet divides the nodes into partitions that are radio-isolated from each other: no node of one
+// partition is within the max radio range of a node in another partition. Partitions are the connected
+// components of the 'within radio range' graph, each identified by the lowest NodeId in it. The set is
+// rebuilt when the neighborIndex was invalidated, i.e. when the topology or radio model changed.
+type partitionSet struct {
+	ids       map[NodeId]NodeId
+	version   uint64
+	lookahead uint64
+	isValid   bool
+}
+
+func newPartitionSet() *partitionSet {
+	return &partitionSet{
+		ids: map[NodeId]NodeId{},
+	}
+}
+
+// get returns the partition of the node.
+func (ps *partitionSet) get(d *Dispatcher, node *Node) NodeId {
+	if !ps.isValid || ps.version != d.neighbors.version {
+		ps.build(d)
+	}
+	return ps.ids[node.Id]
+}
+
+// getLookahead returns the lookahead of the partitions: the minimum time it takes for a frame transmission
+// to reach another node; which is the SHR/PHR duration plus the propagation delay over the max radio range.
+func (ps *partitionSet) getLookahead(d *Dispatcher) uint64 {
+	if !ps.isValid || ps.version != d.neighbors.version {
+		ps.build(d)
+	}
+	return ps.lookahead
+}
+
+func (ps *partitionSet) build(d *Dispatcher) {
+	parents := make(map[NodeId]NodeId, len(d.nodesArray))
+	var find func(id NodeId) NodeId
+	find = func(id NodeId) NodeId {
+		p := parents[id]
+		if p == id {
+			return id
+		}
+		root := find(p)
+		parents[id] = root
+		return root
+	}
+	union := func(a, b NodeId) {
+		ra, rb := find(a), find(b)
+		if ra < rb {
+			parents[rb] = ra
+		} else if rb < ra {
+			parents[ra] = rb
+		}
+	}
+
+	maxRange := 0.0
+	for _, node := range d.nodesArray {
+		parents[node.Id] = node.Id
+		if r := d.radioModel.GetMaxRadioRange(node.RadioNode); r > maxRange {
+			maxRange = r
+		}
+	}
+	for _, node := range d.nodesArray {
+		for _, nb := range d.getRadioCandidates(node) {
+			union(node.Id, nb.Id)
+		}
+	}
+
+	ps.ids = make(map[NodeId]NodeId, len(parents))
+	for id := range parents {
+		ps.ids[id] = find(id)
+	}
+	ps.lookahead = pdesShrPhrDurationUs
+	if !math.IsInf(maxRange, 1) {
+		ps.lookahead += uint64(math.Ceil(maxRange * d.radioModel.GetParameters().MeterPerUnit / pdesSpeedOfLight))
+	}
+	ps.version = d.neighbors.version
+	ps.isValid = true
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	. "github.com/openthread/ot-ns/event"
+	"github.com/openthread/ot-ns/logger"
+	"github.com/openthread/ot-ns/prng"
+	"github.com/openthread/ot-ns/radiomodel"
+	. "github.com/openthread/ot-ns/types"
+	"github.com/openthread/ot-ns/visualize"
+)
+
+func newTestPartitionDispatcher(modelName string, nodes ...*Node) *Dispatcher {
+	prng.Init(0)
+	d := &Dispatcher{
+		nodesArray: nodes,
+		neighbors:  newNeighborIndex(),
+		partitions: newPartitionSet(),
+		radioModel: radiomodel.NewRadioModel(modelName),
+	}
+	for _, node := range nodes {
+		d.neighbors.Add(node)
+	}
+	return d
+}
+
+func getPartitionIds(d *Dispatcher) []NodeId {
+	ids := []NodeId{}
+	for _, node := range d.nodesArray {
+		ids = append(ids, d.partitions.get(d, node))
+	}
+	return ids
+}
+
+func TestPartitionSet(t *testing.T) {
+	n5 := newTestGridNode(5, 3000, 0)
+	d := newTestPartitionDispatcher("Ideal", newTestGridNode(1, 0, 0), newTestGridNode(2, 100, 0),
+		newTestGridNode(3, 1000, 0), newTestGridNode(4, 1050, 0), n5)
+
+	assert.Equal(t, []NodeId{1, 1, 3, 3, 5}, getPartitionIds(d))
+	assert.Equal(t, uint64(pdesShrPhrDurationUs+1), d.partitions.getLookahead(d))
+
+	// moving a node rebuilds the partitions.
+	n5.RadioNode.SetNodePos(1100, 0, 0)
+	d.neighbors.Move(n5)
+	assert.Equal(t, []NodeId{1, 1, 3, 3, 3}, getPartitionIds(d))
+
+	// a model without range limit has a single partition.
+	d = newTestPartitionDispatcher("MutualInterference", newTestGridNode(1, 0, 0), newTestGridNode(2, 5000, 0))
+	assert.Equal(t, []NodeId{1, 1}, getPartitionIds(d))
+	assert.Equal(t, uint64(pdesShrPhrDurationUs), d.partitions.getLookahead(d))
+}
+
+// newTestEventsDispatcher creates a dispatcher with the given nodes that can process events, while the nodes
+// are not connected: events sent to the nodes are dropped.
+func newTestEventsDispatcher(pdes bool, nodes ...*Node) *Dispatcher {
+	d := newTestPartitionDispatcher("Ideal", nodes...)
+	d.cfg.Pdes = pdes
+	d.cbHandler = &mockDispatcherCallback{}
+	d.vis = visualize.NewNopVisualizer()
+	d.alarmMgr = newAlarmMgr()
+	d.eventQueue = newSendQueue()
+	d.nodes = map[NodeId]*Node{}
+	d.aliveNodes = map[NodeId]struct{}{}
+	d.pauseTime = Ever
+	for _, node := range nodes {
+		node.D = d
+		node.logger = logger.GetNodeLogger("tmp", 1, &NodeConfig{ID: node.Id, NodeLogFile: false})
+		node.failureCtrl = newFailureCtrl(node, NonFailTime)
+		d.nodes[node.Id] = node
+		d.alarmMgr.AddNode(node.Id)
+		d.radioModel.AddNode(node.RadioNode)
+	}
+	return d
+}
+
+// runTestTxChannelStats lets the nodes transmit a frame at the given [start, end) times, and returns the
+// channel stats and whether a partition ran ahead of the simulation time.
+func runTestTxChannelStats(pdes bool, txTimes map[NodeId][2]uint64) (radiomodel.ChannelStats, bool) {
+	d := newTestEventsDispatcher(pdes, newTestGridNode(1, 0, 0), newTestGridNode(2, 50, 0),
+		newTestGridNode(3, 1000, 0), newTestGridNode(4, 1050, 0))
+	for id, tx := range txTimes {
+		d.eventQueue.Add(&Event{
+			Type:      EventTypeRadioCommStart,
+			NodeId:    id,
+			Timestamp: tx[0],
+			Data:      []byte{11},
+			RadioCommData: RadioCommEventData{
+				Channel:  11,
+				Error:    OT_ERROR_ABORT, // no frame reception by other nodes.
+				Duration: tx[1] - tx[0],
+			},
+		})
+	}
+
+	isAhead := false
+	for d.eventQueue.Len() > 0 {
+		d.processNextEvent(MaxSimulateSpeed)
+		isAhead = isAhead || d.pdesAheadTime > d.CurTime
+	}
+	return *d.radioModel.GetChannelStats(11), isAhead
+}
+
+func TestPartitionChannelStats(t *testing.T) {
+	// nodes 1, 2 and nodes 3, 4 form two partitions. At time 990, the first partition processes the end of
+	// the frame of node 2, and the second partition runs ahead to the end of the frame of node 3 at 1100. The
+	// start of the frame of node 1 at 1000 is only processed after that.
+	txTimes := map[NodeId][2]uint64{
+		1: {1000, 1500},
+		2: {950, 990},
+		3: {900, 1100},
+	}
+	seqStats, isAhead := runTestTxChannelStats(false, txTimes)
+	assert.False(t, isAhead)
+	assert.Equal(t, uint64(600), seqStats.TxTimeUs)
+	assert.Equal(t, uint64(3), seqStats.NumFrames)
+
+	pdesStats, isAhead := runTestTxChannelStats(true, txTimes)
+	assert.True(t, isAhead)
+	assert.Equal(t, seqStats.TxTimeUs, pdesStats.TxTimeUs)
+	assert.Equal(t, seqStats.NumFrames, pdesStats.NumFrames)
+}
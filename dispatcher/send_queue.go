@@ -27,82 +27,359 @@
 package dispatcher
 
 import (
-	"container/heap"
+	"sort"
 
 	. "github.com/openthread/ot-ns/event"
+	"github.com/openthread/ot-ns/logger"
 	. "github.com/openthread/ot-ns/types"
 )
 
-type sendQueue struct {
-	q []*Event
+const (
+	sendQueueMinBuckets   = 16
+	sendQueueInitialWidth = 1000 // us
+	sendQueueWidthSamples = 32
+	sendQueueOverflow     = -2 // peek result indicating the next entry is the overflow top.
+)
+
+// sendQueueEntry is a queued Event, with the sort key stored by value next to it.
+type sendQueueEntry struct {
+	timestamp uint64
+	nodeId    NodeId
+	seq       uint64 // insertion order, so that events with equal timestamp and NodeId are FIFO.
+	gen       uint32 // node generation at time of insertion, see DisableEventsForNode().
+	evt       *Event
 }
 
-func (sq *sendQueue) Len() int {
-	return len(sq.q)
+func (e *sendQueueEntry) before(other *sendQueueEntry) bool {
+	if e.timestamp != other.timestamp {
+		return e.timestamp < other.timestamp
+	}
+	if e.nodeId != other.nodeId {
+		return e.nodeId < other.nodeId
+	}
+	return e.seq < other.seq
+}
+
+// sendQueueBucket holds sorted entries; entries before head were already popped.
+type sendQueueBucket struct {
+	entries []sendQueueEntry
+	head    int
+}
+
+func (b *sendQueueBucket) len() int {
+	return len(b.entries) - b.head
+}
+
+func (b *sendQueueBucket) first() *sendQueueEntry {
+	return &b.entries[b.head]
 }
 
-func (sq *sendQueue) Less(i, j int) bool {
-	ti := sq.q[i].Timestamp
-	tj := sq.q[j].Timestamp
-	if ti == tj {
-		return sq.q[i].NodeId < sq.q[j].NodeId
+func (b *sendQueueBucket) insert(entry sendQueueEntry) {
+	n := len(b.entries)
+	if n == b.head || b.entries[n-1].before(&entry) {
+		b.entries = append(b.entries, entry) // most common case: a new event after all others.
+		return
 	}
-	return ti < tj
+	i := b.head + sort.Search(n-b.head, func(i int) bool {
+		return entry.before(&b.entries[b.head+i])
+	})
+	b.entries = append(b.entries, sendQueueEntry{})
+	copy(b.entries[i+1:], b.entries[i:])
+	b.entries[i] = entry
 }
 
-func (sq *sendQueue) Swap(i, j int) {
-	sq.q[i], sq.q[j] = sq.q[j], sq.q[i]
+func (b *sendQueueBucket) pop() sendQueueEntry {
+	entry := b.entries[b.head]
+	b.entries[b.head] = sendQueueEntry{} // don't keep a reference to the Event.
+	b.head++
+	if b.head == len(b.entries) {
+		b.entries = b.entries[:0]
+		b.head = 0
+	}
+	return entry
 }
 
-func (sq *sendQueue) Push(x interface{}) {
-	sq.q = append(sq.q, x.(*Event))
+// sendQueueHeap is a binary min-heap of entries, stored by value.
+type sendQueueHeap []sendQueueEntry
+
+func (h *sendQueueHeap) push(entry sendQueueEntry) {
+	*h = append(*h, entry)
+	q := *h
+	for i := len(q) - 1; i > 0; {
+		parent := (i - 1) / 2
+		if !q[i].before(&q[parent]) {
+			break
+		}
+		q[i], q[parent] = q[parent], q[i]
+		i = parent
+	}
 }
 
-func (sq *sendQueue) Pop() (elem interface{}) {
-	eqlen := len(sq.q)
-	elem = sq.q[eqlen-1]
-	sq.q = sq.q[:eqlen-1]
-	return
+func (h *sendQueueHeap) pop() sendQueueEntry {
+	q := *h
+	top := q[0]
+	n := len(q) - 1
+	q[0] = q[n]
+	q[n] = sendQueueEntry{}
+	q = q[:n]
+	for i := 0; ; {
+		smallest := i
+		if l := 2*i + 1; l < n && q[l].before(&q[smallest]) {
+			smallest = l
+		}
+		if r := 2*i + 2; r < n && q[r].before(&q[smallest]) {
+			smallest = r
+		}
+		if smallest == i {
+			break
+		}
+		q[i], q[smallest] = q[smallest], q[i]
+		i = smallest
+	}
+	*h = q
+	return top
+}
+
+// sendQueue is a calendar queue of Events, ordered on (Timestamp, NodeId, insertion order).
+//
+// The buckets cover a sliding time window that starts at the current bucket: each bucket holds the sorted
+// entries of a time interval of width us. Entries beyond the window are kept in an overflow heap, and
+// move into the buckets as the window advances. The number of buckets and the width are adapted to the
+// number of queued events, which keeps Add() and PopNext() O(1) on average. Since new events are mostly
+// scheduled after the already queued ones, they are typically appended to the end of a bucket.
+type sendQueue struct {
+	buckets   []sendQueueBucket
+	overflow  sendQueueHeap
+	width     uint64
+	size      int    // total number of entries
+	inBuckets int    // number of entries in buckets
+	cur       int    // bucket at the start of the window
+	curStart  uint64 // start time of the window
+	next      int    // cached bucket of the next entry, or -1 if unknown, or sendQueueOverflow.
+	seq       uint64
+	nodeGens  map[NodeId]uint32
+}
+
+func newSendQueue() *sendQueue {
+	sq := &sendQueue{
+		buckets:  make([]sendQueueBucket, sendQueueMinBuckets),
+		width:    sendQueueInitialWidth,
+		next:     -1,
+		nodeGens: map[NodeId]uint32{},
+	}
+	return sq
+}
+
+func (sq *sendQueue) Len() int {
+	return sq.size
 }
 
 func (sq *sendQueue) NextTimestamp() uint64 {
-	if len(sq.q) > 0 {
-		return sq.q[0].Timestamp
-	} else {
-		return Ever
+	if entry := sq.peek(); entry != nil {
+		return entry.timestamp
 	}
+	return Ever
 }
 
 func (sq *sendQueue) NextEvent() *Event {
-	if len(sq.q) > 0 {
-		return sq.q[0]
-	} else {
-		return nil
+	if entry := sq.peek(); entry != nil {
+		return sq.applyGen(entry)
 	}
+	return nil
 }
 
 func (sq *sendQueue) Add(evt *Event) {
-	heap.Push(sq, evt)
+	sq.addEntry(sendQueueEntry{
+		timestamp: evt.Timestamp,
+		nodeId:    evt.NodeId,
+		seq:       sq.seq,
+		gen:       sq.nodeGens[evt.NodeId],
+		evt:       evt,
+	})
+	sq.seq++
 }
 
-// DisableEventsForNode diables all events to/from a particular nodeid from the queue.
-// This is done by setting a NodeId of '0' for these events.
-func (sq *sendQueue) DisableEventsForNode(nodeid NodeId) {
-	for _, evt := range sq.q {
-		if evt.NodeId == nodeid {
-			evt.NodeId = 0 // make the event invalid.
+// addEntry adds a new entry, or re-adds an entry that was taken out with popEntry().
+func (sq *sendQueue) addEntry(entry sendQueueEntry) {
+	if sq.size == 0 {
+		sq.setPosition(entry.timestamp)
+	}
+	sq.size++
+
+	if entry.timestamp < sq.curStart && !sq.moveWindowBack(entry.timestamp) {
+		// rare case of an event far before the window: rebuild the queue.
+		sq.overflow.push(entry)
+		sq.resize(len(sq.buckets))
+		return
+	}
+	if entry.timestamp >= sq.windowEnd() {
+		sq.overflow.push(entry)
+	} else {
+		b := sq.bucketIndex(entry.timestamp)
+		sq.buckets[b].insert(entry)
+		sq.inBuckets++
+		if sq.next == sendQueueOverflow || (sq.next >= 0 && entry.before(sq.buckets[sq.next].first())) {
+			sq.next = b
 		}
 	}
+
+	if sq.size > 2*len(sq.buckets) {
+		sq.resize(2 * len(sq.buckets))
+	}
+}
+
+// DisableEventsForNode disables all queued events to/from a particular nodeid. This is done by
+// increasing the node's generation; an event from an older generation gets NodeId '0' when it's retrieved.
+func (sq *sendQueue) DisableEventsForNode(nodeid NodeId) {
+	sq.nodeGens[nodeid]++
 }
 
 func (sq *sendQueue) PopNext() *Event {
-	return heap.Pop(sq).(*Event)
+	if sq.peek() == nil {
+		return nil
+	}
+	entry := sq.popEntry()
+	return sq.applyGen(&entry)
 }
 
-func newSendQueue() *sendQueue {
-	sq := &sendQueue{
-		q: []*Event{},
+// popEntry removes the next entry from the non-empty queue, and returns it.
+func (sq *sendQueue) popEntry() sendQueueEntry {
+	logger.AssertNotNil(sq.peek())
+	var entry sendQueueEntry
+	if sq.next == sendQueueOverflow {
+		entry = sq.overflow.pop()
+		sq.setPosition(entry.timestamp)
+	} else {
+		entry = sq.buckets[sq.next].pop()
+		sq.inBuckets--
+		// advance the window to the popped entry's bucket; normally, no events are added before it.
+		for sq.cur != sq.next {
+			sq.cur = (sq.cur + 1) & (len(sq.buckets) - 1)
+			sq.curStart += sq.width
+		}
+	}
+	sq.next = -1
+	sq.size--
+	sq.fillFromOverflow()
+
+	if sq.size < len(sq.buckets)/2 && len(sq.buckets) > sendQueueMinBuckets {
+		sq.resize(len(sq.buckets) / 2)
+	}
+	return entry
+}
+
+func (sq *sendQueue) applyGen(entry *sendQueueEntry) *Event {
+	if entry.gen != sq.nodeGens[entry.nodeId] {
+		entry.evt.NodeId = 0 // make the event invalid.
+	}
+	return entry.evt
+}
+
+func (sq *sendQueue) bucketIndex(ts uint64) int {
+	return int((ts / sq.width) & uint64(len(sq.buckets)-1))
+}
+
+func (sq *sendQueue) windowEnd() uint64 {
+	return sq.curStart + uint64(len(sq.buckets))*sq.width
+}
+
+func (sq *sendQueue) setPosition(ts uint64) {
+	sq.cur = sq.bucketIndex(ts)
+	sq.curStart = ts - ts%sq.width
+}
+
+// moveWindowBack moves the start of the window back to include ts, if that's within a few buckets. The
+// entries of the buckets at the end of the window then move to the overflow. Returns false if not moved.
+func (sq *sendQueue) moveWindowBack(ts uint64) bool {
+	steps := (sq.curStart - ts + sq.width - 1) / sq.width
+	if steps > uint64(len(sq.buckets)/4) {
+		return false
+	}
+	mask := len(sq.buckets) - 1
+	for ; steps > 0; steps-- {
+		sq.cur = (sq.cur + mask) & mask
+		sq.curStart -= sq.width
+		bucket := &sq.buckets[sq.cur]
+		for bucket.len() > 0 {
+			sq.overflow.push(bucket.pop())
+			sq.inBuckets--
+		}
+	}
+	sq.next = -1
+	return true
+}
+
+// fillFromOverflow moves overflow entries that are now within the window into the buckets.
+func (sq *sendQueue) fillFromOverflow() {
+	windowEnd := sq.windowEnd()
+	for len(sq.overflow) > 0 && sq.overflow[0].timestamp < windowEnd {
+		entry := sq.overflow.pop()
+		sq.buckets[sq.bucketIndex(entry.timestamp)].insert(entry)
+		sq.inBuckets++
+	}
+}
+
+// peek finds the next entry, caching its location in sq.next. Returns nil if the queue is empty.
+func (sq *sendQueue) peek() *sendQueueEntry {
+	if sq.next == -1 {
+		if sq.size == 0 {
+			return nil
+		}
+		if sq.inBuckets == 0 {
+			sq.next = sendQueueOverflow
+		} else {
+			// the first non-empty bucket in the window holds the next entry.
+			mask := len(sq.buckets) - 1
+			b := sq.cur
+			for sq.buckets[b].len() == 0 {
+				b = (b + 1) & mask
+			}
+			sq.next = b
+		}
+	}
+	if sq.next == sendQueueOverflow {
+		return &sq.overflow[0]
+	}
+	return sq.buckets[sq.next].first()
+}
+
+// resize redistributes all entries over numBuckets buckets, with a bucket width based on the average
+// separation in time of the first events.
+func (sq *sendQueue) resize(numBuckets int) {
+	entries := make([]sendQueueEntry, 0, sq.size)
+	for _, bucket := range sq.buckets {
+		entries = append(entries, bucket.entries[bucket.head:]...)
+	}
+	entries = append(entries, sq.overflow...)
+	sort.Slice(entries, func(i, j int) bool {
+		return entries[i].before(&entries[j])
+	})
+
+	n := len(entries)
+	if n > sendQueueWidthSamples {
+		n = sendQueueWidthSamples
+	}
+	if n >= 2 {
+		if width := 3 * (entries[n-1].timestamp - entries[0].timestamp) / uint64(n-1); width > 0 {
+			sq.width = width
+		}
+	}
+
+	sq.buckets = make([]sendQueueBucket, numBuckets)
+	sq.overflow = nil
+	sq.inBuckets = 0
+	sq.next = -1
+	if len(entries) == 0 {
+		return
+	}
+	sq.setPosition(entries[0].timestamp)
+	windowEnd := sq.windowEnd()
+	for i, entry := range entries {
+		if entry.timestamp >= windowEnd {
+			sq.overflow = entries[i:] // a sorted slice is a valid heap.
+			break
+		}
+		sq.buckets[sq.bucketIndex(entry.timestamp)].insert(entry)
+		sq.inBuckets++
 	}
-	heap.Init(sq)
-	return sq
 }
@@ -27,6 +27,10 @@
 package dispatcher
 
 import (
+	"container/heap"
+	"math/rand"
+	"sort"
+	"strconv"
 	"testing"
 
 	. "github.com/openthread/ot-ns/event"
@@ -92,3 +96,237 @@ func TestSendQueue_PopNext(t *testing.T) {
 	ev = q.PopNext()
 	assert.True(t, ev.NodeId == 3 && ev.Timestamp == 3)
 }
+
+func TestSendQueue_PopNextEqualTimestamp(t *testing.T) {
+	q := newSendQueue()
+	q.Add(&Event{Timestamp: 5, NodeId: 2, MsgId: 1})
+	q.Add(&Event{Timestamp: 5, NodeId: 1, MsgId: 2})
+	q.Add(&Event{Timestamp: 5, NodeId: 2, MsgId: 3})
+	q.Add(&Event{Timestamp: 5, NodeId: 1, MsgId: 4})
+
+	// ordered on NodeId, then FIFO.
+	for _, msgId := range []uint64{2, 4, 1, 3} {
+		assert.Equal(t, msgId, q.PopNext().MsgId)
+	}
+	assert.Equal(t, 0, q.Len())
+	assert.Nil(t, q.PopNext())
+}
+
+func TestSendQueue_DisableEventsForNode(t *testing.T) {
+	q := newSendQueue()
+	q.Add(&Event{Timestamp: 1, NodeId: 1})
+	q.Add(&Event{Timestamp: 2, NodeId: 2})
+	q.DisableEventsForNode(2)
+	q.Add(&Event{Timestamp: 3, NodeId: 2}) // added after disabling: stays valid.
+
+	assert.Equal(t, NodeId(1), q.PopNext().NodeId)
+	assert.Equal(t, NodeId(0), q.NextEvent().NodeId)
+	ev := q.PopNext()
+	assert.True(t, ev.NodeId == 0 && ev.Timestamp == 2)
+	ev = q.PopNext()
+	assert.True(t, ev.NodeId == 2 && ev.Timestamp == 3)
+}
+
+func TestSendQueue_RandomOrder(t *testing.T) {
+	rnd := rand.New(rand.NewSource(1))
+	q := newSendQueue()
+	var ref []*Event
+	now := uint64(0)
+
+	// interleave adds and pops, with a varying queue size so that the queue is resized many times.
+	for round := 0; round < 20000; round++ {
+		numAdd := rnd.Intn(4)
+		if round > 10000 {
+			numAdd = rnd.Intn(2)
+		}
+		for i := 0; i < numAdd; i++ {
+			delay := uint64(rnd.ExpFloat64() * 2000)
+			if rnd.Intn(100) == 0 {
+				delay += 10000000 // few far-future events
+			}
+			ev := &Event{Timestamp: now + delay, NodeId: rnd.Intn(50) + 1, MsgId: uint64(round*10 + i)}
+			q.Add(ev)
+			ref = append(ref, ev)
+		}
+		if len(ref) > 0 {
+			sort.SliceStable(ref, func(i, j int) bool {
+				if ref[i].Timestamp != ref[j].Timestamp {
+					return ref[i].Timestamp < ref[j].Timestamp
+				}
+				return ref[i].NodeId < ref[j].NodeId
+			})
+			assert.Equal(t, ref[0].Timestamp, q.NextTimestamp())
+			ev := q.PopNext()
+			assert.Equal(t, ref[0], ev)
+			now = ev.Timestamp
+			ref = ref[1:]
+		}
+		assert.Equal(t, len(ref), q.Len())
+	}
+}
+
+func TestSendQueue_ReAddEntries(t *testing.T) {
+	rnd := rand.New(rand.NewSource(2))
+	q := newSendQueue()
+	numEvents := 0
+	for i := 0; i < 1000; i++ {
+		q.Add(&Event{Timestamp: uint64(rnd.Intn(100000)), NodeId: rnd.Intn(20) + 1})
+		numEvents++
+	}
+
+	// take out entries, add new events before these, and re-add them: as the dispatcher does in PDES mode.
+	for round := 0; round < 2000; round++ {
+		var taken []sendQueueEntry
+		for i := rnd.Intn(5); i > 0 && q.Len() > 0; i-- {
+			taken = append(taken, q.popEntry())
+		}
+		if len(taken) == 0 {
+			continue
+		}
+		now := taken[0].timestamp
+		ev := &Event{Timestamp: now + uint64(rnd.Intn(3000)), NodeId: taken[0].nodeId}
+		q.Add(ev)
+		numEvents++
+		for _, entry := range taken {
+			q.addEntry(entry)
+		}
+		q.PopNext()
+		numEvents--
+	}
+	assert.Equal(t, numEvents, q.Len())
+
+	// all events are retrieved in (Timestamp, NodeId) order.
+	prev := q.PopNext()
+	for q.Len() > 0 {
+		ev := q.PopNext()
+		assert.True(t, prev.Timestamp < ev.Timestamp || (prev.Timestamp == ev.Timestamp && prev.NodeId <= ev.NodeId))
+		prev = ev
+	}
+}
+
+// heapSendQueue is the former container/heap based event queue, kept as a reference for benchmarks.
+type heapSendQueue struct {
+	q []*Event
+}
+
+func (sq *heapSendQueue) Len() int { return len(sq.q) }
+
+func (sq *heapSendQueue) Less(i, j int) bool {
+	ti := sq.q[i].Timestamp
+	tj := sq.q[j].Timestamp
+	if ti == tj {
+		return sq.q[i].NodeId < sq.q[j].NodeId
+	}
+	return ti < tj
+}
+
+func (sq *heapSendQueue) Swap(i, j int) { sq.q[i], sq.q[j] = sq.q[j], sq.q[i] }
+
+func (sq *heapSendQueue) Push(x interface{}) { sq.q = append(sq.q, x.(*Event)) }
+
+func (sq *heapSendQueue) Pop() (elem interface{}) {
+	eqlen := len(sq.q)
+	elem = sq.q[eqlen-1]
+	sq.q = sq.q[:eqlen-1]
+	return
+}
+
+func (sq *heapSendQueue) Add(evt *Event) { heap.Push(sq, evt) }
+
+func (sq *heapSendQueue) PopNext() *Event { return heap.Pop(sq).(*Event) }
+
+func (sq *heapSendQueue) DisableEventsForNode(nodeid NodeId) {
+	for _, evt := range sq.q {
+		if evt.NodeId == nodeid {
+			evt.NodeId = 0
+		}
+	}
+}
+
+type benchEventQueue interface {
+	Add(evt *Event)
+	PopNext() *Event
+	DisableEventsForNode(nodeid NodeId)
+}
+
+// queueTraceStep is one step of a recorded event trace: pop the next event, and schedule the events that
+// its processing caused, with given delays (us).
+type queueTraceStep struct {
+	delays []uint64
+}
+
+// makeQueueTrace creates a synthetic trace resembling the dispatcher's event pattern in a busy network:
+// each processed event causes on average one new event, such as a radio frame Tx done after a frame
+// duration, a Rx done per neighbor, or a state change after a turnaround time.
+func makeQueueTrace(numSteps int) []queueTraceStep {
+	rnd := rand.New(rand.NewSource(42))
+	trace := make([]queueTraceStep, numSteps)
+	for i := range trace {
+		switch r := rnd.Intn(10); {
+		case r < 4: // radio state change or channel sample
+			trace[i].delays = []uint64{uint64(rnd.Intn(200))}
+		case r < 7: // frame Tx: duration up to 4 ms
+			trace[i].delays = []uint64{uint64(160 + rnd.Intn(4000))}
+		case r < 8: // frame Rx done at several neighbors, at the same time
+			d := uint64(160 + rnd.Intn(4000))
+			trace[i].delays = []uint64{d, d, d}
+		case r < 9: // node done with processing
+			trace[i].delays = nil
+		default: // failure control re-evaluation, far in the future
+			trace[i].delays = []uint64{uint64(1000000 + rnd.Intn(10000000))}
+		}
+	}
+	return trace
+}
+
+func runQueueTrace(b *testing.B, q benchEventQueue, numQueued int, trace []queueTraceStep) {
+	rnd := rand.New(rand.NewSource(1))
+	for i := 0; i < numQueued; i++ {
+		q.Add(&Event{Timestamp: uint64(rnd.Intn(10000)), NodeId: i%3000 + 1})
+	}
+	b.ResetTimer()
+	for n := 0; n < b.N; n++ {
+		step := &trace[n%len(trace)]
+		evt := q.PopNext()
+		now := evt.Timestamp
+		nodeid := evt.NodeId
+		if len(step.delays) == 0 { // keep the queue size stable
+			evt.Timestamp = now + 1000
+			q.Add(evt)
+		}
+		for j, d := range step.delays {
+			if j > 0 {
+				evt = &Event{}
+			}
+			evt.Timestamp = now + d
+			evt.NodeId = (nodeid+j)%3000 + 1
+			q.Add(evt)
+		}
+	}
+}
+
+func BenchmarkSendQueue_Trace(b *testing.B) {
+	trace := makeQueueTrace(100000)
+	for _, numQueued := range []int{100, 10000, 1000000} {
+		b.Run("calendar/"+strconv.Itoa(numQueued), func(b *testing.B) {
+			runQueueTrace(b, newSendQueue(), numQueued, trace)
+		})
+		b.Run("heap/"+strconv.Itoa(numQueued), func(b *testing.B) {
+			runQueueTrace(b, &heapSendQueue{}, numQueued, trace)
+		})
+	}
+}
+
+func BenchmarkSendQueue_DisableEventsForNode(b *testing.B) {
+	names := []string{"calendar", "heap"}
+	for i, q := range []benchEventQueue{newSendQueue(), &heapSendQueue{}} {
+		for i := 0; i < 1000000; i++ {
+			q.Add(&Event{Timestamp: uint64(i), NodeId: i%3000 + 1})
+		}
+		b.Run(names[i], func(b *testing.B) {
+			for n := 0; n < b.N; n++ {
+				q.DisableEventsForNode(n%3000 + 1)
+			}
+		})
+	}
+}
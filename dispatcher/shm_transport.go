@@ -0,0 +1,220 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"encoding/binary"
+	"fmt"
+	"net"
+	"os"
+	"path/filepath"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"syscall"
+	"unsafe"
+
+	. "github.com/openthread/ot-ns/event"
+)
+
+// Layout of the shared-memory region, from OT-RFSIM platform, event-sim.h struct ShmRegion.
+const (
+	shmMagic          = 0x4f544e53
+	shmVersion        = 1
+	shmRingSize       = 64 * 1024
+	shmRegionHdrLen   = 64
+	shmRingHdrLen     = 128
+	shmRingHeadOffset = 0
+	shmRingTailOffset = 64
+	shmRegionLen      = shmRegionHdrLen + 2*(shmRingHdrLen+shmRingSize)
+	shmDir            = "/dev/shm"
+
+	// max length of data announced by one shm-data event, limited by node's receive buffer.
+	shmMaxDataLen = 8 * (eventMsgHeaderLen + 2048)
+	// length of event header, from OT-RFSIM platform, event-sim.h struct EventHeader.
+	eventMsgHeaderLen = 19
+)
+
+// shmRing is a single-producer, single-consumer ring in shared memory. Head and tail are
+// free-running byte counters, written only by the producer and the consumer respectively.
+type shmRing struct {
+	head *uint32
+	tail *uint32
+	data []byte
+}
+
+func newShmRing(mem []byte) shmRing {
+	return shmRing{
+		head: (*uint32)(unsafe.Pointer(&mem[shmRingHeadOffset])),
+		tail: (*uint32)(unsafe.Pointer(&mem[shmRingTailOffset])),
+		data: mem[shmRingHdrLen : shmRingHdrLen+shmRingSize],
+	}
+}
+
+// read reads n bytes from the ring, as consumer. It returns an error if fewer bytes are available.
+func (r *shmRing) read(n int) ([]byte, error) {
+	tail := atomic.LoadUint32(r.tail)
+	head := atomic.LoadUint32(r.head)
+	if int(head-tail) < n {
+		return nil, fmt.Errorf("shm ring contains %d bytes, expected %d", head-tail, n)
+	}
+	msg := make([]byte, n)
+	offset := int(tail & (shmRingSize - 1))
+	c := copy(msg, r.data[offset:])
+	copy(msg[c:], r.data)
+	atomic.StoreUint32(r.tail, tail+uint32(n))
+	return msg, nil
+}
+
+// write writes all of data into the ring, as producer. It returns false if there is not enough space.
+func (r *shmRing) write(data []byte) bool {
+	head := atomic.LoadUint32(r.head)
+	tail := atomic.LoadUint32(r.tail)
+	if shmRingSize-int(head-tail) < len(data) {
+		return false
+	}
+	offset := int(head & (shmRingSize - 1))
+	c := copy(r.data[offset:], data)
+	copy(r.data, data[c:])
+	atomic.StoreUint32(r.head, head+uint32(len(data)))
+	return true
+}
+
+// shmTransport is the shared-memory event transport offered by an OT node, consisting of
+// a ring for each direction.
+type shmTransport struct {
+	mem         []byte
+	toSimulator shmRing
+	toNode      shmRing
+}
+
+func newShmTransport(mem []byte) (*shmTransport, error) {
+	if len(mem) < shmRegionLen ||
+		binary.LittleEndian.Uint32(mem[0:4]) != shmMagic ||
+		binary.LittleEndian.Uint32(mem[4:8]) != shmVersion ||
+		binary.LittleEndian.Uint32(mem[8:12]) != shmRingSize {
+		return nil, fmt.Errorf("shm region has unsupported format")
+	}
+	toNodeOffset := shmRegionHdrLen + shmRingHdrLen + shmRingSize
+	return &shmTransport{
+		mem:         mem,
+		toSimulator: newShmRing(mem[shmRegionHdrLen:toNodeOffset]),
+		toNode:      newShmRing(mem[toNodeOffset:shmRegionLen]),
+	}, nil
+}
+
+// openShmTransport maps the shared-memory region with given name, as created by an OT node.
+func openShmTransport(name string) (*shmTransport, error) {
+	fn := filepath.Join(shmDir, strings.TrimPrefix(name, "/"))
+	f, err := os.OpenFile(fn, os.O_RDWR, 0)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+
+	mem, err := syscall.Mmap(int(f.Fd()), 0, shmRegionLen, syscall.PROT_READ|syscall.PROT_WRITE, syscall.MAP_SHARED)
+	if err != nil {
+		return nil, err
+	}
+	t, err := newShmTransport(mem)
+	if err != nil {
+		_ = syscall.Munmap(mem)
+		return nil, err
+	}
+	return t, nil
+}
+
+func (t *shmTransport) close() {
+	_ = syscall.Munmap(t.mem)
+}
+
+// shmConn is a node's socket connection that sends events via the shared-memory ring, once active.
+// Each write into the ring is announced to the node by a shm-data event on the socket, so that the
+// socket stream keeps defining the order of events.
+type shmConn struct {
+	net.Conn
+	shm      *shmTransport
+	txCodec  *HeaderCodec // codec of the events written, also used for the shm-data events
+	mutex    sync.Mutex
+	isActive bool
+	isClosed bool
+}
+
+func newShmConn(conn net.Conn, shm *shmTransport) *shmConn {
+	return &shmConn{
+		Conn: conn,
+		shm:  shm,
+	}
+}
+
+// activate starts the use of the ring for writes, once the node was notified of the acceptance.
+func (c *shmConn) activate(txCodec *HeaderCodec) {
+	c.mutex.Lock()
+	defer c.mutex.Unlock()
+	c.txCodec = txCodec
+	c.isActive = !c.isClosed
+}
+
+func (c *shmConn) Write(b []byte) (int, error) {
+	c.mutex.Lock()
+	defer c.mutex.Unlock()
+
+	if c.isActive && len(b) <= shmMaxDataLen && c.shm.toNode.write(b) {
+		if _, err := c.Conn.Write(serializeShmDataEvent(len(b), c.txCodec)); err != nil {
+			return 0, err
+		}
+		return len(b), nil
+	}
+	return c.Conn.Write(b)
+}
+
+// readEvents reads n bytes of events from the node's ring.
+func (c *shmConn) readEvents(n int) ([]byte, error) {
+	return c.shm.toSimulator.read(n)
+}
+
+// closeShm unmaps the shared-memory region; further writes use the socket only.
+func (c *shmConn) closeShm() {
+	c.mutex.Lock()
+	defer c.mutex.Unlock()
+	if !c.isClosed {
+		c.isClosed = true
+		c.isActive = false
+		c.shm.close()
+	}
+}
+
+func serializeShmDataEvent(n int, codec *HeaderCodec) []byte {
+	data := make([]byte, 4)
+	binary.LittleEndian.PutUint32(data, uint32(n))
+	evt := &Event{
+		Type:  EventTypeShmData,
+		MsgId: codec.LastMsgId(), // shm-data events aren't part of the MsgId sequence.
+		Data:  data,
+	}
+	return evt.SerializeWith(codec)
+}
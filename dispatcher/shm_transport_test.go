@@ -0,0 +1,92 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"encoding/binary"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func newTestShmRegion() []byte {
+	mem := make([]byte, shmRegionLen)
+	binary.LittleEndian.PutUint32(mem[0:4], shmMagic)
+	binary.LittleEndian.PutUint32(mem[4:8], shmVersion)
+	binary.LittleEndian.PutUint32(mem[8:12], shmRingSize)
+	return mem
+}
+
+func TestShmTransport_InvalidRegion(t *testing.T) {
+	mem := newTestShmRegion()
+	mem[0] = 0
+	_, err := newShmTransport(mem)
+	assert.NotNil(t, err)
+
+	_, err = newShmTransport(newTestShmRegion()[:shmRegionLen-1])
+	assert.NotNil(t, err)
+}
+
+func TestShmRing_WriteRead(t *testing.T) {
+	shm, err := newShmTransport(newTestShmRegion())
+	assert.Nil(t, err)
+
+	// rings are separate
+	assert.True(t, shm.toNode.write([]byte{1, 2, 3}))
+	_, err = shm.toSimulator.read(1)
+	assert.NotNil(t, err)
+
+	data, err := shm.toNode.read(3)
+	assert.Nil(t, err)
+	assert.Equal(t, []byte{1, 2, 3}, data)
+	_, err = shm.toNode.read(1)
+	assert.NotNil(t, err)
+}
+
+func TestShmRing_Wrap(t *testing.T) {
+	shm, err := newShmTransport(newTestShmRegion())
+	assert.Nil(t, err)
+	r := &shm.toSimulator
+
+	block := make([]byte, shmRingSize/2+1)
+	for i := range block {
+		block[i] = byte(i)
+	}
+	assert.True(t, r.write(block))
+	assert.False(t, r.write(block)) // no space left
+	data, err := r.read(len(block))
+	assert.Nil(t, err)
+	assert.Equal(t, block, data)
+
+	// this write wraps around the end of the ring.
+	assert.True(t, r.write(block))
+	data, err = r.read(len(block))
+	assert.Nil(t, err)
+	assert.Equal(t, block, data)
+	assert.Equal(t, uint32(2*len(block)), *r.head)
+	assert.Equal(t, *r.head, *r.tail)
+}
@@ -27,6 +27,10 @@
 package dispatcher
 
 import (
+	"strconv"
+	"strings"
+
+	"github.com/openthread/ot-ns/logger"
 	. "github.com/openthread/ot-ns/types"
 	"github.com/openthread/ot-ns/visualize"
 )
@@ -161,3 +165,32 @@ func countFailed(nodes map[NodeId]*Node) int {
 	}
 	return c
 }
+
+// parseProfileCounters parses the profiling counters pushed by a node, in format '<key>:<value>,...'. Next
+// to the counters of the node, it adds the summary counters 'ev.num' and 'ev.ns' (totals over all event
+// types) and 'busy.ns' (total wall-clock time the node spent handling events or processing its stack).
+// Comparing 'busy.ns' and 'select.ns' shows whether a node is CPU-bound or waiting for the simulator.
+func parseProfileCounters(data string) map[string]uint64 {
+	res := make(map[string]uint64)
+	for _, kv := range strings.Split(data, ",") {
+		sp := strings.Split(kv, ":")
+		if len(sp) != 2 {
+			continue
+		}
+		val, err := strconv.ParseUint(sp[1], 10, 64)
+		if err != nil {
+			logger.Warnf("invalid profile counter value: %s", kv)
+			continue
+		}
+		res[sp[0]] = val
+		if strings.HasPrefix(sp[0], "ev") {
+			if strings.HasSuffix(sp[0], ".num") {
+				res["ev.num"] += val
+			} else if strings.HasSuffix(sp[0], ".ns") {
+				res["ev.ns"] += val
+			}
+		}
+	}
+	res["busy.ns"] = res["ev.ns"] + res["stack.ns"]
+	return res
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func TestParseProfileCounters(t *testing.T) {
+	c := parseProfileCounters("tx.events:10,tx.bytes:400,stack.ns:1000,select.ns:5000,ev6.num:3,ev6.ns:300,ev7.num:2,ev7.ns:200")
+	assert.Equal(t, uint64(10), c["tx.events"])
+	assert.Equal(t, uint64(400), c["tx.bytes"])
+	assert.Equal(t, uint64(3), c["ev6.num"])
+	assert.Equal(t, uint64(5), c["ev.num"])
+	assert.Equal(t, uint64(500), c["ev.ns"])
+	assert.Equal(t, uint64(1500), c["busy.ns"])
+	assert.Equal(t, uint64(5000), c["select.ns"])
+
+	c = parseProfileCounters("tx.events:x,flash.calls:4,invalid")
+	_, ok := c["tx.events"]
+	assert.False(t, ok)
+	assert.Equal(t, uint64(4), c["flash.calls"])
+	assert.Equal(t, uint64(0), c["busy.ns"])
+}
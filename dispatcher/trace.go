@@ -0,0 +1,231 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"bufio"
+	"encoding/binary"
+	"encoding/json"
+	"fmt"
+	"io"
+	"os"
+	"sync"
+
+	. "github.com/openthread/ot-ns/event"
+	. "github.com/openthread/ot-ns/types"
+)
+
+// An event trace records all inputs of the Dispatcher: the events received from nodes, the time instants at
+// which it processed its queued events, and the changes of nodes and radio model. It can be replayed with
+// ReplayTrace, without any node processes, to measure the Dispatcher itself.
+//
+// The trace file starts with traceMagic and the root random seed (int64). The records that follow start with
+// a kind byte, the Dispatcher time (uint64) and a NodeId (int32). Records with kind-specific data follow this
+// with the data length (uint32) and the data. All integers are little-endian.
+const traceMagic = "OTNSTRC1"
+
+type traceRecordKind = uint8
+
+const (
+	traceRecordEvent      traceRecordKind = 1 // data: event received from the node, in the default header format.
+	traceRecordStep       traceRecordKind = 2 // processing of the queued events and alarms of a time instant.
+	traceRecordAddNode    traceRecordKind = 3 // data: NodeConfig as JSON.
+	traceRecordDeleteNode traceRecordKind = 4
+	traceRecordNodePos    traceRecordKind = 5 // data: int32 X, Y, Z.
+	traceRecordNodeFailed traceRecordKind = 6 // data: uint8 failed (1) or recovered (0).
+	traceRecordRadioModel traceRecordKind = 7 // data: radio model name.
+)
+
+const traceRecordHeaderLen = 1 + 8 + 4
+
+type traceRecord struct {
+	Kind   traceRecordKind
+	Time   uint64
+	NodeId NodeId
+	Data   []byte
+}
+
+// traceWriter writes an event trace. It may be used by multiple goroutines.
+type traceWriter struct {
+	mutex sync.Mutex
+	file  *os.File
+	w     *bufio.Writer
+	err   error
+}
+
+func newTraceWriter(filename string, randomSeed int64) (*traceWriter, error) {
+	f, err := os.Create(filename)
+	if err != nil {
+		return nil, err
+	}
+	tw := &traceWriter{
+		file: f,
+		w:    bufio.NewWriterSize(f, 1<<20),
+	}
+	var seed [8]byte
+	binary.LittleEndian.PutUint64(seed[:], uint64(randomSeed))
+	_, _ = tw.w.WriteString(traceMagic)
+	_, tw.err = tw.w.Write(seed[:])
+	return tw, tw.err
+}
+
+func (tw *traceWriter) write(kind traceRecordKind, ts uint64, nodeid NodeId, data ...[]byte) {
+	tw.mutex.Lock()
+	defer tw.mutex.Unlock()
+
+	if tw.err != nil {
+		return
+	}
+	var hdr [traceRecordHeaderLen + 4]byte
+	hdr[0] = kind
+	binary.LittleEndian.PutUint64(hdr[1:9], ts)
+	binary.LittleEndian.PutUint32(hdr[9:13], uint32(nodeid))
+	n := traceRecordHeaderLen
+	if len(data) > 0 {
+		binary.LittleEndian.PutUint32(hdr[13:17], uint32(len(data[0])))
+		n += 4
+	}
+	_, tw.err = tw.w.Write(hdr[:n])
+	for _, b := range data {
+		if tw.err == nil {
+			_, tw.err = tw.w.Write(b)
+		}
+	}
+}
+
+func (tw *traceWriter) recordEvent(ts uint64, evt *Event) {
+	raw := evt.TraceData
+	if raw == nil {
+		raw = evt.Serialize() // events generated locally, e.g. node disconnects.
+	}
+	tw.write(traceRecordEvent, ts, evt.NodeId, raw)
+}
+
+func (tw *traceWriter) recordStep(ts uint64) {
+	tw.write(traceRecordStep, ts, 0)
+}
+
+func (tw *traceWriter) recordAddNode(ts uint64, nodeid NodeId, cfg *NodeConfig) {
+	data, err := json.Marshal(cfg)
+	if err != nil {
+		tw.mutex.Lock()
+		tw.err = err
+		tw.mutex.Unlock()
+		return
+	}
+	tw.write(traceRecordAddNode, ts, nodeid, data)
+}
+
+func (tw *traceWriter) recordDeleteNode(ts uint64, nodeid NodeId) {
+	tw.write(traceRecordDeleteNode, ts, nodeid)
+}
+
+func (tw *traceWriter) recordNodePos(ts uint64, nodeid NodeId, x, y, z int) {
+	var pos [12]byte
+	binary.LittleEndian.PutUint32(pos[0:4], uint32(int32(x)))
+	binary.LittleEndian.PutUint32(pos[4:8], uint32(int32(y)))
+	binary.LittleEndian.PutUint32(pos[8:12], uint32(int32(z)))
+	tw.write(traceRecordNodePos, ts, nodeid, pos[:])
+}
+
+func (tw *traceWriter) recordNodeFailed(ts uint64, nodeid NodeId, fail bool) {
+	var failed byte
+	if fail {
+		failed = 1
+	}
+	tw.write(traceRecordNodeFailed, ts, nodeid, []byte{failed})
+}
+
+func (tw *traceWriter) recordRadioModel(ts uint64, name string) {
+	tw.write(traceRecordRadioModel, ts, 0, []byte(name))
+}
+
+// Close flushes and closes the trace file, and returns the first error that occurred, if any.
+func (tw *traceWriter) Close() error {
+	tw.mutex.Lock()
+	defer tw.mutex.Unlock()
+
+	if tw.err == nil {
+		tw.err = tw.w.Flush()
+	}
+	if err := tw.file.Close(); tw.err == nil {
+		tw.err = err
+	}
+	return tw.err
+}
+
+// traceReader reads the records of an event trace.
+type traceReader struct {
+	r          *bufio.Reader
+	randomSeed int64
+}
+
+func newTraceReader(r io.Reader) (*traceReader, error) {
+	tr := &traceReader{
+		r: bufio.NewReaderSize(r, 1<<20),
+	}
+	var hdr [len(traceMagic) + 8]byte
+	if _, err := io.ReadFull(tr.r, hdr[:]); err != nil {
+		return nil, err
+	}
+	if string(hdr[:len(traceMagic)]) != traceMagic {
+		return nil, fmt.Errorf("not an OTNS event trace")
+	}
+	tr.randomSeed = int64(binary.LittleEndian.Uint64(hdr[len(traceMagic):]))
+	return tr, nil
+}
+
+// next reads the next record. It returns io.EOF at the end of the trace.
+func (tr *traceReader) next(rec *traceRecord) error {
+	var hdr [traceRecordHeaderLen]byte
+	if _, err := io.ReadFull(tr.r, hdr[:]); err != nil {
+		return err
+	}
+	rec.Kind = hdr[0]
+	rec.Time = binary.LittleEndian.Uint64(hdr[1:9])
+	rec.NodeId = NodeId(int32(binary.LittleEndian.Uint32(hdr[9:13])))
+	rec.Data = nil
+
+	switch rec.Kind {
+	case traceRecordStep, traceRecordDeleteNode:
+		return nil
+	case traceRecordEvent, traceRecordAddNode, traceRecordNodePos, traceRecordNodeFailed, traceRecordRadioModel:
+		break
+	default:
+		return fmt.Errorf("invalid trace record kind %d", rec.Kind)
+	}
+	var lenBuf [4]byte
+	if _, err := io.ReadFull(tr.r, lenBuf[:]); err != nil {
+		return io.ErrUnexpectedEOF
+	}
+	dataLen := binary.LittleEndian.Uint32(lenBuf[:])
+	rec.Data = make([]byte, dataLen)
+	if _, err := io.ReadFull(tr.r, rec.Data); err != nil {
+		return io.ErrUnexpectedEOF
+	}
+	return nil
+}
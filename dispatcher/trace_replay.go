@@ -0,0 +1,226 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"encoding/binary"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"net"
+	"os"
+	"syscall"
+	"time"
+
+	"github.com/openthread/ot-ns/energy"
+	. "github.com/openthread/ot-ns/event"
+	"github.com/openthread/ot-ns/logger"
+	"github.com/openthread/ot-ns/prng"
+	"github.com/openthread/ot-ns/progctx"
+	"github.com/openthread/ot-ns/radiomodel"
+	. "github.com/openthread/ot-ns/types"
+)
+
+// TraceReplayResult is the machine-readable result of replaying an event trace.
+type TraceReplayResult struct {
+	TraceFile        string      `json:"trace_file"`
+	Nodes            int         `json:"nodes"`               // number of nodes added.
+	Events           uint64      `json:"events"`              // number of node events replayed.
+	Steps            uint64      `json:"steps"`               // number of time instants processed.
+	Divergences      uint64      `json:"divergences"`         // steps at which the replayed queue differed from the trace.
+	SimTimeUs        uint64      `json:"sim_time_us"`         // simulated time covered by the trace.
+	WallTimeSec      float64     `json:"wall_time_s"`         // wall-clock time of the replay.
+	CpuTimeSec       float64     `json:"cpu_time_s"`          // user+system CPU time of the replay.
+	SimSecPerWallSec float64     `json:"sim_s_per_wall_s"`    // simulation speed achieved.
+	EventsPerSec     float64     `json:"events_per_s"`        // node events handled per wall-clock second.
+	PeakRssKB        int64       `json:"peak_rss_kb"`         // peak resident set size of the process.
+	DispatcherCounts interface{} `json:"dispatcher_counters"` // the Dispatcher's Counters at the end.
+}
+
+// replayCallbackHandler ignores all Dispatcher callbacks, as there is no simulation during a replay.
+type replayCallbackHandler struct{}
+
+func (replayCallbackHandler) OnUartWrite(NodeId, []byte)  {}
+func (replayCallbackHandler) OnLogWrite(NodeId, []byte)   {}
+func (replayCallbackHandler) OnNextEventTime(uint64)      {}
+func (replayCallbackHandler) OnRfSimEvent(NodeId, *Event) {}
+func (replayCallbackHandler) OnMsgToHost(NodeId, *Event)  {}
+
+// replayConn stands in for the socket of a node during a replay; all events sent to it are discarded.
+type replayConn struct {
+	net.Conn
+}
+
+func (replayConn) Write(b []byte) (int, error) {
+	return len(b), nil
+}
+
+func (replayConn) Close() error {
+	return nil
+}
+
+// ReplayTrace replays an event trace, recorded with Config.TraceFile, against a new Dispatcher without
+// any node processes: the events of the nodes are taken from the trace and events sent to nodes are
+// discarded. Radio model parameters changed during the recording are not in the trace; the replay uses
+// the radio model defaults. The replay is stopped early if ctx is done.
+func ReplayTrace(ctx *progctx.ProgCtx, filename string) (*TraceReplayResult, error) {
+	f, err := os.Open(filename)
+	if err != nil {
+		return nil, err
+	}
+	defer f.Close()
+
+	tr, err := newTraceReader(f)
+	if err != nil {
+		return nil, fmt.Errorf("%s: %w", filename, err)
+	}
+	prng.Init(tr.randomSeed)
+
+	cfg := DefaultConfig()
+	cfg.Speed = MaxSimulateSpeed
+	cfg.PcapEnabled = false
+	cfg.SimulationId = os.Getpid() // a unique socket name; the socket isn't used.
+	d := NewDispatcher(ctx, cfg, replayCallbackHandler{})
+	d.SetEnergyAnalyser(energy.NewEnergyAnalyser())
+	defer d.Stop()
+
+	res := &TraceReplayResult{TraceFile: filename}
+	conn := replayConn{}
+	var rec traceRecord
+	var startTime uint64
+	var usage0, usage1 syscall.Rusage
+	_ = syscall.Getrusage(syscall.RUSAGE_SELF, &usage0)
+	wallStart := time.Now()
+
+	for err = tr.next(&rec); err == nil && !d.isStopping(); err = tr.next(&rec) {
+		if res.Events == 0 && res.Steps == 0 {
+			startTime = rec.Time
+		}
+		if d.radioModel == nil && rec.Kind != traceRecordRadioModel {
+			d.SetRadioModel(radiomodel.NewRadioModel("default")) // the trace lacks the initial radio model.
+		}
+		if d.replayAdvanceTime(rec.Time) {
+			res.Divergences++
+		}
+
+		switch rec.Kind {
+		case traceRecordEvent:
+			evt := &Event{}
+			if evt.Deserialize(rec.Data) != len(rec.Data) {
+				return nil, fmt.Errorf("invalid event in trace record at time %d", rec.Time)
+			}
+			evt.NodeId = rec.NodeId
+			evt.Conn = conn
+			d.handleRecvEvent(evt)
+			res.Events++
+		case traceRecordStep:
+			if d.replayStep(rec.Time) {
+				res.Divergences++
+			}
+			res.Steps++
+		case traceRecordAddNode:
+			nodeCfg := &NodeConfig{}
+			if err = json.Unmarshal(rec.Data, nodeCfg); err != nil {
+				return nil, err
+			}
+			d.AddNode(rec.NodeId, nodeCfg).conn = conn
+			res.Nodes++
+		case traceRecordDeleteNode:
+			if d.nodes[rec.NodeId] != nil {
+				d.DeleteNode(rec.NodeId)
+			}
+		case traceRecordNodePos:
+			if d.nodes[rec.NodeId] != nil && len(rec.Data) == 12 {
+				d.SetNodePos(rec.NodeId, int(int32(binary.LittleEndian.Uint32(rec.Data[0:4]))),
+					int(int32(binary.LittleEndian.Uint32(rec.Data[4:8]))),
+					int(int32(binary.LittleEndian.Uint32(rec.Data[8:12]))))
+			}
+		case traceRecordNodeFailed:
+			if d.nodes[rec.NodeId] != nil && len(rec.Data) == 1 {
+				d.SetNodeFailed(rec.NodeId, rec.Data[0] != 0)
+			}
+		case traceRecordRadioModel:
+			if model := radiomodel.NewRadioModel(string(rec.Data)); model != nil {
+				d.SetRadioModel(model)
+			}
+		}
+	}
+	if !errors.Is(err, io.EOF) && err != nil {
+		return nil, fmt.Errorf("%s: %w", filename, err)
+	}
+
+	wallTime := time.Since(wallStart).Seconds()
+	_ = syscall.Getrusage(syscall.RUSAGE_SELF, &usage1)
+	res.SimTimeUs = d.CurTime - startTime
+	res.WallTimeSec = wallTime
+	res.CpuTimeSec = rusageSeconds(&usage1) - rusageSeconds(&usage0)
+	if wallTime > 0 {
+		res.SimSecPerWallSec = float64(res.SimTimeUs) / 1e6 / wallTime
+		res.EventsPerSec = float64(res.Events) / wallTime
+	}
+	res.PeakRssKB = usage1.Maxrss
+	res.DispatcherCounts = d.Counters
+	if res.Divergences > 0 {
+		logger.Warnf("replay diverged from the trace at %d of %d steps", res.Divergences, res.Steps)
+	}
+	return res, nil
+}
+
+// replayAdvanceTime advances the time to ts, for replaying a trace record at time ts. It returns true if the
+// replay diverged from the recording, i.e. if queued events before ts had to be processed first.
+func (d *Dispatcher) replayAdvanceTime(ts uint64) bool {
+	isDiverged := false
+	for {
+		nextEventTime := min(d.alarmMgr.NextTimestamp(), d.eventQueue.NextTimestamp())
+		if nextEventTime >= ts {
+			break
+		}
+		d.pauseTime = nextEventTime
+		d.processNextEvent(MaxSimulateSpeed)
+		isDiverged = true
+	}
+	if ts > d.CurTime {
+		d.advanceTime(ts)
+	}
+	return isDiverged
+}
+
+// replayStep processes the queued events and alarms of time instant ts, as recorded by a trace step. It
+// returns true if the replay diverged from the recording, i.e. if there were no queued events at ts.
+func (d *Dispatcher) replayStep(ts uint64) bool {
+	if min(d.alarmMgr.NextTimestamp(), d.eventQueue.NextTimestamp()) != ts {
+		return true
+	}
+	d.pauseTime = ts
+	d.processNextEvent(MaxSimulateSpeed)
+	return false
+}
+
+func rusageSeconds(ru *syscall.Rusage) float64 {
+	return float64(ru.Utime.Sec+ru.Stime.Sec) + float64(ru.Utime.Usec+ru.Stime.Usec)/1e6
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"encoding/json"
+	"io"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	. "github.com/openthread/ot-ns/event"
+	. "github.com/openthread/ot-ns/types"
+)
+
+func TestTraceRoundTrip(t *testing.T) {
+	filename := filepath.Join(t.TempDir(), "test.trace")
+	tw, err := newTraceWriter(filename, -12345)
+	assert.Nil(t, err)
+
+	cfg := &NodeConfig{ID: 3, Type: ROUTER, X: 10, Y: 20, RadioRange: 160}
+	tw.recordRadioModel(0, "MutualInterference")
+	tw.recordAddNode(0, 3, cfg)
+	evt := &Event{Delay: 100, Type: EventTypeStatusPush, MsgId: 7, NodeId: 3, Data: []byte("role=4")}
+	tw.recordEvent(5, evt)
+	tw.recordStep(100)
+	tw.recordNodePos(200, 3, 30, -40, 1)
+	tw.recordNodeFailed(300, 3, true)
+	tw.recordDeleteNode(400, 3)
+	assert.Nil(t, tw.Close())
+
+	f, err := os.Open(filename)
+	assert.Nil(t, err)
+	defer f.Close()
+	tr, err := newTraceReader(f)
+	assert.Nil(t, err)
+	assert.Equal(t, int64(-12345), tr.randomSeed)
+
+	var rec traceRecord
+	assert.Nil(t, tr.next(&rec))
+	assert.Equal(t, traceRecordRadioModel, rec.Kind)
+	assert.Equal(t, "MutualInterference", string(rec.Data))
+
+	assert.Nil(t, tr.next(&rec))
+	assert.Equal(t, traceRecordAddNode, rec.Kind)
+	assert.Equal(t, NodeId(3), rec.NodeId)
+	cfg2 := &NodeConfig{}
+	assert.Nil(t, json.Unmarshal(rec.Data, cfg2))
+	assert.Equal(t, *cfg, *cfg2)
+
+	assert.Nil(t, tr.next(&rec))
+	assert.Equal(t, traceRecordEvent, rec.Kind)
+	assert.Equal(t, uint64(5), rec.Time)
+	evt2 := &Event{}
+	assert.Equal(t, len(rec.Data), evt2.Deserialize(rec.Data))
+	assert.Equal(t, evt.Delay, evt2.Delay)
+	assert.Equal(t, evt.MsgId, evt2.MsgId)
+	assert.Equal(t, evt.Data, evt2.Data)
+
+	assert.Nil(t, tr.next(&rec))
+	assert.Equal(t, traceRecordStep, rec.Kind)
+	assert.Equal(t, uint64(100), rec.Time)
+
+	assert.Nil(t, tr.next(&rec))
+	assert.Equal(t, traceRecordNodePos, rec.Kind)
+	assert.Equal(t, 12, len(rec.Data))
+
+	assert.Nil(t, tr.next(&rec))
+	assert.Equal(t, traceRecordNodeFailed, rec.Kind)
+	assert.Equal(t, []byte{1}, rec.Data)
+
+	assert.Nil(t, tr.next(&rec))
+	assert.Equal(t, traceRecordDeleteNode, rec.Kind)
+	assert.Equal(t, uint64(400), rec.Time)
+
+	assert.Equal(t, io.EOF, tr.next(&rec))
+}
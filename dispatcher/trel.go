@@ -0,0 +1,150 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	. "github.com/openthread/ot-ns/event"
+	. "github.com/openthread/ot-ns/types"
+)
+
+// trelLatencyUs is the one-way latency of TREL messages over the simulated infrastructure link, in us. It is
+// above the PDES lookahead, so that in PDES mode a message never arrives in the past of the receiver's partition.
+const trelLatencyUs = 1000
+
+type trelService struct {
+	port uint16
+	txt  []byte
+}
+
+// trelState keeps the TREL (Thread Radio Encapsulation Link) services registered by nodes, and the nodes that
+// browse for them. The dispatcher acts as the DNS-SD infrastructure for peer discovery, and as the infrastructure
+// link that delivers TREL UDP packets to the node owning the destination port; both in simulated time.
+type trelState struct {
+	services map[NodeId]*trelService
+	ports    map[uint16]NodeId
+	browsing map[NodeId]struct{}
+}
+
+func newTrelState() *trelState {
+	return &trelState{
+		services: map[NodeId]*trelService{},
+		ports:    map[uint16]NodeId{},
+		browsing: map[NodeId]struct{}{},
+	}
+}
+
+// handleTrelEvent handles a TREL browse, service or data event sent by the node.
+func (d *Dispatcher) handleTrelEvent(node *Node, evt *Event) {
+	ts := d.trel
+	switch evt.Type {
+	case EventTypeTrelBrowse:
+		ts.browsing[node.Id] = struct{}{}
+		for _, peer := range d.nodesArray {
+			if svc := ts.services[peer.Id]; svc != nil && peer != node {
+				d.sendTrelPeerEvent(node.Id, svc, 0)
+			}
+		}
+	case EventTypeTrelService:
+		d.removeTrelService(node.Id)
+		if evt.TrelData.Flags&TrelFlagRemoved == 0 {
+			svc := &trelService{
+				port: evt.TrelData.Port,
+				txt:  evt.Data,
+			}
+			ts.services[node.Id] = svc
+			ts.ports[svc.port] = node.Id
+			d.notifyTrelBrowsers(node.Id, svc, 0)
+		}
+	case EventTypeTrelData:
+		dstId, ok := ts.ports[evt.TrelData.Port]
+		if !ok || dstId == node.Id || d.nodes[dstId] == nil {
+			d.Counters.DispatchTrelFail++
+			break
+		}
+		var srcPort uint16
+		if svc := ts.services[node.Id]; svc != nil {
+			srcPort = svc.port
+		}
+		d.Counters.DispatchTrelSucc++
+		d.queueTrelEvent(&Event{
+			Type:     EventTypeTrelData,
+			NodeId:   dstId,
+			Data:     evt.Data,
+			TrelData: TrelEventData{Port: srcPort},
+		})
+	}
+}
+
+// removeTrelService removes the TREL service of the node, if any, and notifies the browsing nodes.
+func (d *Dispatcher) removeTrelService(id NodeId) {
+	ts := d.trel
+	svc := ts.services[id]
+	if svc == nil {
+		return
+	}
+	delete(ts.services, id)
+	if ts.ports[svc.port] == id {
+		delete(ts.ports, svc.port)
+	}
+	d.notifyTrelBrowsers(id, svc, TrelFlagRemoved)
+}
+
+// deleteTrelNode removes all TREL state of a deleted node.
+func (d *Dispatcher) deleteTrelNode(id NodeId) {
+	d.removeTrelService(id)
+	delete(d.trel.browsing, id)
+}
+
+func (d *Dispatcher) notifyTrelBrowsers(srcId NodeId, svc *trelService, flags uint8) {
+	for _, node := range d.nodesArray {
+		if _, ok := d.trel.browsing[node.Id]; ok && node.Id != srcId {
+			d.sendTrelPeerEvent(node.Id, svc, flags)
+		}
+	}
+}
+
+func (d *Dispatcher) sendTrelPeerEvent(dstId NodeId, svc *trelService, flags uint8) {
+	d.queueTrelEvent(&Event{
+		Type:     EventTypeTrelPeer,
+		NodeId:   dstId,
+		Data:     svc.txt,
+		TrelData: TrelEventData{Port: svc.port, Flags: flags},
+	})
+}
+
+// queueTrelEvent queues a TREL event for delivery to its node, after the infrastructure link latency.
+func (d *Dispatcher) queueTrelEvent(evt *Event) {
+	delay := uint64(trelLatencyUs)
+	if d.cfg.Pdes {
+		if lookahead := d.partitions.getLookahead(d); lookahead >= delay {
+			delay = lookahead + 1
+		}
+	}
+	evt.Timestamp = d.CurTime + delay
+	evt.MustDispatch = true
+	d.eventQueue.Add(evt)
+}
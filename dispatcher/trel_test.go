@@ -0,0 +1,131 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package dispatcher
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	. "github.com/openthread/ot-ns/event"
+	. "github.com/openthread/ot-ns/types"
+)
+
+func newTrelTestDispatcher(numNodes int) *Dispatcher {
+	d := &Dispatcher{
+		CurTime:    1000000,
+		nodes:      map[NodeId]*Node{},
+		eventQueue: newSendQueue(),
+		trel:       newTrelState(),
+	}
+	for id := 1; id <= numNodes; id++ {
+		node := &Node{Id: id}
+		d.nodes[id] = node
+		d.nodesArray = append(d.nodesArray, node)
+	}
+	return d
+}
+
+func popTrelEvents(d *Dispatcher) []*Event {
+	var evts []*Event
+	for d.eventQueue.Len() > 0 {
+		evts = append(evts, d.eventQueue.PopNext())
+	}
+	return evts
+}
+
+func TestTrelPeerDiscovery(t *testing.T) {
+	d := newTrelTestDispatcher(3)
+
+	// node 1 browses before any service exists.
+	d.handleTrelEvent(d.nodes[1], &Event{Type: EventTypeTrelBrowse})
+	assert.Equal(t, 0, d.eventQueue.Len())
+
+	// node 2 registers: node 1 (browsing) learns of it, after the link latency.
+	d.handleTrelEvent(d.nodes[2], &Event{Type: EventTypeTrelService, Data: []byte("txt2"),
+		TrelData: TrelEventData{Port: 9202}})
+	evts := popTrelEvents(d)
+	assert.Equal(t, 1, len(evts))
+	assert.Equal(t, EventTypeTrelPeer, evts[0].Type)
+	assert.Equal(t, 1, evts[0].NodeId)
+	assert.Equal(t, d.CurTime+trelLatencyUs, evts[0].Timestamp)
+	assert.True(t, evts[0].MustDispatch)
+	assert.Equal(t, uint16(9202), evts[0].TrelData.Port)
+	assert.Equal(t, uint8(0), evts[0].TrelData.Flags)
+	assert.Equal(t, []byte("txt2"), evts[0].Data)
+
+	// node 3 browses later: it learns of the existing service of node 2.
+	d.handleTrelEvent(d.nodes[3], &Event{Type: EventTypeTrelBrowse})
+	evts = popTrelEvents(d)
+	assert.Equal(t, 1, len(evts))
+	assert.Equal(t, 3, evts[0].NodeId)
+	assert.Equal(t, uint16(9202), evts[0].TrelData.Port)
+
+	// node 2 is deleted: its service is removed at the browsing nodes 1 and 3.
+	d.nodesArray = []*Node{d.nodes[1], d.nodes[3]}
+	delete(d.nodes, 2)
+	d.deleteTrelNode(2)
+	evts = popTrelEvents(d)
+	assert.Equal(t, 2, len(evts))
+	for _, evt := range evts {
+		assert.Equal(t, EventTypeTrelPeer, evt.Type)
+		assert.Equal(t, TrelFlagRemoved, evt.TrelData.Flags)
+		assert.Equal(t, uint16(9202), evt.TrelData.Port)
+	}
+	assert.Equal(t, 0, len(d.trel.ports))
+}
+
+func TestTrelDataDelivery(t *testing.T) {
+	d := newTrelTestDispatcher(2)
+	d.handleTrelEvent(d.nodes[1], &Event{Type: EventTypeTrelService, TrelData: TrelEventData{Port: 9201}})
+	d.handleTrelEvent(d.nodes[2], &Event{Type: EventTypeTrelService, TrelData: TrelEventData{Port: 9202}})
+	assert.Equal(t, 0, d.eventQueue.Len()) // no browsers.
+
+	// unicast from node 1 to the port of node 2, delivered with the source port of node 1.
+	d.handleTrelEvent(d.nodes[1], &Event{Type: EventTypeTrelData, Data: []byte{1, 2, 3},
+		TrelData: TrelEventData{Port: 9202}})
+	evts := popTrelEvents(d)
+	assert.Equal(t, 1, len(evts))
+	assert.Equal(t, EventTypeTrelData, evts[0].Type)
+	assert.Equal(t, 2, evts[0].NodeId)
+	assert.Equal(t, uint16(9201), evts[0].TrelData.Port)
+	assert.Equal(t, []byte{1, 2, 3}, evts[0].Data)
+	assert.Equal(t, uint64(1), d.Counters.DispatchTrelSucc)
+
+	// unknown port, and own port, are dropped.
+	d.handleTrelEvent(d.nodes[1], &Event{Type: EventTypeTrelData, TrelData: TrelEventData{Port: 9999}})
+	d.handleTrelEvent(d.nodes[1], &Event{Type: EventTypeTrelData, TrelData: TrelEventData{Port: 9201}})
+	assert.Equal(t, 0, d.eventQueue.Len())
+	assert.Equal(t, uint64(2), d.Counters.DispatchTrelFail)
+
+	// after removal of the service of node 2, its port is unknown.
+	d.handleTrelEvent(d.nodes[2], &Event{Type: EventTypeTrelService, TrelData: TrelEventData{Port: 9202,
+		Flags: TrelFlagRemoved}})
+	d.handleTrelEvent(d.nodes[1], &Event{Type: EventTypeTrelData, TrelData: TrelEventData{Port: 9202}})
+	assert.Equal(t, 0, d.eventQueue.Len())
+	assert.Equal(t, uint64(3), d.Counters.DispatchTrelFail)
+}
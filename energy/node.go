@@ -32,8 +32,10 @@ import (
 )
 
 type NodeEnergy struct {
-	NodeId int
-	radio  RadioStatus
+	NodeId     int
+	radio      RadioStatus
+	reportBase RadioStatus // radio status at the last energy report by the node, if reports are used.
+	isReported bool        // if the node reports its energy, which then overrides the estimate from radio states.
 
 	Disabled float64
 	Sleep    float64
@@ -66,6 +68,32 @@ func (node *NodeEnergy) SetRadioState(state RadioStates, timestamp uint64) {
 	node.radio.State = state
 }
 
+// StartRadioEnergyReports starts using the energy reports of the node, which are then applied by
+// SetRadioEnergy(). Until the first report, and between reports, the radio states keep being used as estimate.
+func (node *NodeEnergy) StartRadioEnergyReports(timestamp uint64) {
+	node.ComputeRadioState(timestamp)
+	node.reportBase = node.radio
+	node.isReported = true
+}
+
+// SetRadioEnergy applies an energy report of the node, with the time (us) spent per energy-state since the
+// previous report. This replaces the estimate made from the radio states since the previous report.
+func (node *NodeEnergy) SetRadioEnergy(state RadioStates, disabledUs, sleepUs, rxUs, txUs uint64, timestamp uint64) {
+	if !node.isReported {
+		logger.Warnf("unexpected radio energy report of node %d", node.NodeId)
+		return
+	}
+	node.radio = RadioStatus{
+		State:         state,
+		SpentDisabled: node.reportBase.SpentDisabled + disabledUs,
+		SpentSleep:    node.reportBase.SpentSleep + sleepUs,
+		SpentTx:       node.reportBase.SpentTx + txUs,
+		SpentRx:       node.reportBase.SpentRx + rxUs,
+		Timestamp:     timestamp,
+	}
+	node.reportBase = node.radio
+}
+
 func newNode(nodeID int, timestamp uint64) *NodeEnergy {
 	node := &NodeEnergy{
 		NodeId: nodeID,
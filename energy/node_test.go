@@ -0,0 +1,68 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package energy
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	. "github.com/openthread/ot-ns/types"
+)
+
+func TestRadioEnergyReports(t *testing.T) {
+	node := newNode(1, 0)
+	node.SetRadioState(RadioRx, 100)
+	node.StartRadioEnergyReports(200)
+	assert.Equal(t, uint64(100), node.radio.SpentDisabled)
+	assert.Equal(t, uint64(100), node.radio.SpentRx)
+
+	// estimate from radio states, until the report replaces it.
+	node.SetRadioState(RadioTx, 300)
+	node.SetRadioState(RadioSleep, 400)
+	node.ComputeRadioState(1000)
+	assert.Equal(t, uint64(200), node.radio.SpentRx)
+	assert.Equal(t, uint64(100), node.radio.SpentTx)
+	assert.Equal(t, uint64(600), node.radio.SpentSleep)
+
+	node.SetRadioEnergy(RadioSleep, 0, 650, 120, 30, 1000)
+	assert.Equal(t, RadioStatus{
+		State:         RadioSleep,
+		SpentDisabled: 100,
+		SpentSleep:    650,
+		SpentTx:       30,
+		SpentRx:       220,
+		Timestamp:     1000,
+	}, node.radio)
+
+	// the next report adds to the previous one.
+	node.ComputeRadioState(2000)
+	node.SetRadioEnergy(RadioRx, 0, 900, 100, 0, 2000)
+	assert.Equal(t, uint64(1550), node.radio.SpentSleep)
+	assert.Equal(t, uint64(320), node.radio.SpentRx)
+	assert.Equal(t, RadioRx, node.radio.State)
+}
@@ -32,6 +32,7 @@ import (
 	"math"
 	"net"
 	"strings"
+	"sync"
 	"unicode"
 
 	"net/netip"
@@ -44,35 +45,76 @@ type EventType = uint8
 
 const (
 	// Event type IDs (external, shared between OT-NS and OT node)
-	EventTypeAlarmFired         EventType = 0
-	EventTypeRadioReceived      EventType = 1
-	EventTypeUartWrite          EventType = 2
-	EventTypeRadioSpinelWrite   EventType = 3
-	EventTypePostCmd            EventType = 4
-	EventTypeStatusPush         EventType = 5
-	EventTypeRadioCommStart     EventType = 6
-	EventTypeRadioTxDone        EventType = 7
-	EventTypeRadioChannelSample EventType = 8
-	EventTypeRadioState         EventType = 9
-	EventTypeRadioRxDone        EventType = 10
-	EventTypeExtAddr            EventType = 11
-	EventTypeNodeInfo           EventType = 12
-	EventTypeNodeDisconnected   EventType = 14
-	EventTypeRadioLog           EventType = 15
-	EventTypeRadioRfSimParamGet EventType = 16
-	EventTypeRadioRfSimParamSet EventType = 17
-	EventTypeRadioRfSimParamRsp EventType = 18
-	EventTypeLogWrite           EventType = 19
-	EventTypeUdpToHost          EventType = 20
-	EventTypeIp6ToHost          EventType = 21
-	EventTypeUdpFromHost        EventType = 22
-	EventTypeIp6FromHost        EventType = 23
+	EventTypeAlarmFired            EventType = 0
+	EventTypeRadioReceived         EventType = 1
+	EventTypeUartWrite             EventType = 2
+	EventTypeRadioSpinelWrite      EventType = 3
+	EventTypePostCmd               EventType = 4
+	EventTypeStatusPush            EventType = 5
+	EventTypeRadioCommStart        EventType = 6
+	EventTypeRadioTxDone           EventType = 7
+	EventTypeRadioChannelSample    EventType = 8
+	EventTypeRadioState            EventType = 9
+	EventTypeRadioRxDone           EventType = 10
+	EventTypeExtAddr               EventType = 11
+	EventTypeNodeInfo              EventType = 12
+	EventTypeNodeDisconnected      EventType = 14
+	EventTypeRadioLog              EventType = 15
+	EventTypeRadioRfSimParamGet    EventType = 16
+	EventTypeRadioRfSimParamSet    EventType = 17
+	EventTypeRadioRfSimParamRsp    EventType = 18
+	EventTypeLogWrite              EventType = 19
+	EventTypeUdpToHost             EventType = 20
+	EventTypeIp6ToHost             EventType = 21
+	EventTypeUdpFromHost           EventType = 22
+	EventTypeIp6FromHost           EventType = 23
+	EventTypeShmAccept             EventType = 24
+	EventTypeShmData               EventType = 25
+	EventTypeHeaderFormatOffer     EventType = 26
+	EventTypeHeaderFormat          EventType = 27
+	EventTypeRadioStateSleep       EventType = 28
+	EventTypeRadioStateSleepOffer  EventType = 29
+	EventTypeRadioStateSleepAccept EventType = 30
+	EventTypeSleepWakeupsOffer     EventType = 31
+	EventTypeSleepWakeupsAccept    EventType = 32
+	EventTypeTrelBrowse            EventType = 33
+	EventTypeTrelService           EventType = 34
+	EventTypeTrelPeer              EventType = 35
+	EventTypeTrelData              EventType = 36
+	EventTypeRadioEnergyOffer      EventType = 37
+	EventTypeRadioEnergyAccept     EventType = 38
+	EventTypeRadioEnergy           EventType = 39
 )
 
 const (
 	InvalidTimestamp uint64 = math.MaxUint64
 )
 
+// HeaderFormat is the wire format of event headers, as negotiated with an OT node.
+type HeaderFormat = uint8
+
+const (
+	// HeaderFormatDefault is the packed header: Delay uint64, Type uint8, MsgId uint64, DataLen uint16.
+	HeaderFormatDefault HeaderFormat = 0
+	// HeaderFormatCompact is the header with varint Delay, Type uint8, zigzag-varint delta-coded MsgId
+	// and varint DataLen. See OT-RFSIM event-sim.h.
+	HeaderFormatCompact HeaderFormat = 1
+)
+
+const eventMsgHeaderCompactMaxLen = binary.MaxVarintLen64*2 + 1 + binary.MaxVarintLen16
+
+// HeaderCodec keeps the header format and the state of one direction of an event stream,
+// for serializing or deserializing its events.
+type HeaderCodec struct {
+	Format    HeaderFormat
+	lastMsgId uint64 // MsgId of the last event, as base for delta-coded MsgId. Not updated by shm-data events.
+}
+
+// LastMsgId returns the MsgId of the last serialized/deserialized event, excluding shm-data events.
+func (codec *HeaderCodec) LastMsgId() uint64 {
+	return codec.lastMsgId
+}
+
 // Event format used by OT nodes.
 const eventMsgHeaderLen = 19 // from OT platform-simulation.h struct Event { }
 type Event struct {
@@ -87,13 +129,18 @@ type Event struct {
 	Timestamp    uint64
 	MustDispatch bool
 	Conn         net.Conn
+	TraceData    []byte // if event tracing is enabled: the event as received, in the default header format.
+	isPooled     bool   // if obtained by NewPooledEvent(), and may be returned by Release().
 
 	// supplementary payload data stored in Event.Data, depends on the event type.
-	RadioCommData  RadioCommEventData
-	RadioStateData RadioStateEventData
-	NodeInfoData   NodeInfoEventData
-	RfSimParamData RfSimParamEventData
-	MsgToHostData  MsgToHostEventData
+	RadioCommData       RadioCommEventData
+	RadioStateData      RadioStateEventData
+	RadioStateSleepData RadioStateSleepEventData
+	NodeInfoData        NodeInfoEventData
+	RfSimParamData      RfSimParamEventData
+	MsgToHostData       MsgToHostEventData
+	TrelData            TrelEventData
+	RadioEnergyData     RadioEnergyEventData
 }
 
 // All ...EventData formats below only used by OT nodes supporting advanced
@@ -117,9 +164,67 @@ type RadioStateEventData struct {
 	RadioTime   uint64
 }
 
+// Fields flags of RadioStateSleepEventData, from OT-RFSIM platform event-sim.h.
+const (
+	RadioStateFieldChannel     uint8 = 1 << 0
+	RadioStateFieldPowerDbm    uint8 = 1 << 1
+	RadioStateFieldRxSensDbm   uint8 = 1 << 2
+	RadioStateFieldEnergyState uint8 = 1 << 3
+	RadioStateFieldSubState    uint8 = 1 << 4
+	RadioStateFieldState       uint8 = 1 << 5
+	RadioStateFieldWakeups     uint8 = 1 << 6 // a wake-up list is included
+	RadioStateFieldReport      uint8 = 1 << 7 // a radio-state report is included
+)
+
+const radioStateSleepEventDataHeaderLen = 1 // from OT-RFSIM platform, otSimSendRadioStateSleepEvent()
+const radioStateSleepEventDataReportLen = 16
+
+// RadioStateSleepEventData is the data of a combined radio-state and sleep event. It contains a radio-state
+// report only if the RadioStateFieldReport flag is set, and then only the fields that changed since the
+// previous report.
+type RadioStateSleepEventData struct {
+	Fields          uint8
+	RadioStateDelay uint64 // delay until next radio-state change, like the Delay of a radio-state event.
+	RadioStateData  RadioStateEventData
+	Wakeups         []SleepWakeup // all future wake-up deadlines, if the RadioStateFieldWakeups flag is set.
+}
+
+// Wake-up sources and flags of SleepWakeup, from OT-RFSIM platform event-sim.h.
+const (
+	WakeupSourceAlarmMilli uint8 = 0
+	WakeupSourceAlarmMicro uint8 = 1
+	WakeupSourceRadio      uint8 = 2
+	WakeupSourceBle        uint8 = 3
+
+	WakeupFlagUnconditional uint8 = 1 << 0
+)
+
+const sleepWakeupDataLen = 10 // from OT-RFSIM platform, event-sim.h struct SleepWakeupData
+
+// SleepWakeup is a wake-up deadline of a sleeping node. An unconditional deadline requires the node to be woken
+// at that time, while a conditional one is handled by the node at its next wake-up for another reason.
+type SleepWakeup struct {
+	Source uint8
+	Flags  uint8
+	Delay  uint64 // us delay until the deadline, from the time of the sleep event.
+}
+
+const radioEnergyEventDataHeaderLen = 33 // from OT-RFSIM platform, event-sim.h struct RadioEnergyEventData
+
+// RadioEnergyEventData is the data of a radio energy report. It contains the time (us) spent per energy-state
+// since the previous report, and the current energy-state of the radio.
+type RadioEnergyEventData struct {
+	EnergyState types.RadioStates
+	DisabledUs  uint64
+	SleepUs     uint64
+	RxUs        uint64
+	TxUs        uint64
+}
+
 const nodeInfoEventDataHeaderLen = 4 // from OT-RFSIM platform, otSimSendNodeInfoEvent()
 type NodeInfoEventData struct {
-	NodeId types.NodeId
+	NodeId  types.NodeId
+	ShmName string // name of shared-memory region offered by the node, or "" if none.
 }
 
 const rfSimParamEventDataHeaderLen = 5 // from OT-RFSIM platform
@@ -136,6 +241,21 @@ type MsgToHostEventData struct {
 	DstIp6Address netip.Addr
 }
 
+// Flags of TrelEventData, from OT-RFSIM platform event-sim.h.
+const (
+	TrelFlagRemoved uint8 = 1 << 0 // the TREL service (or peer) is removed.
+)
+
+const trelEventDataHeaderLen = 3 // from OT-RFSIM platform, event-sim.h struct TrelEventData
+
+// TrelEventData is the data of TREL service, peer and data events. Port is the UDP port of the service (or peer)
+// for service/peer events; for data events, it is the destination port when sent by a node, and the source port
+// when delivered to a node.
+type TrelEventData struct {
+	Port  uint16
+	Flags uint8
+}
+
 /*
 RadioMessagePsduOffset is the offset of mPsdu data in a received OpenThread RadioMessage,
 from OT-RFSIM platform, radio.h.
@@ -149,9 +269,21 @@ from OT-RFSIM platform, radio.h.
 const RadioMessagePsduOffset = 1
 
 // Serialize serializes this Event into []byte to send to OpenThread node,
-// including fields partially.
+// including fields partially. It uses the default header format.
 func (e *Event) Serialize() []byte {
+	return e.SerializeWith(&HeaderCodec{})
+}
+
+// SerializeWith serializes this Event like Serialize, using the header format and state of codec.
+func (e *Event) SerializeWith(codec *HeaderCodec) []byte {
+	return e.SerializeTo(make([]byte, 0, eventMsgHeaderLen+msgToHostEventDataHeaderLen+len(e.Data)), codec)
+}
+
+// SerializeTo serializes this Event like SerializeWith, appending it to msg. It returns the extended msg.
+// This allows the caller to reuse a buffer for serializing events.
+func (e *Event) SerializeTo(msg []byte, codec *HeaderCodec) []byte {
 	// Detect composite event types for which struct data is serialized.
+	var extraFieldsBuf [msgToHostEventDataHeaderLen]byte
 	var extraFields []byte
 	switch e.Type {
 	case EventTypeRadioChannelSample:
@@ -161,54 +293,131 @@ func (e *Event) Serialize() []byte {
 	case EventTypeRadioTxDone:
 		fallthrough
 	case EventTypeRadioCommStart:
-		extraFields = []byte{e.RadioCommData.Channel, byte(e.RadioCommData.PowerDbm), e.RadioCommData.Error,
-			0, 0, 0, 0, 0, 0, 0, 0}
+		extraFields = extraFieldsBuf[:radioCommEventDataHeaderLen]
+		extraFields[0] = e.RadioCommData.Channel
+		extraFields[1] = byte(e.RadioCommData.PowerDbm)
+		extraFields[2] = e.RadioCommData.Error
 		binary.LittleEndian.PutUint64(extraFields[3:], e.RadioCommData.Duration)
 	case EventTypeRadioRfSimParamSet:
 		fallthrough
 	case EventTypeRadioRfSimParamGet:
-		extraFields = []byte{byte(e.RfSimParamData.Param), 0, 0, 0, 0}
+		extraFields = extraFieldsBuf[:rfSimParamEventDataHeaderLen]
+		extraFields[0] = byte(e.RfSimParamData.Param)
 		binary.LittleEndian.PutUint32(extraFields[1:], uint32(e.RfSimParamData.Value))
 	case EventTypeUdpFromHost,
 		EventTypeIp6FromHost:
-		extraFields = make([]byte, msgToHostEventDataHeaderLen)
+		extraFields = extraFieldsBuf[:msgToHostEventDataHeaderLen]
 		binary.LittleEndian.PutUint16(extraFields[0:2], e.MsgToHostData.SrcPort)
 		binary.LittleEndian.PutUint16(extraFields[2:4], e.MsgToHostData.DstPort)
 		copy(extraFields[4:20], e.MsgToHostData.SrcIp6Address.AsSlice())
 		copy(extraFields[20:36], e.MsgToHostData.DstIp6Address.AsSlice())
+	case EventTypeTrelPeer,
+		EventTypeTrelData:
+		extraFields = extraFieldsBuf[:trelEventDataHeaderLen]
+		binary.LittleEndian.PutUint16(extraFields[0:2], e.TrelData.Port)
+		extraFields[2] = e.TrelData.Flags
 	default:
 		break
 	}
 
-	payload := append(extraFields, e.Data...)
-	msg := make([]byte, eventMsgHeaderLen+len(payload))
-	binary.LittleEndian.PutUint64(msg[:8], e.Delay) // e.Timestamp is not sent, only e.Delay.
-	msg[8] = e.Type
-	binary.LittleEndian.PutUint64(msg[9:17], e.MsgId)
-	binary.LittleEndian.PutUint16(msg[17:19], uint16(len(payload)))
-	n := copy(msg[eventMsgHeaderLen:], payload)
-	logger.AssertTrue(n == len(payload))
+	payloadLen := len(extraFields) + len(e.Data)
+	msg = codec.appendHeader(msg, e, payloadLen)
+	msg = append(msg, extraFields...)
+	msg = append(msg, e.Data...)
 
 	return msg
 }
 
+func (codec *HeaderCodec) appendHeader(msg []byte, e *Event, payloadLen int) []byte {
+	msgIdDelta := int64(e.MsgId - codec.lastMsgId)
+	if e.Type != EventTypeShmData {
+		codec.lastMsgId = e.MsgId
+	}
+
+	var hdr [eventMsgHeaderCompactMaxLen]byte
+	var n int
+	if codec.Format == HeaderFormatCompact {
+		n = binary.PutUvarint(hdr[:], e.Delay)
+		hdr[n] = e.Type
+		n++
+		n += binary.PutVarint(hdr[n:], msgIdDelta) // zigzag-encoded
+		n += binary.PutUvarint(hdr[n:], uint64(payloadLen))
+	} else {
+		binary.LittleEndian.PutUint64(hdr[:8], e.Delay) // e.Timestamp is not sent, only e.Delay.
+		hdr[8] = e.Type
+		binary.LittleEndian.PutUint64(hdr[9:17], e.MsgId)
+		binary.LittleEndian.PutUint16(hdr[17:19], uint16(payloadLen))
+		n = eventMsgHeaderLen
+	}
+	return append(msg, hdr[:n]...)
+}
+
+// parseHeader parses the event header at the start of data into e. It returns the header length and
+// the payload data length, or a header length of 0 if data doesn't contain an entire header.
+// The codec state isn't updated.
+func (codec *HeaderCodec) parseHeader(data []byte, e *Event) (int, int) {
+	if codec.Format == HeaderFormatCompact {
+		delay, n1 := binary.Uvarint(data)
+		if n1 <= 0 || n1 >= len(data) {
+			logger.AssertTrue(n1 >= 0, "invalid varint in event header")
+			return 0, 0
+		}
+		evType := data[n1]
+		msgIdDelta, n2 := binary.Varint(data[n1+1:])
+		if n2 <= 0 {
+			logger.AssertTrue(n2 == 0, "invalid varint in event header")
+			return 0, 0
+		}
+		datalen, n3 := binary.Uvarint(data[n1+1+n2:])
+		if n3 <= 0 {
+			logger.AssertTrue(n3 == 0, "invalid varint in event header")
+			return 0, 0
+		}
+		e.Delay = delay
+		e.Type = evType
+		e.MsgId = codec.lastMsgId + uint64(msgIdDelta)
+		return n1 + 1 + n2 + n3, int(datalen)
+	}
+
+	if len(data) < eventMsgHeaderLen {
+		return 0, 0
+	}
+	e.Delay = binary.LittleEndian.Uint64(data[:8])
+	e.Type = data[8]
+	e.MsgId = binary.LittleEndian.Uint64(data[9:17])
+	return eventMsgHeaderLen, int(binary.LittleEndian.Uint16(data[17:19]))
+}
+
+// ToDefaultFormat returns a copy of the serialized event at the start of data, which was deserialized into e
+// with this codec, that uses the default header format instead. It must be called before any header format
+// change by e. This is used for recording event traces that are independent of the negotiated format.
+func (codec *HeaderCodec) ToDefaultFormat(data []byte, e *Event) []byte {
+	var hdr Event
+	headerLen, n := (&HeaderCodec{Format: codec.Format}).parseHeader(data, &hdr)
+	logger.AssertTrue(headerLen > 0 && headerLen+n <= len(data))
+	msg := (&HeaderCodec{}).appendHeader(make([]byte, 0, eventMsgHeaderLen+n), e, n)
+	return append(msg, data[headerLen:headerLen+n]...)
+}
+
 // Deserialize deserializes []byte Event fields (as received from OpenThread node) into the Event object e.
 // It returns the number of bytes used from `data` for the Deserialize operation, or 0 if the data buffer
-// is incomplete i.e. does not contain one entire serialized Event.
+// is incomplete i.e. does not contain one entire serialized Event. It uses the default header format.
 func (e *Event) Deserialize(data []byte) int {
-	n := len(data)
-	if n < eventMsgHeaderLen {
+	return e.DeserializeWith(data, &HeaderCodec{})
+}
+
+// DeserializeWith deserializes like Deserialize, using the header format and state of codec.
+func (e *Event) DeserializeWith(data []byte, codec *HeaderCodec) int {
+	headerLen, n := codec.parseHeader(data, e)
+	if headerLen == 0 || n > len(data)-headerLen {
 		return 0
 	}
-	e.Delay = binary.LittleEndian.Uint64(data[:8])
-	e.Type = data[8]
-	e.MsgId = binary.LittleEndian.Uint64(data[9:17])
-	datalen := binary.LittleEndian.Uint16(data[17:19])
+	datalen := uint16(n)
 	var payloadOffset uint16 = 0
-	if datalen > uint16(n-eventMsgHeaderLen) {
-		return 0
+	e.Data = data[headerLen : headerLen+n]
+	if e.Type != EventTypeShmData {
+		codec.lastMsgId = e.MsgId
 	}
-	e.Data = data[eventMsgHeaderLen : eventMsgHeaderLen+datalen]
 
 	// Detect composite event types
 	switch e.Type {
@@ -224,6 +433,10 @@ func (e *Event) Deserialize(data []byte) int {
 	case EventTypeRadioState:
 		e.RadioStateData = deserializeRadioStateData(e.Data)
 		payloadOffset += radioStateEventDataHeaderLen
+	case EventTypeRadioStateSleep:
+		var n int
+		e.RadioStateSleepData, n = deserializeRadioStateSleepData(e.Data)
+		payloadOffset += uint16(n)
 	case EventTypeNodeInfo:
 		e.NodeInfoData = deserializeNodeInfoData(e.Data)
 		payloadOffset += nodeInfoEventDataHeaderLen
@@ -235,6 +448,13 @@ func (e *Event) Deserialize(data []byte) int {
 	case EventTypeIp6ToHost:
 		e.MsgToHostData = deserializeMsgToHostData(e.Data)
 		payloadOffset += msgToHostEventDataHeaderLen
+	case EventTypeTrelService,
+		EventTypeTrelData:
+		e.TrelData = deserializeTrelData(e.Data)
+		payloadOffset += trelEventDataHeaderLen
+	case EventTypeRadioEnergy:
+		e.RadioEnergyData = deserializeRadioEnergyData(e.Data)
+		payloadOffset += radioEnergyEventDataHeaderLen
 	default:
 		break
 	}
@@ -246,7 +466,7 @@ func (e *Event) Deserialize(data []byte) int {
 	// e.Timestamp is not in the event, so set to invalid initially.
 	e.Timestamp = InvalidTimestamp
 
-	return int(eventMsgHeaderLen + datalen)
+	return headerLen + n
 }
 
 func deserializeRadioCommData(data []byte) RadioCommEventData {
@@ -260,6 +480,18 @@ func deserializeRadioCommData(data []byte) RadioCommEventData {
 	return s
 }
 
+func deserializeRadioEnergyData(data []byte) RadioEnergyEventData {
+	logger.AssertTrue(len(data) >= radioEnergyEventDataHeaderLen)
+	s := RadioEnergyEventData{
+		EnergyState: types.RadioStates(data[0]),
+		DisabledUs:  binary.LittleEndian.Uint64(data[1:9]),
+		SleepUs:     binary.LittleEndian.Uint64(data[9:17]),
+		RxUs:        binary.LittleEndian.Uint64(data[17:25]),
+		TxUs:        binary.LittleEndian.Uint64(data[25:33]),
+	}
+	return s
+}
+
 func deserializeRadioStateData(data []byte) RadioStateEventData {
 	logger.AssertTrue(len(data) >= radioStateEventDataHeaderLen)
 	s := RadioStateEventData{
@@ -274,11 +506,95 @@ func deserializeRadioStateData(data []byte) RadioStateEventData {
 	return s
 }
 
+func deserializeRadioStateSleepData(data []byte) (RadioStateSleepEventData, int) {
+	logger.AssertTrue(len(data) >= radioStateSleepEventDataHeaderLen)
+	s := RadioStateSleepEventData{
+		Fields: data[0],
+	}
+	n := radioStateSleepEventDataHeaderLen
+	if s.Fields&RadioStateFieldReport != 0 {
+		n += deserializeRadioStateReport(data[n:], &s)
+	}
+
+	if s.Fields&RadioStateFieldWakeups != 0 {
+		logger.AssertTrue(len(data) > n)
+		num := int(data[n])
+		n++
+		logger.AssertTrue(len(data) >= n+num*sleepWakeupDataLen)
+		s.Wakeups = make([]SleepWakeup, num)
+		for i := range s.Wakeups {
+			s.Wakeups[i] = SleepWakeup{
+				Source: data[n],
+				Flags:  data[n+1],
+				Delay:  binary.LittleEndian.Uint64(data[n+2 : n+10]),
+			}
+			n += sleepWakeupDataLen
+		}
+	}
+	return s, n
+}
+
+// deserializeRadioStateReport deserializes the radio-state report of a combined radio-state and sleep event
+// into s, and returns its length.
+func deserializeRadioStateReport(data []byte, s *RadioStateSleepEventData) int {
+	logger.AssertTrue(len(data) >= radioStateSleepEventDataReportLen)
+	s.RadioStateDelay = binary.LittleEndian.Uint64(data[0:8])
+	s.RadioStateData.RadioTime = binary.LittleEndian.Uint64(data[8:16])
+	n := radioStateSleepEventDataReportLen
+
+	// changed fields follow, one byte each, in order of the flags.
+	var fieldValues [6]uint8
+	for i := range fieldValues {
+		if s.Fields&(1<<i) != 0 {
+			logger.AssertTrue(len(data) > n)
+			fieldValues[i] = data[n]
+			n++
+		}
+	}
+	s.RadioStateData.Channel = fieldValues[0]
+	s.RadioStateData.PowerDbm = int8(fieldValues[1])
+	s.RadioStateData.RxSensDbm = int8(fieldValues[2])
+	s.RadioStateData.EnergyState = types.RadioStates(fieldValues[3])
+	s.RadioStateData.SubState = types.RadioSubStates(fieldValues[4])
+	s.RadioStateData.State = types.RadioStates(fieldValues[5])
+	return n
+}
+
+// ApplyTo updates the radio state with the fields included in this event data.
+func (s *RadioStateSleepEventData) ApplyTo(state *RadioStateEventData) {
+	if s.Fields&RadioStateFieldReport == 0 {
+		return
+	}
+	state.RadioTime = s.RadioStateData.RadioTime
+	if s.Fields&RadioStateFieldChannel != 0 {
+		state.Channel = s.RadioStateData.Channel
+	}
+	if s.Fields&RadioStateFieldPowerDbm != 0 {
+		state.PowerDbm = s.RadioStateData.PowerDbm
+	}
+	if s.Fields&RadioStateFieldRxSensDbm != 0 {
+		state.RxSensDbm = s.RadioStateData.RxSensDbm
+	}
+	if s.Fields&RadioStateFieldEnergyState != 0 {
+		state.EnergyState = s.RadioStateData.EnergyState
+	}
+	if s.Fields&RadioStateFieldSubState != 0 {
+		state.SubState = s.RadioStateData.SubState
+	}
+	if s.Fields&RadioStateFieldState != 0 {
+		state.State = s.RadioStateData.State
+	}
+}
+
 func deserializeNodeInfoData(data []byte) NodeInfoEventData {
 	logger.AssertTrue(len(data) >= nodeInfoEventDataHeaderLen)
 	s := NodeInfoEventData{
 		NodeId: types.NodeId(binary.LittleEndian.Uint32(data[0:4])),
 	}
+	// optional NUL-terminated name of offered shared-memory region follows.
+	if name, _, found := strings.Cut(string(data[nodeInfoEventDataHeaderLen:]), "\x00"); found {
+		s.ShmName = name
+	}
 	return s
 }
 
@@ -307,12 +623,45 @@ func deserializeMsgToHostData(data []byte) MsgToHostEventData {
 	return s
 }
 
-// Copy creates a (struct) copy of the Event.
+func deserializeTrelData(data []byte) TrelEventData {
+	logger.AssertTrue(len(data) >= trelEventDataHeaderLen)
+	s := TrelEventData{
+		Port:  binary.LittleEndian.Uint16(data[0:2]),
+		Flags: data[2],
+	}
+	return s
+}
+
+// Copy creates a (struct) copy of the Event. The copy is never a pooled Event.
 func (e *Event) Copy() Event {
 	newEv := *e
+	newEv.isPooled = false
 	return newEv
 }
 
+var eventPool = sync.Pool{
+	New: func() interface{} {
+		return &Event{}
+	},
+}
+
+// NewPooledEvent gets a zero Event from a pool of reusable Events. The owner must call Release() on the
+// Event once it's no longer used, to return it to the pool.
+func NewPooledEvent() *Event {
+	e := eventPool.Get().(*Event)
+	e.isPooled = true
+	return e
+}
+
+// Release returns the Event to the pool, if it was obtained by NewPooledEvent(); otherwise, it does nothing.
+// The Event must not be used anymore after this. The Data slice is not reused, so may be kept by others.
+func (e *Event) Release() {
+	if e.isPooled {
+		*e = Event{}
+		eventPool.Put(e)
+	}
+}
+
 func (e *Event) String() string {
 	paylStr := ""
 	if len(e.Data) > 0 {
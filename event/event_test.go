@@ -54,6 +54,96 @@ func TestSerializeAlarmEvent(t *testing.T) {
 	assert.True(t, data[1] == 0xd1)
 }
 
+func TestSerializeCompactHeader(t *testing.T) {
+	codec := &HeaderCodec{Format: HeaderFormatCompact}
+	ev := &Event{Delay: 4626, Type: EventTypeAlarmFired, MsgId: 1}
+	assert.Equal(t, "9224000200", hex.EncodeToString(ev.SerializeWith(codec)))
+
+	ev = &Event{Delay: 0, Type: EventTypeUartWrite, MsgId: 2, Data: []byte{0x41, 0x42}}
+	assert.Equal(t, "000202024142", hex.EncodeToString(ev.SerializeWith(codec)))
+
+	// shm-data events don't change the MsgId base.
+	ev = &Event{Type: EventTypeShmData, MsgId: 2, Data: []byte{1, 0, 0, 0}}
+	assert.Equal(t, "0019000401000000", hex.EncodeToString(ev.SerializeWith(codec)))
+	assert.Equal(t, uint64(2), codec.LastMsgId())
+
+	ev = &Event{Delay: 10, Type: EventTypeAlarmFired, MsgId: 1}
+	assert.Equal(t, "0a000100", hex.EncodeToString(ev.SerializeWith(codec))) // MsgId delta -1
+}
+
+func TestDeserializeCompactHeader(t *testing.T) {
+	codec := &HeaderCodec{Format: HeaderFormatCompact}
+	data, _ := hex.DecodeString("92240002000002020241420a000100")
+	var ev Event
+
+	// incomplete events aren't deserialized, and don't change the MsgId base.
+	for i := 0; i < 5; i++ {
+		assert.Equal(t, 0, ev.DeserializeWith(data[:i], codec))
+	}
+	assert.Equal(t, 0, ev.DeserializeWith(data[5:10], codec))
+	assert.Equal(t, uint64(0), codec.LastMsgId())
+
+	n := ev.DeserializeWith(data, codec)
+	assert.Equal(t, 5, n)
+	assert.Equal(t, uint64(4626), ev.Delay)
+	assert.Equal(t, EventTypeAlarmFired, ev.Type)
+	assert.Equal(t, uint64(1), ev.MsgId)
+
+	data = data[n:]
+	n = ev.DeserializeWith(data, codec)
+	assert.Equal(t, 6, n)
+	assert.Equal(t, EventTypeUartWrite, ev.Type)
+	assert.Equal(t, uint64(2), ev.MsgId)
+	assert.Equal(t, []byte{0x41, 0x42}, ev.Data)
+
+	data = data[n:]
+	n = ev.DeserializeWith(data, codec)
+	assert.Equal(t, 4, n)
+	assert.Equal(t, uint64(10), ev.Delay)
+	assert.Equal(t, uint64(1), ev.MsgId)
+}
+
+func TestCompactHeaderRoundTrip(t *testing.T) {
+	txCodec := &HeaderCodec{Format: HeaderFormatCompact}
+	rxCodec := &HeaderCodec{Format: HeaderFormatCompact}
+	events := []*Event{
+		{Delay: 0, Type: EventTypeAlarmFired, MsgId: 12345678, Data: []byte{}},
+		{Delay: 1<<63 + 5, Type: EventTypeLogWrite, MsgId: 12345678, Data: make([]byte, 300)},
+		{Delay: 1, Type: EventTypeShmData, MsgId: 12345678, Data: []byte{4, 3, 2, 1}},
+		{Delay: 2, Type: EventTypeStatusPush, MsgId: 12345679, Data: []byte("role=4")},
+	}
+	for _, evt := range events {
+		data := evt.SerializeWith(txCodec)
+		var ev Event
+		assert.Equal(t, len(data), ev.DeserializeWith(data, rxCodec))
+		assert.Equal(t, evt.Delay, ev.Delay)
+		assert.Equal(t, evt.Type, ev.Type)
+		assert.Equal(t, evt.MsgId, ev.MsgId)
+		assert.Equal(t, evt.Data, ev.Data)
+	}
+}
+
+func TestToDefaultFormat(t *testing.T) {
+	txCodec := &HeaderCodec{Format: HeaderFormatCompact}
+	rxCodec := &HeaderCodec{Format: HeaderFormatCompact}
+	evt := &Event{Delay: 1234, Type: EventTypeStatusPush, MsgId: 42, Data: []byte("role=4")}
+	var ev Event
+	data := evt.SerializeWith(txCodec) // first event sets the msg-id base
+	assert.Equal(t, len(data), ev.DeserializeWith(data, rxCodec))
+	evt.MsgId = 43
+	data = evt.SerializeWith(txCodec)
+	assert.Equal(t, len(data), ev.DeserializeWith(data, rxCodec))
+	raw := rxCodec.ToDefaultFormat(data, &ev)
+	assert.Equal(t, eventMsgHeaderLen+len(evt.Data), len(raw))
+
+	var ev2 Event
+	assert.Equal(t, len(raw), ev2.Deserialize(raw))
+	assert.Equal(t, evt.Delay, ev2.Delay)
+	assert.Equal(t, evt.Type, ev2.Type)
+	assert.Equal(t, uint64(43), ev2.MsgId)
+	assert.Equal(t, evt.Data, ev2.Data)
+}
+
 func TestDeserializeRadioCommEvent(t *testing.T) {
 	data, _ := hex.DecodeString("040302010000000006040000000000000011000cf6112a000000000000000c1020304050")
 	var ev Event
@@ -115,6 +205,49 @@ func TestDeserializeMultiple(t *testing.T) {
 	assert.Equal(t, 0, n3)
 }
 
+func TestDeserializeRadioStateSleepEvent(t *testing.T) {
+	// no radio-state report
+	data, _ := hex.DecodeString("e8030000000000001c0500000000000000010000")
+	var ev Event
+	n := ev.Deserialize(data)
+	assert.Equal(t, len(data), n)
+	assert.Equal(t, EventTypeRadioStateSleep, ev.Type)
+	assert.Equal(t, uint64(1000), ev.Delay)
+	assert.Equal(t, uint8(0), ev.RadioStateSleepData.Fields)
+	assert.Equal(t, 0, len(ev.Data))
+
+	state := RadioStateEventData{Channel: 11, PowerDbm: 0, SubState: types.RFSIM_RADIO_SUBSTATE_READY, RadioTime: 1}
+	ev.RadioStateSleepData.ApplyTo(&state)
+	assert.Equal(t, uint64(1), state.RadioTime)
+
+	// radio-state report with changed SubState and RxSensDbm
+	data, _ = hex.DecodeString("e8030000000000001c05000000000000001300" + "94" + "2000000000000000" +
+		"3412000000000000" + "9c" + "05")
+	n = ev.Deserialize(data)
+	assert.Equal(t, len(data), n)
+	assert.Equal(t, RadioStateFieldReport|RadioStateFieldSubState|RadioStateFieldRxSensDbm, ev.RadioStateSleepData.Fields)
+	assert.Equal(t, uint64(32), ev.RadioStateSleepData.RadioStateDelay)
+	assert.Equal(t, 0, len(ev.Data))
+
+	ev.RadioStateSleepData.ApplyTo(&state)
+	assert.Equal(t, uint8(11), state.Channel)
+	assert.Equal(t, int8(-100), state.RxSensDbm)
+	assert.Equal(t, types.RFSIM_RADIO_SUBSTATE_TX_TX_TO_RX, state.SubState)
+	assert.Equal(t, uint64(0x1234), state.RadioTime)
+
+	// no radio-state report, with a wake-up list of an ms-alarm and a conditional radio deadline
+	data, _ = hex.DecodeString("e8030000000000001c05000000000000001600" + "4002" + "0001e803000000000000" +
+		"02002000000000000000")
+	n = ev.Deserialize(data)
+	assert.Equal(t, len(data), n)
+	assert.Equal(t, RadioStateFieldWakeups, ev.RadioStateSleepData.Fields)
+	assert.Equal(t, []SleepWakeup{
+		{Source: WakeupSourceAlarmMilli, Flags: WakeupFlagUnconditional, Delay: 1000},
+		{Source: WakeupSourceRadio, Flags: 0, Delay: 32},
+	}, ev.RadioStateSleepData.Wakeups)
+	assert.Equal(t, 0, len(ev.Data))
+}
+
 func TestSerializeRadioCommStartEvent(t *testing.T) {
 	dataExpected, _ := hex.DecodeString("0403020100000000060c0d0e0f00000000100002b01140e20100000000000210203040")
 	rxEvtData := RadioCommEventData{
@@ -189,6 +322,15 @@ func TestDeserializeNodeInfoEvent(t *testing.T) {
 	assert.Equal(t, EventTypeNodeInfo, ev.Type)
 	assert.Equal(t, uint64(254), ev.MsgId)
 	assert.Equal(t, 688257, ev.NodeInfoData.NodeId)
+	assert.Equal(t, "", ev.NodeInfoData.ShmName)
+	assert.Equal(t, len(data), n)
+
+	// with offered shared-memory region name
+	data, _ = hex.DecodeString("00000000000000000c00000000000000000e00020000002f6f746e735f315f3200")
+	n = ev.Deserialize(data)
+	assert.Equal(t, EventTypeNodeInfo, ev.Type)
+	assert.Equal(t, 2, ev.NodeInfoData.NodeId)
+	assert.Equal(t, "/otns_1_2", ev.NodeInfoData.ShmName)
 	assert.Equal(t, len(data), n)
 }
 
@@ -280,6 +422,50 @@ func TestSerializeMsgToHostEvents(t *testing.T) {
 	assert.Equal(t, dataExpected, data)
 }
 
+func TestSerializeDeserializeTrelEvents(t *testing.T) {
+	ev := &Event{
+		Type:     EventTypeTrelData,
+		MsgId:    7,
+		Data:     []byte{0xaa, 0xbb, 0xcc},
+		TrelData: TrelEventData{Port: 9203},
+	}
+	dataExpected, _ := hex.DecodeString("00000000000000002407000000000000000600f32300aabbcc")
+	data := ev.Serialize()
+	assert.Equal(t, dataExpected, data)
+
+	var ev2 Event
+	n := ev2.Deserialize(data)
+	assert.Equal(t, len(data), n)
+	assert.Equal(t, EventTypeTrelData, ev2.Type)
+	assert.Equal(t, uint16(9203), ev2.TrelData.Port)
+	assert.Equal(t, uint8(0), ev2.TrelData.Flags)
+	assert.Equal(t, []byte{0xaa, 0xbb, 0xcc}, ev2.Data)
+
+	// a service removal, as sent by a node, with its TXT data.
+	data, _ = hex.DecodeString("00000000000000002208000000000000000400f4230101")
+	n = ev2.Deserialize(data)
+	assert.Equal(t, len(data), n)
+	assert.Equal(t, EventTypeTrelService, ev2.Type)
+	assert.Equal(t, uint16(9204), ev2.TrelData.Port)
+	assert.Equal(t, TrelFlagRemoved, ev2.TrelData.Flags)
+	assert.Equal(t, []byte{0x01}, ev2.Data)
+}
+
+func TestDeserializeRadioEnergyEvent(t *testing.T) {
+	data, _ := hex.DecodeString("000000000000000027030000000000000021000264000000000000002c010000000000008a02000000000000" +
+		"3200000000000000")
+	var ev Event
+	n := ev.Deserialize(data)
+	assert.Equal(t, len(data), n)
+	assert.Equal(t, EventTypeRadioEnergy, ev.Type)
+	assert.Equal(t, types.RadioRx, ev.RadioEnergyData.EnergyState)
+	assert.Equal(t, uint64(100), ev.RadioEnergyData.DisabledUs)
+	assert.Equal(t, uint64(300), ev.RadioEnergyData.SleepUs)
+	assert.Equal(t, uint64(650), ev.RadioEnergyData.RxUs)
+	assert.Equal(t, uint64(50), ev.RadioEnergyData.TxUs)
+	assert.Equal(t, 0, len(ev.Data))
+}
+
 func TestEventCopy(t *testing.T) {
 	ev := &Event{
 		Type:  EventTypeRadioRxDone,
@@ -304,3 +490,40 @@ func TestEventCopy(t *testing.T) {
 	assert.Equal(t, uint8(types.OT_ERROR_FCS), evCopy.RadioCommData.Error)
 	assert.Equal(t, uint64(11234), evCopy.MsgId)
 }
+
+func TestSerializeToReusedBuffer(t *testing.T) {
+	ev1 := &Event{
+		Type:          EventTypeRadioCommStart,
+		MsgId:         5,
+		Delay:         100,
+		Data:          []byte{11, 0x01, 0x02, 0x03},
+		RadioCommData: RadioCommEventData{Channel: 11, PowerDbm: -20, Duration: 160},
+	}
+	ev2 := &Event{
+		Type:           EventTypeRadioRfSimParamSet,
+		MsgId:          6,
+		RfSimParamData: RfSimParamEventData{Param: types.ParamCslAccuracy, Value: 20},
+	}
+
+	buf := make([]byte, 0, 8)
+	buf = ev1.SerializeTo(buf[:0], &HeaderCodec{})
+	assert.Equal(t, ev1.Serialize(), buf)
+	buf = ev2.SerializeTo(buf[:0], &HeaderCodec{})
+	assert.Equal(t, ev2.Serialize(), buf)
+}
+
+func TestPooledEvent(t *testing.T) {
+	ev := NewPooledEvent()
+	assert.True(t, ev.isPooled)
+	ev.Type = EventTypeAlarmFired
+	ev.Delay = 123
+
+	evCopy := ev.Copy()
+	assert.False(t, evCopy.isPooled)
+	evCopy.Release() // no effect on a non-pooled Event
+	assert.Equal(t, uint64(123), evCopy.Delay)
+
+	ev.Release()
+	assert.Equal(t, uint64(0), ev.Delay)
+	assert.False(t, ev.isPooled)
+}
@@ -153,6 +153,14 @@ func (nl *NodeLogger) SetDisplayLevel(level Level) {
 	nl.displayLevel = level
 }
 
+// MaxLevel returns the highest log level that is either displayed or written to the log file.
+func (nl *NodeLogger) MaxLevel() Level {
+	if nl.isFileEnabled && nl.fileLevel > nl.displayLevel {
+		return nl.fileLevel
+	}
+	return nl.displayLevel
+}
+
 func (nl *NodeLogger) IsLevelVisible(level Level) bool {
 	return nl.displayLevel >= level
 }
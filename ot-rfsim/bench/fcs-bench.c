@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2024, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief
+ *   Micro-benchmark of the FCS computation: the slice-by-8 platformFcsCompute() against the
+ *   byte-wise table lookup that it replaced. It first checks that both produce the same FCS.
+ *
+ *   Usage: fcs-bench [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "fcs.h"
+
+#define FRAME_MAX_SIZE 127
+#define NUM_FRAMES 64
+
+static uint16_t sByteTable[256];
+
+static void initByteTable(void)
+{
+    for (int i = 0; i < 256; i++)
+    {
+        uint16_t crc = (uint16_t)i;
+
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : (crc >> 1);
+        }
+        sByteTable[i] = crc;
+    }
+}
+
+static uint16_t computeFcsByteWise(uint16_t aFcs, const uint8_t *aData, uint16_t aLength)
+{
+    while (aLength-- > 0)
+    {
+        aFcs = (aFcs >> 8) ^ sByteTable[(aFcs ^ *aData++) & 0xff];
+    }
+    return aFcs;
+}
+
+static double nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double runBench(uint16_t (*aFcsFunc)(uint16_t, const uint8_t *, uint16_t),
+                       uint8_t     aFrames[NUM_FRAMES][FRAME_MAX_SIZE],
+                       long        aIterations,
+                       uint16_t   *aSum)
+{
+    double   start = nowNs();
+    uint16_t sum   = 0;
+
+    for (long n = 0; n < aIterations; n++)
+    {
+        for (int i = 0; i < NUM_FRAMES; i++)
+        {
+            sum ^= aFcsFunc(sum, aFrames[i], FRAME_MAX_SIZE);
+        }
+    }
+    *aSum = sum;
+    return (nowNs() - start) / ((double)aIterations * NUM_FRAMES);
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t frames[NUM_FRAMES][FRAME_MAX_SIZE];
+    const uint8_t  check[] = "123456789";
+    long           iterations = (argc > 1) ? atol(argv[1]) : 200000;
+    uint16_t       sumByteWise, sumSliced;
+    double         nsByteWise, nsSliced;
+
+    initByteTable();
+    srand(1);
+    for (int i = 0; i < NUM_FRAMES; i++)
+    {
+        for (int j = 0; j < FRAME_MAX_SIZE; j++)
+        {
+            frames[i][j] = (uint8_t)rand();
+        }
+    }
+
+    // verify the check value of CRC-16/KERMIT, and equality for every frame length and alignment.
+    if (platformFcsCompute(0, check, sizeof(check) - 1) != 0x2189)
+    {
+        fprintf(stderr, "FCS check value mismatch\n");
+        return EXIT_FAILURE;
+    }
+    for (int off = 0; off < 8; off++)
+    {
+        for (int len = 0; len <= FRAME_MAX_SIZE - off; len++)
+        {
+            if (platformFcsCompute(0, &frames[0][off], len) != computeFcsByteWise(0, &frames[0][off], len))
+            {
+                fprintf(stderr, "FCS mismatch at offset %d, length %d\n", off, len);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    nsByteWise = runBench(computeFcsByteWise, frames, iterations, &sumByteWise);
+    nsSliced   = runBench(platformFcsCompute, frames, iterations, &sumSliced);
+    if (sumByteWise != sumSliced)
+    {
+        fprintf(stderr, "FCS mismatch in benchmark\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("FCS of a %d-byte frame, %ld x %d frames\n", FRAME_MAX_SIZE, iterations, NUM_FRAMES);
+    printf("  byte-wise:   %8.1f ns/frame\n", nsByteWise);
+    printf("  slice-by-8:  %8.1f ns/frame  (%.2fx)\n", nsSliced, nsByteWise / nsSliced);
+    return EXIT_SUCCESS;
+}
@@ -124,40 +124,53 @@ void otPlatAlarmMicroStop(otInstance *aInstance)
     sIsUsRunning = false;
 }
 
-uint64_t platformAlarmGetNext(void)
+bool platformAlarmGetNextMilli(uint64_t *aDelay)
 {
-    uint64_t remaining = INT64_MAX;
+    int32_t milli;
 
-    if (sIsMsRunning)
+    if (!sIsMsRunning)
     {
-        int32_t milli = (int32_t)(sMsAlarm - otPlatAlarmMilliGetNow());
-
-        if (milli < 0)
-        {
-            remaining = 0;
-        }
-        else
-        {
-            remaining = (uint64_t)milli;
-            remaining *= US_PER_MS;
-        }
+        return false;
     }
 
+    milli   = (int32_t)(sMsAlarm - otPlatAlarmMilliGetNow());
+    *aDelay = (milli < 0) ? 0 : (uint64_t)milli * US_PER_MS;
+    return true;
+}
+
+bool platformAlarmGetNextMicro(uint64_t *aDelay)
+{
 #if OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
-    if (sIsUsRunning)
-    {
-        int32_t micro = (int32_t)(sUsAlarm - otPlatAlarmMicroGetNow());
+    int32_t micro;
 
-        if (micro < 0)
-        {
-            remaining = 0;
-        }
-        else if (remaining > ((uint64_t)micro))
-        {
-            remaining = (uint64_t)micro;
-        }
+    if (!sIsUsRunning)
+    {
+        return false;
     }
+
+    micro   = (int32_t)(sUsAlarm - otPlatAlarmMicroGetNow());
+    *aDelay = (micro < 0) ? 0 : (uint64_t)micro;
+    return true;
+#else
+    OT_UNUSED_VARIABLE(aDelay);
+    return false;
 #endif
+}
+
+uint64_t platformAlarmGetNext(void)
+{
+    uint64_t remaining = INT64_MAX;
+    uint64_t delay;
+
+    if (platformAlarmGetNextMilli(&delay))
+    {
+        remaining = delay;
+    }
+
+    if (platformAlarmGetNextMicro(&delay) && remaining > delay)
+    {
+        remaining = delay;
+    }
 
     return remaining;
 }
@@ -30,6 +30,7 @@
 
 #include "platform-rfsim.h"
 #include <openthread/platform/ble.h>
+#include <openthread/random_noncrypto.h>
 
 #define OT_BLE_ADV_DELAY_MAX_US 10000
 #define OT_BLE_OCTET_DURATION_US 8
@@ -48,6 +49,7 @@ otError otPlatBleEnable(otInstance *aInstance)
     OT_UNUSED_VARIABLE(aInstance);
     sEnabled = true;
     sNextBleEventTime = UNDEFINED_TIME_US;
+    platformSetProcessHandler(RFSIM_PROCESS_HANDLER_BLE, platformBleProcess);
     return OT_ERROR_NONE;
 }
 
@@ -56,6 +58,7 @@ otError otPlatBleDisable(otInstance *aInstance)
     OT_UNUSED_VARIABLE(aInstance);
     sEnabled = false;
     sAdvertising = false;
+    platformSetProcessHandler(RFSIM_PROCESS_HANDLER_BLE, NULL);
     return OT_ERROR_NONE;
 }
 
@@ -78,7 +81,7 @@ void selectAdvertisementDelay(bool addAdvPeriod) {
     struct RadioStateEventData stateReport;
 
     uint64_t now = platformAlarmGetNow();
-    sAdvDelayUs = rand() % OT_BLE_ADV_DELAY_MAX_US;
+    sAdvDelayUs = otRandomNonCryptoGetUint32InRange(0, OT_BLE_ADV_DELAY_MAX_US);
     if (addAdvPeriod)
         sAdvDelayUs += sAdvPeriodUs;
 
@@ -144,6 +147,19 @@ void sendBleAdvertisement() {
     otSimSendRadioCommEvent(&txData, (const uint8_t *) &aMessage, msgLen + offsetof(struct RadioMessage, mPsdu));
 }
 
+bool platformBleGetNextWakeup(uint64_t *aDelay)
+{
+    uint64_t now = platformAlarmGetNow();
+
+    if (!sEnabled || !sAdvertising || sNextBleEventTime <= now)
+    {
+        return false;
+    }
+
+    *aDelay = sNextBleEventTime - now;
+    return true;
+}
+
 void platformBleProcess(otInstance *aInstance) {
     OT_UNUSED_VARIABLE(aInstance);
     uint64_t now = platformAlarmGetNow();
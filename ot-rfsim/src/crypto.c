@@ -81,3 +81,243 @@ bool otPlatCryptoHasKey(otCryptoKeyRef aKeyRef)
 }
 
 #endif // OPENTHREAD_CONFIG_PLATFORM_KEY_REFERENCES_ENABLE
+
+#if OPENTHREAD_CONFIG_RFSIM_AES_ACCEL_ENABLE && !OPENTHREAD_CONFIG_PLATFORM_KEY_REFERENCES_ENABLE
+
+#include <openthread/platform/crypto.h>
+#include <mbedtls/aes.h>
+
+#include "utils/code_utils.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <wmmintrin.h>
+#define RFSIM_AESNI_SUPPORTED 1
+#else
+#define RFSIM_AESNI_SUPPORTED 0
+#endif
+
+// AES platform API using a cache of expanded key schedules. The OT stack sets the key again for
+// every frame (or other AES-CCM operation), while only few different keys are in use: the previous,
+// current and next MAC key, and the MLE key.
+
+#define AES_KEY_CACHE_SIZE 4
+#define AES_MAX_KEY_SIZE 32
+#define AES128_KEY_SIZE 16
+#define AES128_NUM_ROUND_KEYS 11
+#define AES_BLOCK_SIZE 16
+
+struct AesKeyEntry
+{
+    uint8_t             mKey[AES_MAX_KEY_SIZE];
+    uint16_t            mKeyLength; // 0 if entry is unused.
+    uint32_t            mId;        // changes when the entry gets another key.
+    bool                mIsAesNi;
+    uint8_t             mRoundKeys[AES128_NUM_ROUND_KEYS * AES_BLOCK_SIZE];
+    mbedtls_aes_context mMbedContext;
+};
+
+// stored in the context memory provided by the OT stack.
+struct AesContext
+{
+    struct AesKeyEntry *mEntry;
+    uint32_t            mEntryId;
+    uint16_t            mKeyLength;
+    uint8_t             mKey[AES_MAX_KEY_SIZE];
+};
+
+static struct AesKeyEntry sAesKeyCache[AES_KEY_CACHE_SIZE];
+static uint32_t           sAesKeyCacheNextId   = 1;
+static uint8_t            sAesKeyCacheNextSlot = 0;
+
+#if RFSIM_AESNI_SUPPORTED
+static bool isAesNiSupported(void)
+{
+    static int sIsSupported = -1;
+
+    if (sIsSupported < 0)
+    {
+        __builtin_cpu_init();
+        sIsSupported = __builtin_cpu_supports("aes") ? 1 : 0;
+    }
+    return sIsSupported == 1;
+}
+
+__attribute__((target("aes,sse2"))) static __m128i aesNiExpandStep(__m128i aKey, __m128i aKeyGen)
+{
+    aKeyGen = _mm_shuffle_epi32(aKeyGen, _MM_SHUFFLE(3, 3, 3, 3));
+    aKey    = _mm_xor_si128(aKey, _mm_slli_si128(aKey, 4));
+    aKey    = _mm_xor_si128(aKey, _mm_slli_si128(aKey, 4));
+    aKey    = _mm_xor_si128(aKey, _mm_slli_si128(aKey, 4));
+    return _mm_xor_si128(aKey, aKeyGen);
+}
+
+#define AESNI_EXPAND_ROUND(rk, i, rcon) \
+    rk[i] = aesNiExpandStep(rk[i - 1], _mm_aeskeygenassist_si128(rk[i - 1], rcon))
+
+__attribute__((target("aes,sse2"))) static void aesNiExpandKey(const uint8_t *aKey, uint8_t *aRoundKeys)
+{
+    __m128i rk[AES128_NUM_ROUND_KEYS];
+
+    rk[0] = _mm_loadu_si128((const __m128i *)aKey);
+    AESNI_EXPAND_ROUND(rk, 1, 0x01);
+    AESNI_EXPAND_ROUND(rk, 2, 0x02);
+    AESNI_EXPAND_ROUND(rk, 3, 0x04);
+    AESNI_EXPAND_ROUND(rk, 4, 0x08);
+    AESNI_EXPAND_ROUND(rk, 5, 0x10);
+    AESNI_EXPAND_ROUND(rk, 6, 0x20);
+    AESNI_EXPAND_ROUND(rk, 7, 0x40);
+    AESNI_EXPAND_ROUND(rk, 8, 0x80);
+    AESNI_EXPAND_ROUND(rk, 9, 0x1b);
+    AESNI_EXPAND_ROUND(rk, 10, 0x36);
+
+    for (int i = 0; i < AES128_NUM_ROUND_KEYS; i++)
+    {
+        _mm_storeu_si128((__m128i *)&aRoundKeys[i * AES_BLOCK_SIZE], rk[i]);
+    }
+}
+
+__attribute__((target("aes,sse2"))) static void aesNiEncrypt(const uint8_t *aRoundKeys,
+                                                             const uint8_t *aInput,
+                                                             uint8_t       *aOutput)
+{
+    __m128i block = _mm_loadu_si128((const __m128i *)aInput);
+
+    block = _mm_xor_si128(block, _mm_loadu_si128((const __m128i *)&aRoundKeys[0]));
+    for (int i = 1; i < AES128_NUM_ROUND_KEYS - 1; i++)
+    {
+        block = _mm_aesenc_si128(block, _mm_loadu_si128((const __m128i *)&aRoundKeys[i * AES_BLOCK_SIZE]));
+    }
+    block = _mm_aesenclast_si128(
+        block, _mm_loadu_si128((const __m128i *)&aRoundKeys[(AES128_NUM_ROUND_KEYS - 1) * AES_BLOCK_SIZE]));
+    _mm_storeu_si128((__m128i *)aOutput, block);
+}
+#endif // RFSIM_AESNI_SUPPORTED
+
+// returns the cache entry for the key, expanding the key into a (round-robin) replaced entry if needed.
+static struct AesKeyEntry *getAesKeyEntry(const uint8_t *aKey, uint16_t aKeyLength)
+{
+    struct AesKeyEntry *entry;
+
+    for (int i = 0; i < AES_KEY_CACHE_SIZE; i++)
+    {
+        entry = &sAesKeyCache[i];
+        if (entry->mKeyLength == aKeyLength && memcmp(entry->mKey, aKey, aKeyLength) == 0)
+        {
+            return entry;
+        }
+    }
+
+    entry = &sAesKeyCache[sAesKeyCacheNextSlot];
+    sAesKeyCacheNextSlot = (sAesKeyCacheNextSlot + 1) % AES_KEY_CACHE_SIZE;
+
+    if (entry->mKeyLength > 0 && !entry->mIsAesNi)
+    {
+        mbedtls_aes_free(&entry->mMbedContext);
+    }
+    entry->mKeyLength = 0;
+    entry->mId        = sAesKeyCacheNextId++;
+    entry->mIsAesNi   = false;
+
+#if RFSIM_AESNI_SUPPORTED
+    if (aKeyLength == AES128_KEY_SIZE && isAesNiSupported())
+    {
+        aesNiExpandKey(aKey, entry->mRoundKeys);
+        entry->mIsAesNi = true;
+    }
+#endif
+    if (!entry->mIsAesNi)
+    {
+        mbedtls_aes_init(&entry->mMbedContext);
+        if (mbedtls_aes_setkey_enc(&entry->mMbedContext, aKey, aKeyLength * 8) != 0)
+        {
+            mbedtls_aes_free(&entry->mMbedContext);
+            return NULL;
+        }
+    }
+
+    memcpy(entry->mKey, aKey, aKeyLength);
+    entry->mKeyLength = aKeyLength;
+    return entry;
+}
+
+otError otPlatCryptoAesInit(otCryptoContext *aContext)
+{
+    otError error = OT_ERROR_NONE;
+
+    otEXPECT_ACTION(aContext != NULL, error = OT_ERROR_INVALID_ARGS);
+    otEXPECT_ACTION(aContext->mContextSize >= sizeof(struct AesContext), error = OT_ERROR_FAILED);
+    memset(aContext->mContext, 0, sizeof(struct AesContext));
+
+exit:
+    return error;
+}
+
+otError otPlatCryptoAesSetKey(otCryptoContext *aContext, const otCryptoKey *aKey)
+{
+    otError            error = OT_ERROR_NONE;
+    struct AesContext *context;
+
+    otEXPECT_ACTION(aContext != NULL && aKey != NULL && aKey->mKey != NULL, error = OT_ERROR_INVALID_ARGS);
+    otEXPECT_ACTION(aKey->mKeyLength <= AES_MAX_KEY_SIZE, error = OT_ERROR_INVALID_ARGS);
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_CRYPTO_CALLS, 1);
+    context = (struct AesContext *)aContext->mContext;
+
+    context->mEntry = getAesKeyEntry(aKey->mKey, aKey->mKeyLength);
+    otEXPECT_ACTION(context->mEntry != NULL, error = OT_ERROR_FAILED);
+    context->mEntryId   = context->mEntry->mId;
+    context->mKeyLength = aKey->mKeyLength;
+    memcpy(context->mKey, aKey->mKey, aKey->mKeyLength);
+
+exit:
+    return error;
+}
+
+otError otPlatCryptoAesEncrypt(otCryptoContext *aContext, const uint8_t *aInput, uint8_t *aOutput)
+{
+    otError             error = OT_ERROR_NONE;
+    struct AesContext  *context;
+    struct AesKeyEntry *entry;
+
+    otEXPECT_ACTION(aContext != NULL, error = OT_ERROR_INVALID_ARGS);
+    context = (struct AesContext *)aContext->mContext;
+    otEXPECT_ACTION(context->mEntry != NULL, error = OT_ERROR_INVALID_STATE);
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_CRYPTO_CALLS, 1);
+
+    // the cache entry may have been replaced by other keys since the key was set.
+    if (context->mEntry->mId != context->mEntryId)
+    {
+        context->mEntry = getAesKeyEntry(context->mKey, context->mKeyLength);
+        otEXPECT_ACTION(context->mEntry != NULL, error = OT_ERROR_FAILED);
+        context->mEntryId = context->mEntry->mId;
+    }
+    entry = context->mEntry;
+
+#if RFSIM_AESNI_SUPPORTED
+    if (entry->mIsAesNi)
+    {
+        aesNiEncrypt(entry->mRoundKeys, aInput, aOutput);
+    }
+    else
+#endif
+    {
+        otEXPECT_ACTION(mbedtls_aes_crypt_ecb(&entry->mMbedContext, MBEDTLS_AES_ENCRYPT, aInput, aOutput) == 0,
+                        error = OT_ERROR_FAILED);
+    }
+
+exit:
+    return error;
+}
+
+otError otPlatCryptoAesFree(otCryptoContext *aContext)
+{
+    otError error = OT_ERROR_NONE;
+
+    otEXPECT_ACTION(aContext != NULL, error = OT_ERROR_INVALID_ARGS);
+    // the key schedule stays in the cache, for use by next operations with the same key.
+    memset(aContext->mContext, 0, sizeof(struct AesContext));
+
+exit:
+    return error;
+}
+
+#endif // OPENTHREAD_CONFIG_RFSIM_AES_ACCEL_ENABLE && !OPENTHREAD_CONFIG_PLATFORM_KEY_REFERENCES_ENABLE
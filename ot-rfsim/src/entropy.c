@@ -45,43 +45,132 @@
 #define __SANITIZE_ADDRESS__ 0
 #endif
 
+#define URANDOM_POOL_SIZE 512
+
 static uint32_t sRandomSeed = 0;
-static uint32_t sState = 1;
+static uint64_t sState[4]; // xoshiro256** state
+
+// pool of bytes read from /dev/urandom, used when no random seed is set.
+static int     sUrandomFd = -1;
+static uint8_t sUrandomPool[URANDOM_POOL_SIZE];
+static size_t  sUrandomPoolOffset = URANDOM_POOL_SIZE;
+
+static uint64_t splitMix64(uint64_t *aState) {
+    uint64_t z = (*aState += 0x9e3779b97f4a7c15ULL);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t aValue, int aShift) {
+    return (aValue << aShift) | (aValue >> (64 - aShift));
+}
+
+// xoshiro256** generator, see https://prng.di.unimi.it/ - deterministic and fast, not for crypto use.
+static uint64_t randomUint64Get(void) {
+    uint64_t result = rotl(sState[1] * 5, 7) * 9;
+    uint64_t t      = sState[1] << 17;
+
+    sState[2] ^= sState[0];
+    sState[3] ^= sState[1];
+    sState[1] ^= sState[2];
+    sState[0] ^= sState[3];
+    sState[2] ^= t;
+    sState[3] = rotl(sState[3], 45);
+
+    return result;
+}
+
+static void randomFill(uint8_t *aOutput, uint16_t aOutputLength) {
+    uint64_t word;
+
+    while (aOutputLength >= sizeof(word)) {
+        word = randomUint64Get();
+        memcpy(aOutput, &word, sizeof(word));
+        aOutput += sizeof(word);
+        aOutputLength -= sizeof(word);
+    }
+    if (aOutputLength > 0) {
+        word = randomUint64Get();
+        memcpy(aOutput, &word, aOutputLength);
+    }
+}
 
 void platformRandomInit(int32_t randomSeed) {
+    uint64_t seed;
+
     sRandomSeed = randomSeed;
+    seed = (uint32_t) randomSeed;
 
 #if __SANITIZE_ADDRESS__ != 0
 
     // Multiplying gNodeId assures that no two nodes gets the same seed within an
     // hour.
-    sState = (uint32_t)time(NULL) + (3600 * gNodeId);
+    if (randomSeed == 0)
+        seed = (uint32_t)time(NULL) + (3600 * gNodeId);
 
 #endif // __SANITIZE_ADDRESS__
 
-    if (randomSeed != 0)
-        sState = randomSeed;
+    // each node gets its own stream, derived from the seed and its node ID.
+    seed = (seed << 32) ^ gNodeId;
+    for (int i = 0; i < 4; i++) {
+        sState[i] = splitMix64(&seed);
+    }
 }
 
-static uint32_t randomUint32Get(void) {
-    uint32_t mlcg, p, q;
-    uint64_t tmpstate;
+#if __SANITIZE_ADDRESS__ == 0
+static otError urandomRead(uint8_t *aOutput, size_t aLength) {
+    otError error = OT_ERROR_NONE;
+    ssize_t rval;
+
+    if (sUrandomFd < 0) {
+        sUrandomFd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+        otEXPECT_ACTION(sUrandomFd >= 0, error = OT_ERROR_FAILED);
+    }
+
+    while (aLength > 0) {
+        rval = read(sUrandomFd, aOutput, aLength);
+        if (rval < 0 && errno == EINTR)
+            continue;
+        otEXPECT_ACTION(rval > 0, error = OT_ERROR_FAILED);
+        aOutput += rval;
+        aLength -= rval;
+    }
+
+    exit:
+    return error;
+}
 
-    tmpstate = (uint64_t) 33614 * (uint64_t) sState;
-    q = tmpstate & 0xffffffff;
-    q = q >> 1;
-    p = tmpstate >> 32;
-    mlcg = p + q;
+static otError urandomGet(uint8_t *aOutput, uint16_t aOutputLength) {
+    otError error = OT_ERROR_NONE;
+    size_t  len;
 
-    if (mlcg & 0x80000000) {
-        mlcg &= 0x7fffffff;
-        mlcg++;
+    // large requests are read directly, others are served from the pool.
+    if (aOutputLength > URANDOM_POOL_SIZE / 2) {
+        return urandomRead(aOutput, aOutputLength);
     }
 
-    sState = mlcg;
+    while (aOutputLength > 0) {
+        if (sUrandomPoolOffset == URANDOM_POOL_SIZE) {
+            otEXPECT_ACTION(urandomRead(sUrandomPool, URANDOM_POOL_SIZE) == OT_ERROR_NONE, error = OT_ERROR_FAILED);
+            sUrandomPoolOffset = 0;
+        }
+        len = URANDOM_POOL_SIZE - sUrandomPoolOffset;
+        if (len > aOutputLength)
+            len = aOutputLength;
+        memcpy(aOutput, &sUrandomPool[sUrandomPoolOffset], len);
+        // used bytes are cleared, so that these do not stay around in memory.
+        memset(&sUrandomPool[sUrandomPoolOffset], 0, len);
+        sUrandomPoolOffset += len;
+        aOutput += len;
+        aOutputLength -= len;
+    }
 
-    return mlcg;
+    exit:
+    return error;
 }
+#endif // __SANITIZE_ADDRESS__ == 0
 
 // override the OT WEAK definition - NOTE insecure crypto, for simulation only.
 otError otPlatCryptoRandomGet(uint8_t *aBuffer, uint16_t aSize) {
@@ -91,29 +180,16 @@ otError otPlatCryptoRandomGet(uint8_t *aBuffer, uint16_t aSize) {
 otError otPlatEntropyGet(uint8_t *aOutput, uint16_t aOutputLength) {
     otError error = OT_ERROR_NONE;
 
-#if __SANITIZE_ADDRESS__ == 0
-
-    FILE *file = NULL;
-    size_t readLength;
-
     otEXPECT_ACTION(aOutput && aOutputLength, error = OT_ERROR_INVALID_ARGS);
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_ENTROPY_CALLS, 1);
+
+#if __SANITIZE_ADDRESS__ == 0
 
     // if an init random seed is set, we fall back to predictable pseudo-random.
     if (sRandomSeed != 0) {
-        for (uint16_t length = 0; length < aOutputLength; length++) {
-            aOutput[length] = (uint8_t) randomUint32Get();
-        }
+        randomFill(aOutput, aOutputLength);
     } else {
-        file = fopen("/dev/urandom", "rb");
-        otEXPECT_ACTION(file != NULL, error = OT_ERROR_FAILED);
-
-        readLength = fread(aOutput, 1, aOutputLength, file);
-        otEXPECT_ACTION(readLength == aOutputLength, error = OT_ERROR_FAILED);
-    }
-    exit:
-
-    if (file != NULL) {
-        fclose(file);
+        error = urandomGet(aOutput, aOutputLength);
     }
 
 #else // __SANITIZE_ADDRESS__
@@ -126,15 +202,10 @@ otError otPlatEntropyGet(uint8_t *aOutput, uint16_t aOutputLength) {
      * implementation below is only used to enable continuous
      * integration checks with Address Sanitizer enabled.
      */
-    otEXPECT_ACTION(aOutput && aOutputLength, error = OT_ERROR_INVALID_ARGS);
-
-    for (uint16_t length = 0; length < aOutputLength; length++) {
-      aOutput[length] = (uint8_t)randomUint32Get();
-    }
-
-  exit:
+    randomFill(aOutput, aOutputLength);
 
 #endif // __SANITIZE_ADDRESS__
 
+    exit:
     return error;
 }
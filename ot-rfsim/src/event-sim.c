@@ -37,174 +37,562 @@
 #include "platform-rfsim.h"
 #include "event-sim.h"
 
+#define PAYLOAD_SEGMENTS(X) (X), (sizeof(X) / sizeof(struct iovec))
+
 // socket communication parameters for events
 extern int      gSockFd;
 
-struct Event gLastSentEvent;
+struct EventHeader gLastSentEvent;
+
+// outgoing events are buffered, and sent in one write(), until the node goes to sleep.
+static uint8_t sEventTxBuf[OT_EVENT_TX_BUFFER_SIZE];
+static size_t  sEventTxBufLen = 0;
+
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+// number of bytes written into the shared-memory ring, not yet announced to the simulator.
+static uint32_t sShmTxPendingLen = 0;
+#endif
+
+// last radio state reported to the simulator, and whether the combined radio-state and sleep event is used.
+static struct RadioStateEventData sLastStateReport;
+static bool                       sIsRadioStateSleepAccepted = false;
+static bool                       sIsSleepWakeupsAccepted    = false;
+
+// header format of the events sent, and msg-id delta base for the compact header format.
+static uint8_t  sTxHeaderFormat = OT_EVENT_HEADER_FORMAT_DEFAULT;
+static uint64_t sTxMsgIdBase    = 0;
+
+static void queueEvent(const uint8_t      *aHeader,
+                       size_t              aHeaderLen,
+                       size_t              aDataLen,
+                       const struct iovec *aPayload,
+                       size_t              aPayloadCount);
+static void writeEventTxBuf(void);
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+static void queueShmDataEvent(void);
+#endif
 
 void otSimSendSleepEvent(void)
 {
     OT_ASSERT(platformAlarmGetNext() > 0);
-    struct Event event;
-
-    event.mDelay      = platformAlarmGetNext();
-    event.mEvent      = OT_SIM_EVENT_ALARM_FIRED;
-    event.mDataLength = 0;
 
-    otSimSendEvent(&event);
+    // pending UART output and log lines must precede the sleep event, after which the simulator considers the
+    // node done and may advance its time.
+    platformUartFlush();
+    platformLoggingFlush();
+    otSimSendEvent(OT_SIM_EVENT_ALARM_FIRED, platformAlarmGetNext(), NULL, 0);
+    otSimFlushEvents();
 }
 
 void otSimSendRadioCommEvent(struct RadioCommEventData *aEventData, const uint8_t *aPayload, size_t aLenPayload)
 {
-    OT_ASSERT(aLenPayload <= OT_EVENT_DATA_MAX_SIZE);
-    struct Event event;
+    OT_ASSERT(aLenPayload <= OT_EVENT_DATA_MAX_SIZE - sizeof(struct RadioCommEventData));
+    const struct iovec payload[] = {
+        {aEventData, sizeof(struct RadioCommEventData)},
+        {(void *)aPayload, aLenPayload},
+    };
 
-    event.mEvent = OT_SIM_EVENT_RADIO_COMM_START;
-    memcpy(event.mData, aEventData, sizeof(struct RadioCommEventData));
-    memcpy(event.mData + sizeof(struct RadioCommEventData), aPayload, aLenPayload);
-    event.mDataLength = sizeof(struct RadioCommEventData) + aLenPayload;
-
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_RADIO_COMM_START, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendRadioCommInterferenceEvent(struct RadioCommEventData *aEventData)
 {
-    struct Event event;
-
-    event.mEvent = OT_SIM_EVENT_RADIO_COMM_START;
-    memcpy(event.mData, aEventData, sizeof(struct RadioCommEventData));
-    event.mData[sizeof(struct RadioCommEventData)] = aEventData->mChannel; // channel is stored twice TODO
-    event.mDataLength = sizeof(struct RadioCommEventData) + 1;
+    const struct iovec payload[] = {
+        {aEventData, sizeof(struct RadioCommEventData)},
+        {&aEventData->mChannel, sizeof(aEventData->mChannel)}, // channel is stored twice TODO
+    };
 
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_RADIO_COMM_START, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendRadioChanSampleEvent(struct RadioCommEventData *aChanData)
 {
-    struct Event event;
+    const struct iovec payload[] = {
+        {aChanData, sizeof(struct RadioCommEventData)},
+    };
 
-    event.mEvent = OT_SIM_EVENT_RADIO_CHAN_SAMPLE;
-    event.mDelay = 0;
-    memcpy(event.mData, aChanData, sizeof(struct RadioCommEventData));
-    event.mDataLength = sizeof(struct RadioCommEventData);
-
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_RADIO_CHAN_SAMPLE, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendRadioStateEvent(struct RadioStateEventData *aStateData, uint64_t aDeltaUntilNextRadioState)
 {
-    struct Event event;
+    const struct iovec payload[] = {
+        {aStateData, sizeof(struct RadioStateEventData)},
+    };
+
+    sLastStateReport = *aStateData;
+    otSimSendEvent(OT_SIM_EVENT_RADIO_STATE, aDeltaUntilNextRadioState, PAYLOAD_SEGMENTS(payload));
+}
+
+static void addWakeup(struct SleepWakeupData *aWakeups, uint8_t *aNum, uint8_t aSource, bool aIsUnconditional,
+                      uint64_t aDelay)
+{
+    aWakeups[*aNum].mSource = aSource;
+    aWakeups[*aNum].mFlags  = aIsUnconditional ? OT_SIM_WAKEUP_FLAG_UNCONDITIONAL : 0;
+    aWakeups[*aNum].mDelay  = aDelay;
+    (*aNum)++;
+}
+
+// collects the future wake-up deadlines of all wake-up sources of the node. Returns the number of deadlines.
+static uint8_t getSleepWakeups(struct SleepWakeupData *aWakeups)
+{
+    uint8_t  num = 0;
+    uint64_t delay;
+    bool     isUnconditional;
+
+    if (platformAlarmGetNextMilli(&delay))
+    {
+        addWakeup(aWakeups, &num, OT_SIM_WAKEUP_ALARM_MILLI, true, delay);
+    }
+    if (platformAlarmGetNextMicro(&delay))
+    {
+        addWakeup(aWakeups, &num, OT_SIM_WAKEUP_ALARM_MICRO, true, delay);
+    }
+    if (platformRadioGetNextWakeup(&delay, &isUnconditional))
+    {
+        addWakeup(aWakeups, &num, OT_SIM_WAKEUP_RADIO, isUnconditional, delay);
+    }
+#if OPENTHREAD_CONFIG_BLE_TCAT_ENABLE
+    if (platformBleGetNextWakeup(&delay))
+    {
+        addWakeup(aWakeups, &num, OT_SIM_WAKEUP_BLE, true, delay);
+    }
+#endif
+    return num;
+}
+
+void otSimSendRadioStateSleepEvent(struct RadioStateEventData *aStateData, uint64_t aDeltaUntilNextRadioState)
+{
+    uint8_t                fields = 0;
+    uint8_t                changed[6];
+    size_t                 numChanged = 0;
+    uint64_t               radioTime  = 0;
+    struct SleepWakeupData wakeups[OT_SIM_WAKEUP_MAX_NUM];
+    uint8_t                numWakeups = 0;
+
+    OT_ASSERT(platformAlarmGetNext() > 0);
+
+    if (!sIsRadioStateSleepAccepted)
+    {
+        if (aStateData != NULL)
+        {
+            otSimSendRadioStateEvent(aStateData, aDeltaUntilNextRadioState);
+        }
+        otSimSendSleepEvent();
+        return;
+    }
+
+    if (aStateData != NULL)
+    {
+        // field values in order of the OT_RADIO_STATE_FIELD_* flags.
+        const uint8_t current[] = {
+            aStateData->mChannel,     (uint8_t)aStateData->mTxPower, (uint8_t)aStateData->mRxSensitivity,
+            aStateData->mEnergyState, aStateData->mSubState,         aStateData->mState,
+        };
+        const uint8_t last[] = {
+            sLastStateReport.mChannel,     (uint8_t)sLastStateReport.mTxPower, (uint8_t)sLastStateReport.mRxSensitivity,
+            sLastStateReport.mEnergyState, sLastStateReport.mSubState,         sLastStateReport.mState,
+        };
+
+        fields = OT_RADIO_STATE_FIELD_REPORT;
+        for (size_t i = 0; i < sizeof(current); i++)
+        {
+            if (current[i] != last[i])
+            {
+                fields |= (1 << i);
+                changed[numChanged++] = current[i];
+            }
+        }
+        radioTime        = aStateData->mRadioTime;
+        sLastStateReport = *aStateData;
+    }
+
+    if (sIsSleepWakeupsAccepted)
+    {
+        fields |= OT_RADIO_STATE_FIELD_WAKEUPS;
+        numWakeups = getSleepWakeups(wakeups);
+    }
+
+    const struct iovec payload[] = {
+        {&fields, sizeof(uint8_t)},
+        {&aDeltaUntilNextRadioState, (aStateData != NULL) ? sizeof(uint64_t) : 0},
+        {&radioTime, (aStateData != NULL) ? sizeof(uint64_t) : 0},
+        {changed, numChanged},
+        {&numWakeups, sIsSleepWakeupsAccepted ? sizeof(uint8_t) : 0},
+        {wakeups, numWakeups * sizeof(struct SleepWakeupData)},
+    };
+
+    // pending UART output and log lines must precede the sleep event, see otSimSendSleepEvent().
+    platformUartFlush();
+    platformLoggingFlush();
+    otSimSendEvent(OT_SIM_EVENT_RADIO_STATE_SLEEP, platformAlarmGetNext(), PAYLOAD_SEGMENTS(payload));
+    otSimFlushEvents();
+}
+
+void otSimSendRadioStateSleepOfferEvent(void)
+{
+    otSimSendEvent(OT_SIM_EVENT_RADIO_STATE_SLEEP_OFFER, 0, NULL, 0);
+}
+
+void otSimRadioStateSleepAccepted(void)
+{
+    sIsRadioStateSleepAccepted = true;
+}
+
+void otSimSendSleepWakeupsOfferEvent(void)
+{
+    otSimSendEvent(OT_SIM_EVENT_SLEEP_WAKEUPS_OFFER, 0, NULL, 0);
+}
 
-    event.mEvent = OT_SIM_EVENT_RADIO_STATE;
-    event.mDelay = aDeltaUntilNextRadioState;
-    memcpy(event.mData, aStateData, sizeof(struct RadioStateEventData));
-    event.mDataLength = sizeof(struct RadioStateEventData);
+void otSimSleepWakeupsAccepted(void)
+{
+    sIsSleepWakeupsAccepted = true;
+}
 
-    otSimSendEvent(&event);
+void otSimSendRadioEnergyOfferEvent(void)
+{
+    otSimSendEvent(OT_SIM_EVENT_RADIO_ENERGY_OFFER, 0, NULL, 0);
+}
+
+void otSimSendRadioEnergyEvent(struct RadioEnergyEventData *aEnergyData)
+{
+    const struct iovec payload[] = {
+        {aEnergyData, sizeof(struct RadioEnergyEventData)},
+    };
+
+    otSimSendEvent(OT_SIM_EVENT_RADIO_ENERGY, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendUartWriteEvent(const uint8_t *aData, uint16_t aLength) {
     OT_ASSERT(aLength <= OT_EVENT_DATA_MAX_SIZE);
-    struct Event event;
-
-    event.mEvent      = OT_SIM_EVENT_UART_WRITE;
-    event.mDelay      = 0;
-    event.mDataLength = aLength;
-    memcpy(event.mData, aData, aLength);
+    const struct iovec payload[] = {
+        {(void *)aData, aLength},
+    };
 
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_UART_WRITE, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendLogWriteEvent(const uint8_t *aData, uint16_t aLength) {
     OT_ASSERT(aLength <= OT_EVENT_DATA_MAX_SIZE);
+    const struct iovec payload[] = {
+        {(void *)aData, aLength},
+    };
 
-    struct Event event;
-    event.mEvent      = OT_SIM_EVENT_LOG_WRITE;
-    event.mDelay      = 0;
-    event.mDataLength = aLength;
-    memcpy(event.mData, aData, aLength);
-
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_LOG_WRITE, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendOtnsStatusPushEvent(const char *aStatus, uint16_t aLength) {
     OT_ASSERT(aLength <= OT_EVENT_DATA_MAX_SIZE);
-    struct Event event;
-
-    memcpy(event.mData, aStatus, aLength);
-    event.mEvent      = OT_SIM_EVENT_OTNS_STATUS_PUSH;
-    event.mDelay      = 0;
-    event.mDataLength = aLength;
+    const struct iovec payload[] = {
+        {(void *)aStatus, aLength},
+    };
 
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_OTNS_STATUS_PUSH, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendExtAddrEvent(const otExtAddress *aExtAddress) {
     OT_ASSERT(aExtAddress != NULL);
-    struct Event event;
+    const struct iovec payload[] = {
+        {(void *)aExtAddress, sizeof(otExtAddress)},
+    };
 
-    memcpy(event.mData, aExtAddress, sizeof(otExtAddress));
-    event.mEvent      = OT_SIM_EVENT_EXT_ADDR;
-    event.mDelay      = 0;
-    event.mDataLength = sizeof(otExtAddress);
-
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_EXT_ADDR, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendNodeInfoEvent(uint32_t nodeId) {
-    struct Event event;
     OT_ASSERT(nodeId > 0);
+    const char *shmName = NULL;
+
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    // offer the shared-memory transport, by including its name (with terminating NUL).
+    shmName = platformShmGetName();
+#endif
+    const struct iovec payload[] = {
+        {&nodeId, sizeof(uint32_t)},
+        {(void *)shmName, (shmName != NULL) ? strlen(shmName) + 1 : 0},
+    };
+
+    otSimSendEvent(OT_SIM_EVENT_NODE_INFO, 0, PAYLOAD_SEGMENTS(payload));
+}
 
-    memcpy(event.mData, &nodeId, sizeof(uint32_t));
-    event.mEvent      = OT_SIM_EVENT_NODE_INFO;
-    event.mDelay      = 0;
-    event.mDataLength = sizeof(uint32_t);
+void otSimSendHeaderFormatOfferEvent(uint8_t aFormat) {
+    const struct iovec payload[] = {
+        {&aFormat, sizeof(uint8_t)},
+    };
 
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_HEADER_FORMAT_OFFER, 0, PAYLOAD_SEGMENTS(payload));
 }
 
-void otSimSendRfSimParamRespEvent(uint8_t param, int32_t value) {
-    struct Event event;
+void otSimSetEventHeaderFormat(uint8_t aFormat)
+{
+    const struct iovec payload[] = {
+        {&aFormat, sizeof(uint8_t)},
+    };
+
+    OT_ASSERT(aFormat == OT_EVENT_HEADER_FORMAT_DEFAULT || aFormat == OT_EVENT_HEADER_FORMAT_COMPACT);
+    if (aFormat == sTxHeaderFormat)
+        return;
 
-    event.mData[0] = param;
-    memcpy(event.mData + 1, &value, sizeof(int32_t));
-    event.mEvent      = OT_SIM_EVENT_RFSIM_PARAM_RSP;
-    event.mDelay      = 0;
-    event.mDataLength = sizeof(int32_t) + 1;
+    // the format-change event itself, and the announcement of ring data up to it, still use the old format.
+    otSimSendEvent(OT_SIM_EVENT_HEADER_FORMAT, 0, PAYLOAD_SEGMENTS(payload));
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    queueShmDataEvent();
+#endif
+    sTxHeaderFormat = aFormat;
+}
+
+void otSimSendRfSimParamRespEvent(uint8_t param, int32_t value) {
+    const struct iovec payload[] = {
+        {&param, sizeof(uint8_t)},
+        {&value, sizeof(int32_t)},
+    };
 
-    otSimSendEvent(&event);
+    otSimSendEvent(OT_SIM_EVENT_RFSIM_PARAM_RSP, 0, PAYLOAD_SEGMENTS(payload));
 }
 
 void otSimSendMsgToHostEvent(uint8_t evType, struct MsgToHostEventData *aEventData, uint8_t *aMsgBytes, size_t aMsgLen) {
     const size_t evDataSz = sizeof(struct MsgToHostEventData);
-    struct Event event;
     OT_ASSERT(aMsgLen <= OT_EVENT_DATA_MAX_SIZE - evDataSz);
+    const struct iovec payload[] = {
+        {aEventData, evDataSz},
+        {aMsgBytes, aMsgLen},
+    };
+
+    otSimSendEvent(evType, 0, PAYLOAD_SEGMENTS(payload));
+}
 
-    event.mEvent = evType;
-    event.mDelay = 0;
-    memcpy(event.mData, aEventData, evDataSz);
-    memcpy(event.mData + evDataSz, aMsgBytes, aMsgLen);
-    event.mDataLength = evDataSz + aMsgLen;
+void otSimSendTrelEvent(uint8_t aEvType, struct TrelEventData *aEventData, const uint8_t *aData, size_t aDataLen) {
+    const size_t evDataSz = sizeof(struct TrelEventData);
+    OT_ASSERT(aDataLen <= OT_EVENT_DATA_MAX_SIZE - evDataSz);
+    const struct iovec payload[] = {
+        {aEventData, evDataSz},
+        {(void *)aData, aDataLen},
+    };
 
-    otSimSendEvent(&event);
+    otSimSendEvent(aEvType, 0, PAYLOAD_SEGMENTS(payload));
 }
 
-void otSimSendEvent(struct Event *aEvent)
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+// queues an SHM_DATA event on the socket, which announces the events pending in the ring.
+static void queueShmDataEvent(void)
 {
-    ssize_t rval;
+    struct EventHeader header;
+    uint8_t            headerBuf[OT_EVENT_HEADER_MAX_SIZE];
+    size_t             headerLen;
+    uint32_t           shmDataLen = sShmTxPendingLen;
+    const struct iovec payload[] = {
+        {&shmDataLen, sizeof(uint32_t)},
+    };
+
+    if (shmDataLen == 0)
+        return;
 
-    aEvent->mMsgId = gLastMsgId;
-    gLastSentEvent = *aEvent;
+    sShmTxPendingLen   = 0;
+    header.mDelay      = 0;
+    header.mEvent      = OT_SIM_EVENT_SHM_DATA;
+    header.mMsgId      = gLastMsgId;
+    header.mDataLength = sizeof(uint32_t);
+    headerLen          = otSimEncodeEventHeader(sTxHeaderFormat, &header, &sTxMsgIdBase, headerBuf);
+    queueEvent(headerBuf, headerLen, header.mDataLength, PAYLOAD_SEGMENTS(payload));
+}
+#endif
+
+void otSimSendEvent(uint8_t aEventType, uint64_t aDelay, const struct iovec *aPayload, size_t aPayloadCount)
+{
+    struct EventHeader header;
+    uint8_t            headerBuf[OT_EVENT_HEADER_MAX_SIZE];
+    size_t             headerLen;
+    uint64_t           msgIdBase = sTxMsgIdBase;
+    size_t             dataLen = 0;
+    size_t             i;
+
+    for (i = 0; i < aPayloadCount; i++)
+    {
+        dataLen += aPayload[i].iov_len;
+    }
+    OT_ASSERT(dataLen <= OT_EVENT_DATA_MAX_SIZE);
+
+    header.mDelay      = aDelay;
+    header.mEvent      = aEventType;
+    header.mMsgId      = gLastMsgId;
+    header.mDataLength = (uint16_t)dataLen;
+    gLastSentEvent     = header;
 
     if (gSockFd == 0)   // don't send events if socket invalid.
         return;
 
-    // send header and data.
-    rval = write(gSockFd, aEvent, offsetof(struct Event, mData) + aEvent->mDataLength);
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_TX_EVENTS, 1);
+
+    // the msg-id base is only updated once the event is queued: an SHM_DATA event may have to go first.
+    headerLen = otSimEncodeEventHeader(sTxHeaderFormat, &header, &msgIdBase, headerBuf);
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_TX_BYTES, headerLen + dataLen);
+
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    if (platformShmIsActive())
+    {
+        // events are put in the ring, unless socket-buffered events have to go first.
+        if (sEventTxBufLen == 0 && platformShmWriteEvent(headerBuf, headerLen, aPayload, aPayloadCount))
+        {
+            sShmTxPendingLen += headerLen + dataLen;
+            sTxMsgIdBase = msgIdBase;
+            return;
+        }
+        queueShmDataEvent();
+    }
+#endif
+
+    sTxMsgIdBase = msgIdBase;
+    queueEvent(headerBuf, headerLen, dataLen, aPayload, aPayloadCount);
+}
+
+static void queueEvent(const uint8_t      *aHeader,
+                       size_t              aHeaderLen,
+                       size_t              aDataLen,
+                       const struct iovec *aPayload,
+                       size_t              aPayloadCount)
+{
+    // write buffered events first, if the new event doesn't fit anymore. Only the socket buffer is written here:
+    // flushing UART output or log lines would queue their events ahead of the event being queued.
+    if (sEventTxBufLen + aHeaderLen + aDataLen > sizeof(sEventTxBuf))
+    {
+        writeEventTxBuf();
+    }
+
+    // queue header and payload segments, directly from the sources.
+    memcpy(sEventTxBuf + sEventTxBufLen, aHeader, aHeaderLen);
+    sEventTxBufLen += aHeaderLen;
+    for (size_t i = 0; i < aPayloadCount; i++)
+    {
+        memcpy(sEventTxBuf + sEventTxBufLen, aPayload[i].iov_base, aPayload[i].iov_len);
+        sEventTxBufLen += aPayload[i].iov_len;
+    }
+}
+
+static size_t putUvarint(uint8_t *aBuf, uint64_t aValue)
+{
+    size_t len = 0;
+
+    while (aValue >= 0x80)
+    {
+        aBuf[len++] = (uint8_t)(aValue | 0x80);
+        aValue >>= 7;
+    }
+    aBuf[len++] = (uint8_t)aValue;
+    return len;
+}
+
+// returns the length of the varint at aBuf, or 0 if it is incomplete.
+static size_t getUvarint(const uint8_t *aBuf, size_t aLen, uint64_t *aValue)
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < aLen && i < 10; i++)
+    {
+        value |= (uint64_t)(aBuf[i] & 0x7f) << (7 * i);
+        if ((aBuf[i] & 0x80) == 0)
+        {
+            *aValue = value;
+            return i + 1;
+        }
+    }
+    OT_ASSERT(aLen < 10 && "invalid varint in event header");
+    return 0;
+}
+
+size_t otSimEncodeEventHeader(uint8_t aFormat, const struct EventHeader *aHeader, uint64_t *aMsgIdBase, uint8_t *aBuf)
+{
+    size_t  len;
+    int64_t msgIdDelta = (int64_t)(aHeader->mMsgId - *aMsgIdBase);
+
+    // SHM_DATA events are not part of the msg-id sequence of the stream.
+    if (aHeader->mEvent != OT_SIM_EVENT_SHM_DATA)
+    {
+        *aMsgIdBase = aHeader->mMsgId;
+    }
+
+    if (aFormat == OT_EVENT_HEADER_FORMAT_DEFAULT)
+    {
+        memcpy(aBuf, aHeader, sizeof(struct EventHeader));
+        return sizeof(struct EventHeader);
+    }
+
+    len = putUvarint(aBuf, aHeader->mDelay);
+    aBuf[len++] = aHeader->mEvent;
+    len += putUvarint(aBuf + len, ((uint64_t)msgIdDelta << 1) ^ (uint64_t)(msgIdDelta >> 63)); // zigzag
+    len += putUvarint(aBuf + len, aHeader->mDataLength);
+    return len;
+}
+
+size_t otSimDecodeEventHeader(uint8_t             aFormat,
+                              const uint8_t      *aBuf,
+                              size_t              aLen,
+                              uint64_t            aMsgIdBase,
+                              struct EventHeader *aHeader)
+{
+    size_t   len = 0;
+    size_t   n;
+    uint64_t value;
+
+    if (aFormat == OT_EVENT_HEADER_FORMAT_DEFAULT)
+    {
+        if (aLen < sizeof(struct EventHeader))
+            return 0;
+        memcpy(aHeader, aBuf, sizeof(struct EventHeader));
+        return sizeof(struct EventHeader);
+    }
+
+    if ((n = getUvarint(aBuf, aLen, &value)) == 0)
+        return 0;
+    aHeader->mDelay = value;
+    len += n;
+
+    if (len >= aLen)
+        return 0;
+    aHeader->mEvent = aBuf[len++];
+
+    if ((n = getUvarint(aBuf + len, aLen - len, &value)) == 0)
+        return 0;
+    aHeader->mMsgId = aMsgIdBase + (uint64_t)((int64_t)(value >> 1) ^ -(int64_t)(value & 1)); // zigzag
+    len += n;
+
+    if ((n = getUvarint(aBuf + len, aLen - len, &value)) == 0)
+        return 0;
+    OT_ASSERT(value <= OT_EVENT_DATA_MAX_SIZE);
+    aHeader->mDataLength = (uint16_t)value;
+    len += n;
+
+    return len;
+}
+
+void otSimFlushEvents(void)
+{
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    queueShmDataEvent();
+#endif
+    writeEventTxBuf();
+}
+
+static void writeEventTxBuf(void)
+{
+    ssize_t rval;
+    size_t  offset = 0;
+
+    if (gSockFd == 0 || sEventTxBufLen == 0)
+        return;
 
-    if (rval < 0)
+    while (offset < sEventTxBufLen)
     {
-        perror("write");
-        platformExit(EXIT_FAILURE);
+        rval = write(gSockFd, sEventTxBuf + offset, sEventTxBufLen - offset);
+        RFSIM_PROFILE_ADD(RFSIM_PROFILE_TX_SYSCALLS, 1);
+        if (rval < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            sEventTxBufLen = 0;
+            perror("write");
+            platformExit(EXIT_FAILURE);
+        }
+        offset += rval;
     }
+    sEventTxBufLen = 0;
 }
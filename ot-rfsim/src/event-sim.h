@@ -46,52 +46,90 @@
  */
 enum
 {
-    OT_SIM_EVENT_ALARM_FIRED         = 0,
-    OT_SIM_EVENT_RADIO_RECEIVED      = 1, // legacy
-    OT_SIM_EVENT_UART_WRITE          = 2,
-    OT_SIM_EVENT_RADIO_SPINEL_WRITE  = 3, // not used?
-    OT_SIM_EVENT_POSTCMD             = 4, // not used?
-    OT_SIM_EVENT_OTNS_STATUS_PUSH    = 5,
-    OT_SIM_EVENT_RADIO_COMM_START    = 6,
-    OT_SIM_EVENT_RADIO_TX_DONE       = 7,
-    OT_SIM_EVENT_RADIO_CHAN_SAMPLE   = 8,
-    OT_SIM_EVENT_RADIO_STATE         = 9,
-    OT_SIM_EVENT_RADIO_RX_DONE       = 10,
-    OT_SIM_EVENT_EXT_ADDR            = 11,
-    OT_SIM_EVENT_NODE_INFO           = 12,
-    OT_SIM_EVENT_NODE_DISCONNECTED   = 14, // not used on OT node side
-    OT_SIM_EVENT_RADIO_LOG           = 15, // not used on OT node side
-    OT_SIM_EVENT_RFSIM_PARAM_GET     = 16,
-    OT_SIM_EVENT_RFSIM_PARAM_SET     = 17,
-    OT_SIM_EVENT_RFSIM_PARAM_RSP     = 18,
-    OT_SIM_EVENT_LOG_WRITE           = 19,
-    OT_SIM_EVENT_UDP_TO_HOST         = 20,
-    OT_SIM_EVENT_IP6_TO_HOST         = 21,
-    OT_SIM_EVENT_UDP_FROM_HOST       = 22,
-    OT_SIM_EVENT_IP6_FROM_HOST       = 23,
+    OT_SIM_EVENT_ALARM_FIRED              = 0,
+    OT_SIM_EVENT_RADIO_RECEIVED           = 1, // legacy
+    OT_SIM_EVENT_UART_WRITE               = 2,
+    OT_SIM_EVENT_RADIO_SPINEL_WRITE       = 3, // not used?
+    OT_SIM_EVENT_POSTCMD                  = 4, // not used?
+    OT_SIM_EVENT_OTNS_STATUS_PUSH         = 5,
+    OT_SIM_EVENT_RADIO_COMM_START         = 6,
+    OT_SIM_EVENT_RADIO_TX_DONE            = 7,
+    OT_SIM_EVENT_RADIO_CHAN_SAMPLE        = 8,
+    OT_SIM_EVENT_RADIO_STATE              = 9,
+    OT_SIM_EVENT_RADIO_RX_DONE            = 10,
+    OT_SIM_EVENT_EXT_ADDR                 = 11,
+    OT_SIM_EVENT_NODE_INFO                = 12,
+    OT_SIM_EVENT_NODE_DISCONNECTED        = 14, // not used on OT node side
+    OT_SIM_EVENT_RADIO_LOG                = 15, // not used on OT node side
+    OT_SIM_EVENT_RFSIM_PARAM_GET          = 16,
+    OT_SIM_EVENT_RFSIM_PARAM_SET          = 17,
+    OT_SIM_EVENT_RFSIM_PARAM_RSP          = 18,
+    OT_SIM_EVENT_LOG_WRITE                = 19,
+    OT_SIM_EVENT_UDP_TO_HOST              = 20,
+    OT_SIM_EVENT_IP6_TO_HOST              = 21,
+    OT_SIM_EVENT_UDP_FROM_HOST            = 22,
+    OT_SIM_EVENT_IP6_FROM_HOST            = 23,
+    OT_SIM_EVENT_SHM_ACCEPT               = 24,
+    OT_SIM_EVENT_SHM_DATA                 = 25,
+    OT_SIM_EVENT_HEADER_FORMAT_OFFER      = 26,
+    OT_SIM_EVENT_HEADER_FORMAT            = 27,
+    OT_SIM_EVENT_RADIO_STATE_SLEEP        = 28,
+    OT_SIM_EVENT_RADIO_STATE_SLEEP_OFFER  = 29,
+    OT_SIM_EVENT_RADIO_STATE_SLEEP_ACCEPT = 30,
+    OT_SIM_EVENT_SLEEP_WAKEUPS_OFFER      = 31,
+    OT_SIM_EVENT_SLEEP_WAKEUPS_ACCEPT     = 32,
+    OT_SIM_EVENT_TREL_BROWSE              = 33,
+    OT_SIM_EVENT_TREL_SERVICE             = 34,
+    OT_SIM_EVENT_TREL_PEER                = 35,
+    OT_SIM_EVENT_TREL_DATA                = 36,
+    OT_SIM_EVENT_RADIO_ENERGY_OFFER       = 37,
+    OT_SIM_EVENT_RADIO_ENERGY_ACCEPT      = 38,
+    OT_SIM_EVENT_RADIO_ENERGY             = 39,
+};
+
+/**
+ * The wire formats of the event header. The default format is the packed struct EventHeader. The compact
+ * format is negotiated: the node offers it, and each side switches by sending an OT_SIM_EVENT_HEADER_FORMAT
+ * event, after which all events it sends use the new format. Compact header fields, in order:
+ *   - mDelay as unsigned LEB128 varint,
+ *   - mEvent as single byte,
+ *   - mMsgId as zigzag-coded signed LEB128 varint, delta to the mMsgId of the previous event (not counting
+ *     OT_SIM_EVENT_SHM_DATA events) in the same direction,
+ *   - mDataLength as unsigned LEB128 varint.
+ */
+enum
+{
+    OT_EVENT_HEADER_FORMAT_DEFAULT = 0,
+    OT_EVENT_HEADER_FORMAT_COMPACT = 1,
 };
 
 #define OT_EVENT_DATA_MAX_SIZE 2048
 
 OT_TOOL_PACKED_BEGIN
 struct EventHeader
-{
-    uint64_t mDelay;
-    uint8_t  mEvent;
-    uint64_t mMsgId;
-    uint16_t mDataLength;
-} OT_TOOL_PACKED_END;
-
-OT_TOOL_PACKED_BEGIN
-struct Event
 {
     uint64_t mDelay;      // delay in us before execution of the event
     uint8_t  mEvent;      // event type
     uint64_t mMsgId;      // an ever-increasing event message id
     uint16_t mDataLength; // the actual length of following event payload data
-    uint8_t  mData[OT_EVENT_DATA_MAX_SIZE];
 } OT_TOOL_PACKED_END;
 
+// max size of an encoded compact event header: two 64-bit varints, event type, 16-bit varint.
+#define OT_EVENT_HEADER_COMPACT_MAX_SIZE (10 + 1 + 10 + 3)
+
+// max size of an encoded event header, in any header format.
+#define OT_EVENT_HEADER_MAX_SIZE OT_EVENT_HEADER_COMPACT_MAX_SIZE
+
+// max size of a complete event: header plus payload data.
+#define OT_EVENT_MAX_SIZE (OT_EVENT_HEADER_MAX_SIZE + OT_EVENT_DATA_MAX_SIZE)
+
+#define OT_EVENT_TX_BUFFER_SIZE (8 * OT_EVENT_MAX_SIZE) // outgoing events buffer, fits at least 8 max-size events
+#define OT_EVENT_RX_BUFFER_SIZE (8 * OT_EVENT_MAX_SIZE) // incoming events buffer, fits at least 8 max-size events
+
+#define OT_SHM_MAGIC 0x4f544e53     // "OTNS"
+#define OT_SHM_VERSION 1
+#define OT_SHM_RING_SIZE (64 * 1024) // bytes, MUST be a power of 2
+
 OT_TOOL_PACKED_BEGIN
 struct RadioCommEventData
 {
@@ -113,6 +151,72 @@ struct RadioStateEventData
     uint64_t mRadioTime;     // the radio's time otPlatRadioGetNow()
 } OT_TOOL_PACKED_END;
 
+/**
+ * Energy report of the radio, sent as an OT_SIM_EVENT_RADIO_ENERGY event once the simulator accepted it. It
+ * contains the time spent per energy-state since the previous report, and the current energy-state. The
+ * OT_SIM_EVENT_RADIO_ENERGY_ACCEPT event carries the minimum report interval in us, as a uint64_t.
+ */
+OT_TOOL_PACKED_BEGIN
+struct RadioEnergyEventData
+{
+    uint8_t  mEnergyState; // current energy-state of radio (disabled, sleep, actively Tx, actively Rx)
+    uint64_t mDisabledUs;  // us spent in disabled energy-state since previous report
+    uint64_t mSleepUs;     // us spent in sleep energy-state since previous report
+    uint64_t mRxUs;        // us spent in Rx energy-state since previous report
+    uint64_t mTxUs;        // us spent in Tx energy-state since previous report
+} OT_TOOL_PACKED_END;
+
+/**
+ * Flags of the OT_SIM_EVENT_RADIO_STATE_SLEEP event, which combines a sleep event with an optional
+ * radio-state report. Its payload is a uint8_t with these flags. If OT_RADIO_STATE_FIELD_REPORT is set, it
+ * is followed by the uint64_t delay until the next radio-state change, the uint64_t mRadioTime, and by one
+ * byte for each field of struct RadioStateEventData that changed since the previous report, in order
+ * of the flags. If OT_RADIO_STATE_FIELD_WAKEUPS is set, a wake-up list follows (see struct SleepWakeupData).
+ */
+enum
+{
+    OT_RADIO_STATE_FIELD_CHANNEL        = 1 << 0,
+    OT_RADIO_STATE_FIELD_TX_POWER       = 1 << 1,
+    OT_RADIO_STATE_FIELD_RX_SENSITIVITY = 1 << 2,
+    OT_RADIO_STATE_FIELD_ENERGY_STATE   = 1 << 3,
+    OT_RADIO_STATE_FIELD_SUB_STATE      = 1 << 4,
+    OT_RADIO_STATE_FIELD_STATE          = 1 << 5,
+    OT_RADIO_STATE_FIELD_WAKEUPS        = 1 << 6,
+    OT_RADIO_STATE_FIELD_REPORT         = 1 << 7,
+};
+
+/**
+ * Sources of the wake-up deadlines in the wake-up list of an OT_SIM_EVENT_RADIO_STATE_SLEEP event. The list is
+ * a uint8_t count followed by that many struct SleepWakeupData entries. It lists all future wake-up deadlines of
+ * the node, and replaces the list of the node's previous sleep event.
+ */
+enum
+{
+    OT_SIM_WAKEUP_ALARM_MILLI = 0, // OT millisecond alarm
+    OT_SIM_WAKEUP_ALARM_MICRO = 1, // OT microsecond alarm
+    OT_SIM_WAKEUP_RADIO       = 2, // end of the current radio substate
+    OT_SIM_WAKEUP_BLE         = 3, // next BLE advertisement
+    OT_SIM_WAKEUP_MAX_NUM     = 4,
+};
+
+/**
+ * Flags of a wake-up deadline. An unconditional deadline requires the node to be woken at that time. A
+ * conditional deadline is informative only: it is handled by the node when it wakes up for any other reason,
+ * so the simulator does not wake up the node for it.
+ */
+enum
+{
+    OT_SIM_WAKEUP_FLAG_UNCONDITIONAL = 1 << 0,
+};
+
+OT_TOOL_PACKED_BEGIN
+struct SleepWakeupData
+{
+    uint8_t  mSource; // OT_SIM_WAKEUP_*
+    uint8_t  mFlags;  // OT_SIM_WAKEUP_FLAG_*
+    uint64_t mDelay;  // us delay until the deadline
+} OT_TOOL_PACKED_END;
+
 OT_TOOL_PACKED_BEGIN
 struct RfSimParamEventData
 {
@@ -130,12 +234,109 @@ struct MsgToHostEventData
 } OT_TOOL_PACKED_END;
 
 /**
- * Send a generic simulation event to the simulator. Event fields are
- * updated to the values that were used for sending the event.
+ * TREL events are delivered by the simulator in simulated time: it keeps the registered services for peer
+ * discovery (OT_SIM_EVENT_TREL_BROWSE, _SERVICE, _PEER) and delivers OT_SIM_EVENT_TREL_DATA UDP packets to
+ * the node owning the destination port. Each event carries a struct TrelEventData, followed by the service
+ * TXT data (service, peer) or the UDP payload (data). For data events, mPort is the destination port when
+ * sent by the node, and the source port when received by the node.
+ */
+enum
+{
+    OT_SIM_TREL_FLAG_REMOVED = 1 << 0, // service/peer is removed
+};
+
+OT_TOOL_PACKED_BEGIN
+struct TrelEventData
+{
+    uint16_t mPort;  // UDP port of the service, peer, or data destination/source
+    uint8_t  mFlags; // OT_SIM_TREL_FLAG_*
+} OT_TOOL_PACKED_END;
+
+/**
+ * A single-producer, single-consumer ring in shared memory. mHead and mTail are free-running
+ * byte counters, written only by the producer and consumer respectively. They are placed in
+ * separate cache lines.
+ */
+struct ShmRing
+{
+    uint32_t mHead; // total bytes written by the producer
+    uint8_t  mPad1[60];
+    uint32_t mTail; // total bytes read by the consumer
+    uint8_t  mPad2[60];
+    uint8_t  mData[OT_SHM_RING_SIZE];
+};
+
+/**
+ * The shared-memory region of the optional shared-memory event transport. The node creates it,
+ * and offers it to the simulator in the NODE_INFO event. Events in a ring are announced to the
+ * receiver by an OT_SIM_EVENT_SHM_DATA event on the socket, with the number of ring bytes as payload,
+ * so that the socket stream still defines the order of all events.
+ */
+struct ShmRegion
+{
+    uint32_t       mMagic;    // OT_SHM_MAGIC
+    uint32_t       mVersion;  // OT_SHM_VERSION
+    uint32_t       mRingSize; // OT_SHM_RING_SIZE
+    uint8_t        mPad[52];
+    struct ShmRing mToSimulator;
+    struct ShmRing mToNode;
+};
+
+/**
+ * Send a generic simulation event to the simulator. The payload is passed as a list of
+ * segments, which are copied directly from their source into the outgoing events buffer.
+ * The event is actually sent at the next otSimFlushEvents() call, which happens at
+ * the latest when the node goes to sleep.
+ *
+ * @param[in]   aEventType      The event type (OT_SIM_EVENT_*).
+ * @param[in]   aDelay          Delay (us) before execution of the event.
+ * @param[in]   aPayload        A pointer to the payload segments, or NULL if no payload.
+ * @param[in]   aPayloadCount   Number of payload segments in aPayload.
+ */
+void otSimSendEvent(uint8_t aEventType, uint64_t aDelay, const struct iovec *aPayload, size_t aPayloadCount);
+
+/**
+ * Send all buffered simulation events to the simulator, using a single write. Buffered UART output
+ * and log lines are not included: these are sent with platformUartFlush() and platformLoggingFlush().
+ */
+void otSimFlushEvents(void);
+
+/**
+ * Encode an event header into a buffer, in the given header format.
  *
- * @param[in,out]   aEvent  A pointer to the simulation event to update, and send.
+ * @param[in]     aFormat     The header format (OT_EVENT_HEADER_FORMAT_*).
+ * @param[in]     aHeader     A pointer to the event header to encode.
+ * @param[inout]  aMsgIdBase  A pointer to the msg-id delta base of the stream. It is updated by the call.
+ * @param[out]    aBuf        A pointer to the output buffer, of at least OT_EVENT_HEADER_MAX_SIZE bytes.
+ *
+ * @returns  The number of bytes written to aBuf.
+ */
+size_t otSimEncodeEventHeader(uint8_t aFormat, const struct EventHeader *aHeader, uint64_t *aMsgIdBase, uint8_t *aBuf);
+
+/**
+ * Decode an event header from a buffer, in the given header format.
+ *
+ * @param[in]   aFormat     The header format (OT_EVENT_HEADER_FORMAT_*).
+ * @param[in]   aBuf        A pointer to the received data.
+ * @param[in]   aLen        Number of bytes available in aBuf.
+ * @param[in]   aMsgIdBase  The msg-id delta base of the stream, i.e. the msg-id of the last handled event.
+ * @param[out]  aHeader     A pointer to the decoded event header.
+ *
+ * @returns  The length of the encoded header, or 0 if aBuf doesn't hold a complete header.
+ */
+size_t otSimDecodeEventHeader(uint8_t             aFormat,
+                              const uint8_t      *aBuf,
+                              size_t              aLen,
+                              uint64_t            aMsgIdBase,
+                              struct EventHeader *aHeader);
+
+/**
+ * Select the header format for the events that this node sends from now on. If the format
+ * changes, the simulator is notified by an OT_SIM_EVENT_HEADER_FORMAT event sent in the old format.
+ *
+ * @param[in]   aFormat     The header format (OT_EVENT_HEADER_FORMAT_*).
  */
-void otSimSendEvent(struct Event *aEvent);
+void otSimSetEventHeaderFormat(uint8_t aFormat);
 
 /**
  * Send a sleep event to the simulator. The amount of time to sleep
@@ -144,6 +345,51 @@ void otSimSendEvent(struct Event *aEvent);
  */
 void otSimSendSleepEvent(void);
 
+/**
+ * Send a sleep event to the simulator, combined with a radio-state report that only includes the
+ * fields that changed since the previous report. If the simulator didn't accept this combined event,
+ * a radio-state event and a sleep event are sent instead.
+ *
+ * @param[in]  aStateData                 A pointer to the radio state to report, or NULL if none to report.
+ * @param[in]  aDeltaUntilNextRadioState  Time (us) until next radio-state change event, or UNDEFINED_TIME_US.
+ */
+void otSimSendRadioStateSleepEvent(struct RadioStateEventData *aStateData, uint64_t aDeltaUntilNextRadioState);
+
+/**
+ * Offer the combined radio-state and sleep event to the simulator. A simulator that accepts it
+ * responds with an OT_SIM_EVENT_RADIO_STATE_SLEEP_ACCEPT event.
+ */
+void otSimSendRadioStateSleepOfferEvent(void);
+
+/**
+ * Start using the combined radio-state and sleep event, as accepted by the simulator.
+ */
+void otSimRadioStateSleepAccepted(void);
+
+/**
+ * Offer the wake-up list in the combined radio-state and sleep event to the simulator. A simulator that
+ * accepts it responds with an OT_SIM_EVENT_SLEEP_WAKEUPS_ACCEPT event.
+ */
+void otSimSendSleepWakeupsOfferEvent(void);
+
+/**
+ * Start including the wake-up list in the combined radio-state and sleep event, as accepted by the simulator.
+ */
+void otSimSleepWakeupsAccepted(void);
+
+/**
+ * Offer the radio energy reports to the simulator. A simulator that accepts it responds with an
+ * OT_SIM_EVENT_RADIO_ENERGY_ACCEPT event.
+ */
+void otSimSendRadioEnergyOfferEvent(void);
+
+/**
+ * Sends a radio energy report event to the simulator.
+ *
+ * @param[in]  aEnergyData  A pointer to the energy report data.
+ */
+void otSimSendRadioEnergyEvent(struct RadioEnergyEventData *aEnergyData);
+
 /**
  * Sends a RadioComm (Tx) simulation event to the simulator.
  *
@@ -219,6 +465,14 @@ void otSimSendExtAddrEvent(const otExtAddress *aExtAddress);
  */
 void otSimSendNodeInfoEvent(uint32_t nodeId);
 
+/**
+ * Offer a non-default event header format to the simulator. A simulator that accepts it
+ * responds with an OT_SIM_EVENT_HEADER_FORMAT event.
+ *
+ * @param aFormat  the offered header format (OT_EVENT_HEADER_FORMAT_*)
+ */
+void otSimSendHeaderFormatOfferEvent(uint8_t aFormat);
+
 // TODO
 void otSimSendRfSimParamRespEvent(uint8_t param, int32_t value);
 
@@ -234,4 +488,14 @@ void otSimSendRfSimParamRespEvent(uint8_t param, int32_t value);
  */
 void otSimSendMsgToHostEvent(uint8_t evType, struct MsgToHostEventData *aEventData, uint8_t *aMsgBytes, size_t aMsgLen);
 
+/**
+ * Send a TREL event (OT_SIM_EVENT_TREL_SERVICE or OT_SIM_EVENT_TREL_DATA) to the simulator.
+ *
+ * @param aEvType    the event type to use
+ * @param aEventData the TREL event data
+ * @param aData      the service TXT data, or the TREL UDP payload
+ * @param aDataLen   the length of aData
+ */
+void otSimSendTrelEvent(uint8_t aEvType, struct TrelEventData *aEventData, const uint8_t *aData, size_t aDataLen);
+
 #endif // PLATFORM_RFSIM_EVENT_SIM_H
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2024, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief
+ *   This file includes the IEEE 802.15.4 frame check sequence (FCS) computation. It has no
+ *   OpenThread dependencies, so that it can also be built into the benchmark in ../bench.
+ */
+
+#ifndef PLATFORM_RFSIM_FCS_H
+#define PLATFORM_RFSIM_FCS_H
+
+#include <stdint.h>
+
+/**
+ * Computes the CRC-16 FCS of an IEEE 802.15.4 frame, in little-endian bit order (CRC-16/KERMIT).
+ *
+ * @param[in]  aFcs      The initial FCS value, or the FCS of the preceding data.
+ * @param[in]  aData     A pointer to the data.
+ * @param[in]  aLength   The length of the data in bytes.
+ *
+ * @returns The FCS over the preceding and the given data.
+ */
+uint16_t platformFcsCompute(uint16_t aFcs, const uint8_t *aData, uint16_t aLength);
+
+#endif // PLATFORM_RFSIM_FCS_H
@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -44,14 +45,72 @@
 #include "lib/platform/exit_code.h"
 #include "common/debug.hpp"
 
-static int sFlashFd = -1;
-
 enum
 {
     SWAP_SIZE = 2048,
     SWAP_NUM  = 2,
 };
 
+// Policy for syncing the flash memory to its file, selected by environment variable RFSIM_FLASH_SYNC.
+typedef enum
+{
+    FLASH_SYNC_EXIT,  // "exit": only on exit of the node process (default).
+    FLASH_SYNC_SLEEP, // "sleep": when the node goes to sleep, if written since the last sync.
+    FLASH_SYNC_WRITE, // "write": on each write or erase.
+    FLASH_SYNC_RAM,   // "ram": no file is used; flash contents are lost when the node process exits or resets.
+} FlashSyncMode;
+
+static int           sFlashFd = -1;
+static uint8_t      *sFlash   = NULL; // the flash memory: mapped flash file, or RAM.
+static FlashSyncMode sFlashSyncMode;
+static bool          sFlashIsDirty = false;
+
+static FlashSyncMode parseFlashSyncMode(const char *aMode)
+{
+    FlashSyncMode mode = FLASH_SYNC_EXIT;
+
+    if (aMode == NULL || strcmp(aMode, "exit") == 0)
+    {
+        mode = FLASH_SYNC_EXIT;
+    }
+    else if (strcmp(aMode, "sleep") == 0)
+    {
+        mode = FLASH_SYNC_SLEEP;
+    }
+    else if (strcmp(aMode, "write") == 0)
+    {
+        mode = FLASH_SYNC_WRITE;
+    }
+    else if (strcmp(aMode, "ram") == 0)
+    {
+        mode = FLASH_SYNC_RAM;
+    }
+    else
+    {
+        fprintf(stderr, "Invalid RFSIM_FLASH_SYNC value: %s (must be exit, sleep, write or ram)\n", aMode);
+        platformExit(EXIT_FAILURE);
+    }
+    return mode;
+}
+
+static void flashSync(void)
+{
+    if (sFlashSyncMode != FLASH_SYNC_RAM && sFlashIsDirty)
+    {
+        VerifyOrDie(msync(sFlash, SWAP_SIZE * SWAP_NUM, MS_SYNC) == 0, OT_EXIT_ERROR_ERRNO);
+    }
+    sFlashIsDirty = false;
+}
+
+static void flashWritten(void)
+{
+    sFlashIsDirty = true;
+    if (sFlashSyncMode == FLASH_SYNC_WRITE)
+    {
+        flashSync();
+    }
+}
+
 void otPlatFlashInit(otInstance *aInstance)
 {
     const char *path = OPENTHREAD_CONFIG_POSIX_SETTINGS_PATH;
@@ -59,30 +118,56 @@ void otPlatFlashInit(otInstance *aInstance)
     struct stat st;
     bool        create = false;
     const char *offset = getenv("PORT_OFFSET");
+    void       *flash;
 
-    memset(&st, 0, sizeof(st));
-
-    if (stat(path, &st) == -1)
-    {
-        mkdir(path, 0777);
-    }
-
-    if (offset == NULL)
+    // flash stays mapped across a (pseudo) reset of the OT instance.
+    if (sFlash != NULL)
     {
-        offset = "0";
+        return;
     }
 
-    snprintf(fileName, sizeof(fileName), "%s/%s_%d.flash", path, offset, gNodeId);
+    sFlashSyncMode = parseFlashSyncMode(getenv("RFSIM_FLASH_SYNC"));
 
-    if (access(fileName, 0))
+    if (sFlashSyncMode == FLASH_SYNC_RAM)
     {
+        sFlash = malloc(SWAP_SIZE * SWAP_NUM);
+        VerifyOrDie(sFlash != NULL, OT_EXIT_ERROR_ERRNO);
         create = true;
     }
+    else
+    {
+        memset(&st, 0, sizeof(st));
 
-    sFlashFd = open(fileName, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
-    VerifyOrDie(sFlashFd >= 0, OT_EXIT_ERROR_ERRNO);
+        if (stat(path, &st) == -1)
+        {
+            mkdir(path, 0777);
+        }
 
-    lseek(sFlashFd, 0, SEEK_SET);
+        if (offset == NULL)
+        {
+            offset = "0";
+        }
+
+        snprintf(fileName, sizeof(fileName), "%s/%s_%d.flash", path, offset, gNodeId);
+
+        if (access(fileName, 0))
+        {
+            create = true;
+        }
+
+        sFlashFd = open(fileName, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        VerifyOrDie(sFlashFd >= 0, OT_EXIT_ERROR_ERRNO);
+        VerifyOrDie(fstat(sFlashFd, &st) == 0, OT_EXIT_ERROR_ERRNO);
+        if (st.st_size < SWAP_SIZE * SWAP_NUM)
+        {
+            VerifyOrDie(ftruncate(sFlashFd, SWAP_SIZE * SWAP_NUM) == 0, OT_EXIT_ERROR_ERRNO);
+            create = true;
+        }
+
+        flash = mmap(NULL, SWAP_SIZE * SWAP_NUM, PROT_READ | PROT_WRITE, MAP_SHARED, sFlashFd, 0);
+        VerifyOrDie(flash != MAP_FAILED, OT_EXIT_ERROR_ERRNO);
+        sFlash = flash;
+    }
 
     if (create)
     {
@@ -93,6 +178,35 @@ void otPlatFlashInit(otInstance *aInstance)
     }
 }
 
+void platformFlashSleep(void)
+{
+    if (sFlash != NULL && sFlashSyncMode == FLASH_SYNC_SLEEP)
+    {
+        flashSync();
+    }
+}
+
+void platformFlashDeinit(void)
+{
+    if (sFlash == NULL)
+    {
+        return;
+    }
+
+    if (sFlashSyncMode == FLASH_SYNC_RAM)
+    {
+        free(sFlash);
+    }
+    else
+    {
+        flashSync();
+        munmap(sFlash, SWAP_SIZE * SWAP_NUM);
+        close(sFlashFd);
+        sFlashFd = -1;
+    }
+    sFlash = NULL;
+}
+
 uint32_t otPlatFlashGetSwapSize(otInstance *aInstance)
 {
     OT_UNUSED_VARIABLE(aInstance);
@@ -104,17 +218,14 @@ void otPlatFlashErase(otInstance *aInstance, uint8_t aSwapIndex)
 {
     OT_UNUSED_VARIABLE(aInstance);
 
-    uint8_t  buffer[SWAP_SIZE];
     uint32_t address;
-    ssize_t  rval;
 
-    OT_ASSERT((sFlashFd >= 0) && (aSwapIndex < SWAP_NUM));
+    OT_ASSERT((sFlash != NULL) && (aSwapIndex < SWAP_NUM));
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_FLASH_CALLS, 1);
 
     address = aSwapIndex ? SWAP_SIZE : 0;
-    memset(buffer, 0xff, sizeof(buffer));
-
-    rval = pwrite(sFlashFd, buffer, sizeof(buffer), (off_t)address);
-    VerifyOrDie(rval == SWAP_SIZE, OT_EXIT_ERROR_ERRNO);
+    memset(&sFlash[address], 0xff, SWAP_SIZE);
+    flashWritten();
 }
 
 void otPlatFlashRead(otInstance *aInstance, uint8_t aSwapIndex, uint32_t aOffset, void *aData, uint32_t aSize)
@@ -122,38 +233,42 @@ void otPlatFlashRead(otInstance *aInstance, uint8_t aSwapIndex, uint32_t aOffset
     OT_UNUSED_VARIABLE(aInstance);
 
     uint32_t address;
-    ssize_t  rval;
 
-    OT_ASSERT((sFlashFd >= 0) && (aSwapIndex < SWAP_NUM) && (aSize <= SWAP_SIZE) && (aOffset <= (SWAP_SIZE - aSize)));
+    OT_ASSERT((sFlash != NULL) && (aSwapIndex < SWAP_NUM) && (aSize <= SWAP_SIZE) && (aOffset <= (SWAP_SIZE - aSize)));
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_FLASH_CALLS, 1);
 
     address = aSwapIndex ? SWAP_SIZE : 0;
-
-    rval = pread(sFlashFd, aData, aSize, (off_t)(address + aOffset));
-    VerifyOrDie((uint32_t)rval == aSize, OT_EXIT_ERROR_ERRNO);
+    memcpy(aData, &sFlash[address + aOffset], aSize);
 }
 
 void otPlatFlashWrite(otInstance *aInstance, uint8_t aSwapIndex, uint32_t aOffset, const void *aData, uint32_t aSize)
 {
     OT_UNUSED_VARIABLE(aInstance);
 
-    uint32_t address;
-    uint8_t  byte;
-    ssize_t  rval;
+    const uint8_t *data = (const uint8_t *)aData;
+    uint8_t       *flash;
+    uint32_t       offset = 0;
+    uint64_t       word;
+    uint64_t       dataWord;
 
-    OT_ASSERT((sFlashFd >= 0) && (aSwapIndex < SWAP_NUM) && (aSize <= SWAP_SIZE) && (aOffset <= (SWAP_SIZE - aSize)));
+    OT_ASSERT((sFlash != NULL) && (aSwapIndex < SWAP_NUM) && (aSize <= SWAP_SIZE) && (aOffset <= (SWAP_SIZE - aSize)));
+    RFSIM_PROFILE_ADD(RFSIM_PROFILE_FLASH_CALLS, 1);
 
-    address = aSwapIndex ? SWAP_SIZE : 0;
-    address += aOffset;
+    flash = &sFlash[(aSwapIndex ? SWAP_SIZE : 0) + aOffset];
 
-    for (uint32_t offset = 0; offset < aSize; offset++)
+    // Use bitwise AND to emulate the behavior of flash memory, a word at a time.
+    for (; offset + sizeof(word) <= aSize; offset += sizeof(word))
     {
-        rval = pread(sFlashFd, &byte, sizeof(byte), (off_t)(address + offset));
-        VerifyOrDie(rval == sizeof(byte), OT_EXIT_ERROR_ERRNO);
-
-        // Use bitwise AND to emulate the behavior of flash memory
-        byte &= ((uint8_t *)aData)[offset];
+        memcpy(&word, &flash[offset], sizeof(word));
+        memcpy(&dataWord, &data[offset], sizeof(dataWord));
+        word &= dataWord;
+        memcpy(&flash[offset], &word, sizeof(word));
+    }
 
-        rval = pwrite(sFlashFd, &byte, sizeof(byte), (off_t)(address + offset));
-        VerifyOrDie(rval == sizeof(byte), OT_EXIT_ERROR_ERRNO);
+    for (; offset < aSize; offset++)
+    {
+        flash[offset] &= data[offset];
     }
+
+    flashWritten();
 }
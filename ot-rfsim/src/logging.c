@@ -39,6 +39,7 @@
 #include <openthread/platform/logging.h>
 #include <openthread/platform/toolchain.h>
 #include "common/debug.hpp"
+#include "event-sim.h"
 
 #if (OPENTHREAD_CONFIG_LOG_OUTPUT == OPENTHREAD_CONFIG_LOG_OUTPUT_PLATFORM_DEFINED)
 
@@ -47,34 +48,77 @@
 //#define SYSLOG_LEVEL LOG_DEBUG
 #define SYSLOG_LEVEL LOG_WARNING
 
+// max length of a single log line, including newline and terminating NUL.
+#define LOG_LINE_MAX_SIZE 512
+
 static int convertOtLogLevelToSyslogLevel(otLogLevel otLevel);
 
+// highest log level of lines sent to the simulator, as set by the simulator.
+static otLogLevel sLogLevel = OT_LOG_LEVEL_DEBG;
+
+// log lines are collected, and sent to the simulator in a single event per time instant.
+static char   sLogBuf[OT_EVENT_DATA_MAX_SIZE];
+static size_t sLogBufLen = 0;
+
 void platformLoggingInit(char *processName){
     openlog(basename(processName), LOG_PID, LOG_USER);
     setlogmask(setlogmask(0) & LOG_UPTO(SYSLOG_LEVEL));
     syslog(LOG_NOTICE, "Started process for ot-rfsim node ID: %d", gNodeId);
 }
 
+void platformLoggingSetLevel(otLogLevel aLogLevel) {
+    sLogLevel = aLogLevel;
+}
+
+otLogLevel platformLoggingGetLevel(void) {
+    return sLogLevel;
+}
+
+void platformLoggingFlush(void) {
+    size_t len = sLogBufLen;
+
+    if (len == 0)
+        return;
+
+    // reset first, since a failing event write exits via platformExit(), which calls this function again.
+    sLogBufLen = 0;
+    otSimSendLogWriteEvent((const uint8_t *) &sLogBuf[0], len);
+}
+
 OT_TOOL_WEAK void otPlatLog(otLogLevel aLogLevel, otLogRegion aLogRegion, const char *aFormat, ...)
 {
     OT_UNUSED_VARIABLE(aLogRegion);
 
-    char    logString[512];
+    char    *logString;
     int     strLen;
     va_list args;
+    int     syslogLevel = convertOtLogLevelToSyslogLevel(aLogLevel);
+    bool    isSendLine  = !gTerminate && aLogLevel <= sLogLevel;
+
+    // drop the line before formatting, if neither the simulator nor syslog wants it.
+    if (!isSendLine && syslogLevel > SYSLOG_LEVEL)
+        return;
+
+    // format the line directly into the log buffer, which is flushed first if the line may not fit.
+    if (sLogBufLen + LOG_LINE_MAX_SIZE > sizeof(sLogBuf)) {
+        platformLoggingFlush();
+    }
+    logString = &sLogBuf[sLogBufLen];
 
     va_start(args, aFormat);
-    strLen = vsnprintf(&logString[0], sizeof(logString) - 2, aFormat, args);
+    strLen = vsnprintf(logString, LOG_LINE_MAX_SIZE - 1, aFormat, args);
     va_end(args);
     OT_ASSERT(strLen >= 0);
+    if (strLen > LOG_LINE_MAX_SIZE - 2) {
+        strLen = LOG_LINE_MAX_SIZE - 2; // line was truncated.
+    }
 
-    syslog(convertOtLogLevelToSyslogLevel(aLogLevel), "%s", logString);
+    syslog(syslogLevel, "%s", logString);
 
-    // extend logString with newline, and then log this string in an event.
-    if (!gTerminate) {
+    // extend logString with newline, and keep it in the buffer to send to the simulator.
+    if (isSendLine) {
         logString[strLen] = '\n';
-        logString[strLen + 1] = '\0';
-        otSimSendLogWriteEvent((const uint8_t *) &logString[0], strLen + 1);
+        sLogBufLen += strLen + 1;
     }
 }
 
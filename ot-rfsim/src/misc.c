@@ -38,7 +38,7 @@
 #include "common/logging.hpp"
 
 extern jmp_buf gResetJump;
-extern struct Event gLastSentEvent, gLastRecvEvent;
+extern struct EventHeader gLastSentEvent, gLastRecvEvent;
 
 otPlatResetReason   gPlatResetReason = OT_PLAT_RESET_REASON_POWER_ON;
 bool                gPlatformPseudoResetWasRequested;
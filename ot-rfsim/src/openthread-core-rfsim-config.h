@@ -323,6 +323,87 @@
 #define OPENTHREAD_CONFIG_PLATFORM_ASSERT_MANAGEMENT 1
 #endif
 
+/**
+ * @def OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+ *
+ * Define as 1 to let the node offer a shared-memory event transport to the simulator, next to the
+ * Unix socket. It is only used if the simulator accepts it.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+#define OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE 1
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_RFSIM_COMPACT_HEADER_ENABLE
+ *
+ * Define as 1 to let the node offer the compact (varint-encoded) event header format to the
+ * simulator. It is only used if the simulator accepts it.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_RFSIM_COMPACT_HEADER_ENABLE
+#define OPENTHREAD_CONFIG_RFSIM_COMPACT_HEADER_ENABLE 1
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_RFSIM_RADIO_STATE_SLEEP_ENABLE
+ *
+ * Define as 1 to let the node offer the combined radio-state and sleep event to the simulator,
+ * which only reports changed radio-state fields. It is only used if the simulator accepts it.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_RFSIM_RADIO_STATE_SLEEP_ENABLE
+#define OPENTHREAD_CONFIG_RFSIM_RADIO_STATE_SLEEP_ENABLE 1
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_RFSIM_SLEEP_WAKEUPS_ENABLE
+ *
+ * Define as 1 to let the node offer to include a list of all its future wake-up deadlines in the combined
+ * radio-state and sleep event, so that the simulator only wakes the node for deadlines that need it. It is
+ * only used if the simulator accepts it, and requires OPENTHREAD_CONFIG_RFSIM_RADIO_STATE_SLEEP_ENABLE.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_RFSIM_SLEEP_WAKEUPS_ENABLE
+#define OPENTHREAD_CONFIG_RFSIM_SLEEP_WAKEUPS_ENABLE 1
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_RFSIM_AES_ACCEL_ENABLE
+ *
+ * Define as 1 to use the rfsim AES platform implementation, which caches expanded AES key schedules
+ * and uses AES-NI instructions where the CPU supports these. Define as 0 to use the default mbedTLS
+ * implementation of the OpenThread stack.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_RFSIM_AES_ACCEL_ENABLE
+#define OPENTHREAD_CONFIG_RFSIM_AES_ACCEL_ENABLE 1
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+ *
+ * Define as 1 to build in the hot-path profiling counters of the node process (event handling time per
+ * event type, event send bytes/syscalls, select() time, stack processing time, flash/entropy/crypto calls).
+ * The counters are only updated while enabled at runtime by the simulator, via the 'profile' RfSim param.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+#define OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE 1
+#endif
+
+/**
+ * @def OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
+ *
+ * Define as 1 to build in the Wi-Fi Tx-interferer mode of the radio, which is enabled at runtime by the
+ * simulator via the 'txintf' RfSim param. Define as 0 for a 802.15.4-only radio; the 'txintf' param is then
+ * not supported by the node. Set by the CMake option RFSIM_INTERFERER.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
+#define OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE 1
+#endif
+
 /**
  * @def OPENTHREAD_CONFIG_OTNS_ENABLE
  *
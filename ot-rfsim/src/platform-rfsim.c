@@ -58,11 +58,20 @@
 extern int gSockFd;
 
 uint64_t     gLastMsgId = 0;
-struct Event gLastRecvEvent;
+struct EventHeader gLastRecvEvent;
 
 static otIp6Address unspecifiedIp6Address;
 
+static uint8_t sEventRxBuf[OT_EVENT_RX_BUFFER_SIZE];
+static size_t  sEventRxBufLen    = 0; // number of bytes in sEventRxBuf
+static size_t  sEventRxBufOffset = 0; // offset in sEventRxBuf of next event to handle
+static uint8_t sRxHeaderFormat   = OT_EVENT_HEADER_FORMAT_DEFAULT; // header format of received events
+
 void platformRfsimInit(void) {
+    sEventRxBufLen    = 0;
+    sEventRxBufOffset = 0;
+    sRxHeaderFormat   = OT_EVENT_HEADER_FORMAT_DEFAULT;
+
     if(otIp6AddressFromString("::", &unspecifiedIp6Address) != OT_ERROR_NONE) {
         platformExit(EXIT_FAILURE);
     }
@@ -71,51 +80,161 @@ void platformRfsimInit(void) {
 void platformExit(int exitCode) {
     gTerminate = true;
     otLogNotePlat("Exiting with exit code %d.", exitCode);
+    platformUartFlush();
+    platformLoggingFlush();
+    otSimFlushEvents();
+    platformFlashDeinit();
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    platformShmDeinit();
+#endif
     exit(exitCode);
 }
 
-void platformReceiveEvent(otInstance *aInstance)
+// decodes the next buffered event's header into aHeader. Returns the encoded header length,
+// or 0 if the buffer doesn't hold a complete event.
+static size_t getBufferedEvent(struct EventHeader *aHeader)
+{
+    const uint8_t *buf   = sEventRxBuf + sEventRxBufOffset;
+    size_t         avail = sEventRxBufLen - sEventRxBufOffset;
+    size_t         headerLen;
+
+    headerLen = otSimDecodeEventHeader(sRxHeaderFormat, buf, avail, gLastMsgId, aHeader);
+    if (headerLen == 0)
+    {
+        return 0;
+    }
+    OT_ASSERT(aHeader->mDataLength <= OT_EVENT_DATA_MAX_SIZE);
+    if (avail < headerLen + aHeader->mDataLength)
+    {
+        return 0;
+    }
+    return headerLen;
+}
+
+static void receiveEventsIntoBuffer(void)
 {
-    struct Event  event;
-    ssize_t       rval;
-    const uint8_t *evData = event.mData;
-    otError       error;
+    ssize_t rval;
 
-    rval = recvfrom(gSockFd, (char *)&event, sizeof(struct EventHeader), 0, NULL, NULL);
+    // move any partially received event to the start of the buffer, to make room.
+    if (sEventRxBufOffset > 0)
+    {
+        memmove(sEventRxBuf, sEventRxBuf + sEventRxBufOffset, sEventRxBufLen - sEventRxBufOffset);
+        sEventRxBufLen -= sEventRxBufOffset;
+        sEventRxBufOffset = 0;
+    }
+
+    // a single recv() reads all events that the simulator has sent so far, up to buffer size.
+    rval = recv(gSockFd, sEventRxBuf + sEventRxBufLen, sizeof(sEventRxBuf) - sEventRxBufLen, 0);
     if (rval < 0)
     {
-        perror("recvfrom");
+        if (errno == EINTR)
+            return;
+        perror("recv");
         platformExit(EXIT_FAILURE);
     }
-    OT_ASSERT(rval >= sizeof(struct EventHeader));
-
-    // read the rest of data (payload data - optional).
-    uint16_t payloadLen = event.mDataLength;
-    if (payloadLen > 0) {
-        OT_ASSERT(payloadLen <= OT_EVENT_DATA_MAX_SIZE);
-
-        rval = recvfrom(gSockFd, (char *)&event.mData, payloadLen, 0, NULL, NULL);
-        if (rval < 0)
-        {
-            perror("recvfrom");
-            platformExit(EXIT_FAILURE);
-        }
-        OT_ASSERT(rval == (ssize_t) payloadLen);
+    else if (rval == 0)
+    {
+        fprintf(stderr, "Simulator closed the socket\n");
+        platformExit(EXIT_FAILURE);
     }
+    sEventRxBufLen += rval;
+}
 
-    gLastRecvEvent = event;
-    gLastMsgId = event.mMsgId;
+static void handleEvent(otInstance *aInstance, const struct EventHeader *aEvent, const uint8_t *aData);
 
-    platformAlarmAdvanceNow(event.mDelay);
+bool platformIsEventPending(void)
+{
+    struct EventHeader event;
 
-    switch (event.mEvent)
+    return getBufferedEvent(&event) != 0;
+}
+
+void platformReceiveEvent(otInstance *aInstance)
+{
+    struct EventHeader event;
+    size_t             headerLen;
+    const uint8_t     *data;
+
+    while ((headerLen = getBufferedEvent(&event)) == 0)
+    {
+        receiveEventsIntoBuffer();
+    }
+
+    // handle all buffered events for the current time instant. Events that advance the time are
+    // left for a next call, so that alarms and radio processing are done at the right time.
+    do
+    {
+        data = sEventRxBuf + sEventRxBufOffset + headerLen;
+        sEventRxBufOffset += headerLen + event.mDataLength;
+        handleEvent(aInstance, &event, data);
+    } while ((headerLen = getBufferedEvent(&event)) != 0 && event.mDelay == 0 &&
+             event.mEvent != OT_SIM_EVENT_SHM_DATA);
+
+    if (sEventRxBufOffset == sEventRxBufLen)
+    {
+        sEventRxBufOffset = 0;
+        sEventRxBufLen    = 0;
+    }
+}
+
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+static void handleShmDataEvent(otInstance *aInstance, const uint8_t *aData, uint16_t aLength)
+{
+    static uint8_t     shmRxBuf[OT_EVENT_RX_BUFFER_SIZE];
+    uint32_t           shmDataLen;
+    size_t             readLen;
+    size_t             headerLen;
+    size_t             offset = 0;
+    struct EventHeader event;
+
+    OT_ASSERT(aLength >= sizeof(uint32_t));
+    memcpy(&shmDataLen, aData, sizeof(uint32_t));
+    OT_ASSERT(shmDataLen <= sizeof(shmRxBuf));
+    readLen = platformShmRead(shmRxBuf, shmDataLen);
+    OT_ASSERT(readLen == shmDataLen);
+
+    // the ring data consists of complete events only.
+    while (offset < shmDataLen)
+    {
+        headerLen = otSimDecodeEventHeader(sRxHeaderFormat, shmRxBuf + offset, shmDataLen - offset, gLastMsgId, &event);
+        OT_ASSERT(headerLen > 0);
+        offset += headerLen + event.mDataLength;
+        OT_ASSERT(offset <= shmDataLen);
+        handleEvent(aInstance, &event, shmRxBuf + offset - event.mDataLength);
+    }
+}
+#endif
+
+static void handleEvent(otInstance *aInstance, const struct EventHeader *aEvent, const uint8_t *aData)
+{
+    const uint8_t *evData     = aData;
+    uint16_t       payloadLen = aEvent->mDataLength;
+    otError        error;
+    uint64_t       startNs;
+
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    // an SHM_DATA event only announces events in the ring; it isn't an event by itself.
+    if (aEvent->mEvent == OT_SIM_EVENT_SHM_DATA)
+    {
+        handleShmDataEvent(aInstance, aData, payloadLen);
+        return;
+    }
+#endif
+
+    startNs        = RFSIM_PROFILE_TIME_NS();
+    gLastRecvEvent = *aEvent;
+    gLastMsgId = aEvent->mMsgId;
+
+    platformAlarmAdvanceNow(aEvent->mDelay);
+
+    switch (aEvent->mEvent)
     {
     case OT_SIM_EVENT_ALARM_FIRED:
         // Alarm events may be used to wake the node again when some simulated time has passed.
         break;
 
     case OT_SIM_EVENT_UART_WRITE:
-        otPlatUartReceived(event.mData, event.mDataLength);
+        otPlatUartReceived(aData, aEvent->mDataLength);
         break;
 
     case OT_SIM_EVENT_RADIO_COMM_START:
@@ -127,7 +246,7 @@ void platformReceiveEvent(otInstance *aInstance)
         VERIFY_EVENT_SIZE(struct RadioCommEventData)
         const size_t sz = sizeof(struct RadioCommEventData);
         platformRadioRxDone(aInstance, evData + sz,
-                       event.mDataLength - sz, (struct RadioCommEventData *)evData);
+                       aEvent->mDataLength - sz, (struct RadioCommEventData *)evData);
         break;
 
     case OT_SIM_EVENT_RADIO_TX_DONE:
@@ -156,7 +275,7 @@ void platformReceiveEvent(otInstance *aInstance)
         VERIFY_EVENT_SIZE(struct MsgToHostEventData)
 #if OPENTHREAD_CONFIG_BORDER_ROUTING_ENABLE
         error = platformIp6FromHostToNode(aInstance, (struct MsgToHostEventData *) evData,
-                                          event.mData + sizeof(struct MsgToHostEventData),
+                                          aData + sizeof(struct MsgToHostEventData),
                                           payloadLen - sizeof(struct MsgToHostEventData));
 #else
         error = OT_ERROR_NOT_IMPLEMENTED;
@@ -170,7 +289,7 @@ void platformReceiveEvent(otInstance *aInstance)
         VERIFY_EVENT_SIZE(struct MsgToHostEventData)
 #if OPENTHREAD_CONFIG_BORDER_ROUTING_ENABLE
         error = platformUdpFromHostToNode(aInstance, (struct MsgToHostEventData *) evData,
-                                          event.mData + sizeof(struct MsgToHostEventData),
+                                          aData + sizeof(struct MsgToHostEventData),
                                           payloadLen - sizeof(struct MsgToHostEventData));
 #else
         error = OT_ERROR_NOT_IMPLEMENTED;
@@ -180,9 +299,63 @@ void platformReceiveEvent(otInstance *aInstance)
         }
         break;
 
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    case OT_SIM_EVENT_SHM_ACCEPT:
+        platformShmAccepted();
+        break;
+#endif
+
+#if OPENTHREAD_CONFIG_RADIO_LINK_TREL_ENABLE
+    case OT_SIM_EVENT_TREL_PEER:
+        VERIFY_EVENT_SIZE(struct TrelEventData)
+        platformTrelHandlePeerEvent(aInstance, (const struct TrelEventData *)evData,
+                                    aData + sizeof(struct TrelEventData),
+                                    payloadLen - sizeof(struct TrelEventData));
+        break;
+
+    case OT_SIM_EVENT_TREL_DATA:
+        VERIFY_EVENT_SIZE(struct TrelEventData)
+        // the payload is in the (writable) events receive buffer, which OT may process in place.
+        platformTrelHandleDataEvent(aInstance, (const struct TrelEventData *)evData,
+                                    (uint8_t *)aData + sizeof(struct TrelEventData),
+                                    payloadLen - sizeof(struct TrelEventData));
+        break;
+#endif
+
+    case OT_SIM_EVENT_RADIO_STATE_SLEEP_ACCEPT:
+        otSimRadioStateSleepAccepted();
+        break;
+
+    case OT_SIM_EVENT_SLEEP_WAKEUPS_ACCEPT:
+        otSimSleepWakeupsAccepted();
+        break;
+
+    case OT_SIM_EVENT_RADIO_ENERGY_ACCEPT:
+    {
+        uint64_t reportInterval;
+
+        VERIFY_EVENT_SIZE(uint64_t)
+        memcpy(&reportInterval, evData, sizeof(reportInterval)); // payload may be unaligned
+        platformRadioEnergyAccepted(reportInterval);
+        break;
+    }
+
+    case OT_SIM_EVENT_HEADER_FORMAT:
+        VERIFY_EVENT_SIZE(uint8_t)
+        // the simulator uses the new format for the events that follow; respond by doing the same.
+        sRxHeaderFormat = evData[0];
+        otSimSetEventHeaderFormat(evData[0]);
+        break;
+
     default:
         OT_ASSERT(false && "Unrecognized event type received");
     }
+
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+    platformProfileEventHandled(aEvent->mEvent, startNs);
+#else
+    OT_UNUSED_VARIABLE(startNs);
+#endif
 }
 
 void otPlatOtnsStatus(const char *aStatus)
@@ -40,6 +40,7 @@
 #include <openthread/config.h>
 
 #include <assert.h>
+#include <errno.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -55,11 +56,13 @@
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <openthread/instance.h>
 #include <openthread/message.h>
 #include <openthread/ip6.h>
+#include <openthread/platform/logging.h>
 
 #include "event-sim.h"
 
@@ -112,6 +115,26 @@ void platformAlarmProcess(otInstance *aInstance);
  */
 uint64_t platformAlarmGetNext(void);
 
+/**
+ * gets the duration to the millisecond alarm event time, if the alarm is running.
+ *
+ * @param[out] aDelay  The duration (in micro seconds, us) to the alarm event, 0 if it is overdue.
+ *
+ * @returns TRUE if the millisecond alarm is running, FALSE otherwise.
+ *
+ */
+bool platformAlarmGetNextMilli(uint64_t *aDelay);
+
+/**
+ * gets the duration to the microsecond alarm event time, if the alarm is running.
+ *
+ * @param[out] aDelay  The duration (in micro seconds, us) to the alarm event, 0 if it is overdue.
+ *
+ * @returns TRUE if the microsecond alarm is running, FALSE otherwise.
+ *
+ */
+bool platformAlarmGetNextMicro(uint64_t *aDelay);
+
 /**
  * returns the current alarm time.
  *
@@ -159,22 +182,58 @@ void platformRadioInit(void);
  */
 void platformRadioProcess(otInstance *aInstance);
 
+#if OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
 /**
- * performs radio processing for simulated interferer behavior.
+ * performs radio processing for simulated interferer behavior. Registered as process handler while
+ * the radio operates as Tx interferer.
  *
  * @param[in]  aInstance    The OpenThread instance structure.
  *
  */
 void platformRadioInterfererProcess(otInstance *aInstance);
+#endif
 
 /**
- * Performs BLE radio driver processing.
+ * Performs BLE radio driver processing. Registered as process handler while BLE is enabled.
  *
  * @param[in]  aInstance    The OpenThread instance structure.
  *
  */
 void platformBleProcess(otInstance *aInstance);
 
+/**
+ * gets the duration to the next BLE advertisement, if advertising.
+ *
+ * @param[out] aDelay  The duration (in micro seconds, us) to the next BLE advertisement.
+ *
+ * @returns TRUE if a BLE advertisement is scheduled, FALSE otherwise.
+ *
+ */
+bool platformBleGetNextWakeup(uint64_t *aDelay);
+
+/**
+ * The optional driver subsystems, which are processed by otSysProcessDrivers() only while their process
+ * handler is registered. A subsystem registers its handler while active only, so that it costs nothing when idle.
+ *
+ */
+typedef enum
+{
+    RFSIM_PROCESS_HANDLER_TX_INTERFERER, ///< Wi-Fi Tx-interferer mode of the radio.
+    RFSIM_PROCESS_HANDLER_BLE,           ///< BLE radio.
+    RFSIM_PROCESS_NUM_HANDLERS,
+} RfSimProcessHandlerId;
+
+typedef void (*RfSimProcessHandler)(otInstance *aInstance);
+
+/**
+ * registers, or unregisters, the process handler of an optional driver subsystem.
+ *
+ * @param[in]  aId       The subsystem.
+ * @param[in]  aHandler  The process handler to call by otSysProcessDrivers(), or NULL to unregister.
+ *
+ */
+void platformSetProcessHandler(RfSimProcessHandlerId aId, RfSimProcessHandler aHandler);
+
 /**
  * initializes the random number service used by OpenThread.
  *
@@ -192,6 +251,34 @@ void platformRandomInit(int32_t randomSeed);
  */
 void platformLoggingInit(char *processName);
 
+/**
+ * sets the highest log level of the log lines that are sent to the simulator. Lines with a higher
+ * level are dropped before formatting, unless needed for syslog.
+ *
+ * @param[in] aLogLevel  The log level.
+ */
+void platformLoggingSetLevel(otLogLevel aLogLevel);
+
+/**
+ * gets the highest log level of the log lines that are sent to the simulator.
+ *
+ * @returns The log level.
+ */
+otLogLevel platformLoggingGetLevel(void);
+
+/**
+ * sends the collected log lines to the simulator, in a single log-write event.
+ * Called before the sleep event, so that the lines are received at the time they were logged.
+ *
+ */
+void platformLoggingFlush(void);
+
+/**
+ * sends the collected UART output to the simulator, in a single UART-write event.
+ *
+ */
+void platformUartFlush(void);
+
 /**
  * restores the Uart.
  *
@@ -212,6 +299,22 @@ void platformRfsimInit(void);
  */
 void platformExit(int exitCode);
 
+/**
+ * receives simulator event(s) from the socket and handles these. A single recv() call is used to read all
+ * events that the simulator sent so far into a buffer. All buffered events of the current time instant
+ * are handled; events that advance the time are left in the buffer for a next call.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ */
+void platformReceiveEvent(otInstance *aInstance);
+
+/**
+ * checks if a complete simulator event is buffered, which can be handled without reading the socket.
+ *
+ * @returns Whether a received event is pending (true) or not (false).
+ */
+bool platformIsEventPending(void);
+
 /**
  * checks if radio needs to transmit a pending MAC (data) frame.
  *
@@ -229,6 +332,40 @@ bool platformRadioIsTransmitPending(void);
  */
 void platformRadioReportStateToSimulator(bool force);
 
+/**
+ * lets the radio report its state to the simulator, if it changed w.r.t. the previous report,
+ * and then sends the sleep event to end the current time instant of the node.
+ *
+ */
+void platformRadioReportStateAndSleep(void);
+
+/**
+ * starts the periodic energy reports of the radio, as accepted by the simulator. The per-state time
+ * accumulators are reset, so that the first report covers the time from now on.
+ *
+ * @param[in]  aReportInterval  The minimum interval (in micro seconds, us) between energy reports.
+ */
+void platformRadioEnergyAccepted(uint64_t aReportInterval);
+
+/**
+ * lets the radio report the time spent per energy-state since the previous report, if energy reports
+ * are accepted by the simulator and the report interval elapsed.
+ *
+ * @param[in]  aForce If true, sends the report also if the report interval did not yet elapse.
+ */
+void platformRadioReportEnergy(bool aForce);
+
+/**
+ * gets the duration to the end of the current radio substate, if the substate has a defined end time.
+ *
+ * @param[out] aDelay            The duration (in micro seconds, us) to the end of the substate.
+ * @param[out] aIsUnconditional  Set to FALSE if the node doesn't need to be woken up for it, TRUE otherwise.
+ *
+ * @returns TRUE if the radio substate has a future end time, FALSE otherwise.
+ *
+ */
+bool platformRadioGetNextWakeup(uint64_t *aDelay, bool *aIsUnconditional);
+
 /**
  * performs the processing of an IPv6 packet that was sent from the (higher-layer) host to the OT node.
  *
@@ -347,42 +484,209 @@ void platformRadioRfSimParamSet(otInstance *aInstance, struct RfSimParamEventDat
 #if OPENTHREAD_CONFIG_RADIO_LINK_TREL_ENABLE
 
 /**
- * initializes the TREL service.
+ * handles a TREL peer event from the simulator: a peer's service was discovered, updated or removed.
  *
- * @param[in] aSpeedUpFactor   The time speed-up factor.
+ * @param[in]  aInstance    The OpenThread instance structure.
+ * @param[in]  aEventData   A pointer to the TREL event data.
+ * @param[in]  aTxtData     A pointer to the peer's service TXT data.
+ * @param[in]  aTxtLength   The length of the TXT data.
  *
  */
-void platformTrelInit(uint32_t aSpeedUpFactor);
+void platformTrelHandlePeerEvent(otInstance *aInstance, const struct TrelEventData *aEventData,
+                                 const uint8_t *aTxtData, uint16_t aTxtLength);
 
 /**
- * shuts down the TREL service.
+ * handles a TREL data event from the simulator: a TREL UDP packet received from a peer.
+ *
+ * @param[in]  aInstance    The OpenThread instance structure.
+ * @param[in]  aEventData   A pointer to the TREL event data.
+ * @param[in]  aPayload     A pointer to the UDP payload.
+ * @param[in]  aLength      The length of the UDP payload.
  *
  */
-void platformTrelDeinit(void);
+void platformTrelHandleDataEvent(otInstance *aInstance, const struct TrelEventData *aEventData,
+                                 uint8_t *aPayload, uint16_t aLength);
+
+#endif // OPENTHREAD_CONFIG_RADIO_LINK_TREL_ENABLE
 
 /**
- * updates the file descriptor sets with file descriptors used by the TREL.
+ * syncs the flash memory to its file before the node goes to sleep, if this policy is selected.
  *
- * @param[in,out]  aReadFdSet   A pointer to the read file descriptors.
- * @param[in,out]  aWriteFdSet  A pointer to the write file descriptors.
- * @param[in,out]  aTimeout     A pointer to the timeout.
- * @param[in,out]  aMaxFd       A pointer to the max file descriptor.
+ */
+void platformFlashSleep(void);
+
+/**
+ * syncs the flash memory to its file, if any, and releases it.
  *
  */
-void platformTrelUpdateFdSet(fd_set *aReadFdSet, fd_set *aWriteFdSet,
-                             struct timeval *aTimeout, int *aMaxFd);
+void platformFlashDeinit(void);
 
 /**
- * performs TREL processing.
+ * runs the zygote (fork-server) loop if the process was started as `<exe> zygote <OTNS-Unix-socket-file> <fd>`.
+ * The zygote does not connect to the simulator; it waits on the control socket <fd> for node start requests and
+ * forks a child per request. This function only returns in a child, with argc/argv rewritten to the
+ * regular `<exe> <NodeId> <OTNS-Unix-socket-file> [<random-seed>]` form and stdin/stdout/stderr redirected.
+ * It returns immediately if the process is not started in zygote mode.
  *
- * @param[in]  aInstance    The OpenThread instance structure.
- * @param[in]  aReadFdSet   A pointer to the read file descriptors.
- * @param[in]  aWriteFdSet  A pointer to the write file descriptors.
+ * @param[in,out]  aArgc  A pointer to the number of arguments.
+ * @param[in,out]  aArgv  The argument vector.
+ */
+void platformZygoteRun(int *aArgc, char *aArgv[]);
+
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+
+/**
+ * initializes the shared-memory event transport: creates the shared-memory region that is
+ * offered to the simulator. On failure, the socket transport is used.
  *
  */
-void platformTrelProcess(otInstance *aInstance, const fd_set *aReadFdSet,
-                         const fd_set *aWriteFdSet);
+void platformShmInit(void);
 
-#endif // OPENTHREAD_CONFIG_RADIO_LINK_TREL_ENABLE
+/**
+ * shuts down the shared-memory event transport and removes the shared-memory region.
+ *
+ */
+void platformShmDeinit(void);
+
+/**
+ * gets the name of the shared-memory region to offer to the simulator.
+ *
+ * @returns The shared-memory object name, or NULL if not available.
+ *
+ */
+const char *platformShmGetName(void);
+
+/**
+ * handles the acceptance of the shared-memory transport by the simulator.
+ *
+ */
+void platformShmAccepted(void);
+
+/**
+ * checks if the shared-memory transport was accepted by the simulator, and can be used.
+ *
+ * @returns Whether the shared-memory transport is active (true) or not (false).
+ *
+ */
+bool platformShmIsActive(void);
+
+/**
+ * writes an event (encoded header and payload segments) into the node-to-simulator ring.
+ *
+ * @param[in]  aHeader        A pointer to the encoded event header.
+ * @param[in]  aHeaderLen     Length of the encoded event header.
+ * @param[in]  aPayload       A pointer to the payload segments.
+ * @param[in]  aPayloadCount  Number of payload segments.
+ *
+ * @returns Whether the event was written (true), or not due to lack of space in the ring (false).
+ *
+ */
+bool platformShmWriteEvent(const uint8_t *aHeader, size_t aHeaderLen, const struct iovec *aPayload, size_t aPayloadCount);
+
+/**
+ * reads bytes from the simulator-to-node ring.
+ *
+ * @param[out] aBuf   A pointer to the buffer to read into.
+ * @param[in]  aLen   Number of bytes to read.
+ *
+ * @returns The number of bytes read.
+ *
+ */
+size_t platformShmRead(uint8_t *aBuf, size_t aLen);
+
+#endif // OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+
+/**
+ * The profiling counters of the node process, other than the per-event-type ones.
+ *
+ */
+typedef enum
+{
+    RFSIM_PROFILE_TX_EVENTS,     ///< Number of events sent to the simulator.
+    RFSIM_PROFILE_TX_BYTES,      ///< Number of event bytes (headers and payloads) sent to the simulator.
+    RFSIM_PROFILE_TX_SYSCALLS,   ///< Number of write() calls on the simulator socket.
+    RFSIM_PROFILE_SELECT_NS,     ///< Wall-clock time blocked in select(), waiting for the simulator.
+    RFSIM_PROFILE_STACK_NS,      ///< Wall-clock time spent outside otSysProcessDrivers() (tasklets, stack).
+    RFSIM_PROFILE_FLASH_CALLS,   ///< Number of flash read/write/erase calls.
+    RFSIM_PROFILE_ENTROPY_CALLS, ///< Number of entropy/random calls.
+    RFSIM_PROFILE_CRYPTO_CALLS,  ///< Number of AES key-set/encrypt calls.
+    RFSIM_PROFILE_NUM_COUNTERS,
+} RfSimProfileCounter;
+
+/**
+ * Whether profiling is enabled at runtime. Only to be read via the RFSIM_PROFILE_* macros.
+ *
+ */
+extern bool gProfileEnabled;
+
+/**
+ * enables or disables the profiling counters. Enabling resets all counters to zero.
+ *
+ * @param[in]  aEnabled  Whether to enable (true) or disable (false) profiling.
+ *
+ */
+void platformProfileSetEnabled(bool aEnabled);
+
+/**
+ * gets the current wall-clock (monotonic) time, used for profiling.
+ *
+ * @returns The monotonic time in ns.
+ *
+ */
+uint64_t platformProfileGetTimeNs(void);
+
+/**
+ * adds a value to a profiling counter.
+ *
+ * @param[in]  aCounter  The counter.
+ * @param[in]  aValue    The value to add.
+ *
+ */
+void platformProfileAdd(RfSimProfileCounter aCounter, uint64_t aValue);
+
+/**
+ * records the handling of a received event of a given type, which started at aStartNs.
+ *
+ * @param[in]  aEventType  The type of the handled event.
+ * @param[in]  aStartNs    The platformProfileGetTimeNs() time when handling started.
+ *
+ */
+void platformProfileEventHandled(uint8_t aEventType, uint64_t aStartNs);
+
+/**
+ * marks the entry into otSysProcessDrivers(), accounting the time spent outside of it since the last exit.
+ *
+ */
+void platformProfileDriversEnter(void);
+
+/**
+ * marks the exit of otSysProcessDrivers().
+ *
+ */
+void platformProfileDriversExit(void);
+
+/**
+ * sends all nonzero profiling counters to the simulator, as an OTNS status push 'prof=<key>:<value>,...'.
+ *
+ */
+void platformProfileReport(void);
+
+#define RFSIM_PROFILE_ADD(aCounter, aValue)            \
+    do                                                 \
+    {                                                  \
+        if (gProfileEnabled)                           \
+            platformProfileAdd((aCounter), (aValue));  \
+    } while (0)
+
+#define RFSIM_PROFILE_TIME_NS() (gProfileEnabled ? platformProfileGetTimeNs() : 0)
+
+#else
+
+#define RFSIM_PROFILE_ADD(aCounter, aValue)
+#define RFSIM_PROFILE_TIME_NS() 0
+
+#endif // OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
 
 #endif // PLATFORM_RFSIM_H_
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2024, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief
+ *   This file implements the optional hot-path profiling counters of the node process.
+ */
+
+#include "platform-rfsim.h"
+
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+
+#include <inttypes.h>
+
+#include <utils/code_utils.h>
+
+enum
+{
+    PROFILE_NUM_EVENT_TYPES = 256,
+};
+
+static const char *const sCounterNames[RFSIM_PROFILE_NUM_COUNTERS] = {
+    "tx.events", "tx.bytes", "tx.syscalls", "select.ns", "stack.ns", "flash.calls", "entropy.calls", "crypto.calls",
+};
+
+bool            gProfileEnabled = false;
+static uint64_t sCounters[RFSIM_PROFILE_NUM_COUNTERS];
+static uint64_t sEventCount[PROFILE_NUM_EVENT_TYPES];
+static uint64_t sEventNs[PROFILE_NUM_EVENT_TYPES];
+static uint64_t sDriversExitNs = 0; // time of last otSysProcessDrivers() exit, or 0 if not known.
+
+void platformProfileSetEnabled(bool aEnabled)
+{
+    if (aEnabled && !gProfileEnabled)
+    {
+        memset(sCounters, 0, sizeof(sCounters));
+        memset(sEventCount, 0, sizeof(sEventCount));
+        memset(sEventNs, 0, sizeof(sEventNs));
+        sDriversExitNs = 0;
+    }
+    gProfileEnabled = aEnabled;
+}
+
+uint64_t platformProfileGetTimeNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void platformProfileAdd(RfSimProfileCounter aCounter, uint64_t aValue)
+{
+    sCounters[aCounter] += aValue;
+}
+
+void platformProfileEventHandled(uint8_t aEventType, uint64_t aStartNs)
+{
+    if (!gProfileEnabled || aStartNs == 0)
+        return;
+
+    sEventCount[aEventType]++;
+    sEventNs[aEventType] += platformProfileGetTimeNs() - aStartNs;
+}
+
+void platformProfileDriversEnter(void)
+{
+    if (gProfileEnabled && sDriversExitNs != 0)
+    {
+        sCounters[RFSIM_PROFILE_STACK_NS] += platformProfileGetTimeNs() - sDriversExitNs;
+    }
+}
+
+void platformProfileDriversExit(void)
+{
+    sDriversExitNs = RFSIM_PROFILE_TIME_NS();
+}
+
+void platformProfileReport(void)
+{
+    char   buf[OT_EVENT_DATA_MAX_SIZE];
+    size_t len;
+    int    n;
+
+    len = (size_t)snprintf(buf, sizeof(buf), "prof=");
+    for (int i = 0; i < RFSIM_PROFILE_NUM_COUNTERS; i++)
+    {
+        n = snprintf(buf + len, sizeof(buf) - len, "%s:%" PRIu64 ",", sCounterNames[i], sCounters[i]);
+        otEXPECT(n > 0 && (size_t)n < sizeof(buf) - len);
+        len += (size_t)n;
+    }
+    for (int i = 0; i < PROFILE_NUM_EVENT_TYPES; i++)
+    {
+        if (sEventCount[i] == 0)
+            continue;
+        n = snprintf(buf + len, sizeof(buf) - len, "ev%d.num:%" PRIu64 ",ev%d.ns:%" PRIu64 ",", i, sEventCount[i], i,
+                     sEventNs[i]);
+        otEXPECT(n > 0 && (size_t)n < sizeof(buf) - len);
+        len += (size_t)n;
+    }
+
+exit:
+    // drop the trailing comma.
+    otSimSendOtnsStatusPushEvent(buf, (uint16_t)(len - 1));
+}
+
+#endif // OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
@@ -28,6 +28,7 @@
 
 #include "platform-rfsim.h"
 #include "radio.h"
+#include "fcs.h"
 
 #include <sys/time.h>
 #include <stdio.h>
@@ -52,9 +53,13 @@ static void setRadioSubState(RadioSubState aState, uint64_t timeToRemainInState)
 static void startCcaForTransmission(otInstance *aInstance, uint64_t ccaDurationUs);
 static void signalRadioTxDone(otInstance *aInstance, otRadioFrame *aFrame, otRadioFrame *aAckFrame, otError aError);
 static void applyRadioDelayedSleep();
+static uint8_t getEnergyState(void);
+static void updateEnergyAccumulators(void);
 void radioSendMessage(otInstance *aInstance);
 void radioTransmit(struct RadioMessage *aMessage, const struct otRadioFrame *aFrame);
+#if OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
 void radioTransmitInterference(uint64_t frameDurationUs);
+#endif
 void setRadioState(otRadioState aState);
 void radioPrepareAck(void);
 static bool IsTimeAfterOrEqual(uint32_t aTimeA, uint32_t aTimeB);
@@ -80,6 +85,13 @@ static int8_t   sEnergyScanResult  = OT_RADIO_RSSI_INVALID;
 static bool     sEnergyScanning    = false;
 static uint32_t sEnergyScanEndTime = 0;
 
+// per energy-state (OT_RADIO_STATE_*) time accumulators, reported to the simulator as deltas.
+static uint64_t sEnergyTimeUs[OT_RADIO_STATE_TRANSMIT + 1];
+static uint64_t sEnergyLastTime       = 0;
+static uint8_t  sEnergyState          = OT_RADIO_STATE_DISABLED;
+static uint64_t sEnergyReportInterval = 0; // 0: energy reports not accepted by simulator.
+static uint64_t sEnergyLastReportTime = 0;
+
 static otRadioState        sState = OT_RADIO_STATE_DISABLED;
 static struct RadioMessage sReceiveMessage;
 static struct RadioMessage sTransmitMessage;
@@ -103,7 +115,11 @@ static int8_t         sCcaEdThresh    = RFSIM_CCA_ED_THRESHOLD_DEFAULT_DBM;
 static int8_t         sRxSensitivity  = RFSIM_RX_SENSITIVITY_DEFAULT_DBM;
 static uint8_t        sCslAccuracy    = RFSIM_CSL_ACCURACY_DEFAULT_PPM;
 static uint8_t        sCslUncertainty = RFSIM_CSL_UNCERTAINTY_DEFAULT_10US;
+#if OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
 static uint8_t        sTxInterfererLevel = 0;
+#else
+static const uint8_t  sTxInterfererLevel = 0; // never an interferer: the interferer code paths are compiled out.
+#endif
 static int8_t         sLnaGain     = 0;
 static uint16_t       sRegionCode  = 0;
 static int8_t         sChannelMaxTransmitPower[kMaxChannel - kMinChannel + 1]; // for 802.15.4 only
@@ -180,34 +196,6 @@ static bool hasFramePending(const otRadioFrame *aFrame)
     return rval;
 }
 
-static uint16_t crc16_citt(uint16_t aFcs, uint8_t aByte)
-{
-    // CRC-16/CCITT, CRC-16/CCITT-TRUE, CRC-CCITT
-    // width=16 poly=0x1021 init=0x0000 refin=true refout=true xorout=0x0000 check=0x2189 name="KERMIT"
-    // http://reveng.sourceforge.net/crc-catalogue/16.htm#crc.cat.kermit
-    static const uint16_t sFcsTable[256] = {
-            0x0000, 0x1189, 0x2312, 0x329b, 0x4624, 0x57ad, 0x6536, 0x74bf, 0x8c48, 0x9dc1, 0xaf5a, 0xbed3, 0xca6c, 0xdbe5,
-            0xe97e, 0xf8f7, 0x1081, 0x0108, 0x3393, 0x221a, 0x56a5, 0x472c, 0x75b7, 0x643e, 0x9cc9, 0x8d40, 0xbfdb, 0xae52,
-            0xdaed, 0xcb64, 0xf9ff, 0xe876, 0x2102, 0x308b, 0x0210, 0x1399, 0x6726, 0x76af, 0x4434, 0x55bd, 0xad4a, 0xbcc3,
-            0x8e58, 0x9fd1, 0xeb6e, 0xfae7, 0xc87c, 0xd9f5, 0x3183, 0x200a, 0x1291, 0x0318, 0x77a7, 0x662e, 0x54b5, 0x453c,
-            0xbdcb, 0xac42, 0x9ed9, 0x8f50, 0xfbef, 0xea66, 0xd8fd, 0xc974, 0x4204, 0x538d, 0x6116, 0x709f, 0x0420, 0x15a9,
-            0x2732, 0x36bb, 0xce4c, 0xdfc5, 0xed5e, 0xfcd7, 0x8868, 0x99e1, 0xab7a, 0xbaf3, 0x5285, 0x430c, 0x7197, 0x601e,
-            0x14a1, 0x0528, 0x37b3, 0x263a, 0xdecd, 0xcf44, 0xfddf, 0xec56, 0x98e9, 0x8960, 0xbbfb, 0xaa72, 0x6306, 0x728f,
-            0x4014, 0x519d, 0x2522, 0x34ab, 0x0630, 0x17b9, 0xef4e, 0xfec7, 0xcc5c, 0xddd5, 0xa96a, 0xb8e3, 0x8a78, 0x9bf1,
-            0x7387, 0x620e, 0x5095, 0x411c, 0x35a3, 0x242a, 0x16b1, 0x0738, 0xffcf, 0xee46, 0xdcdd, 0xcd54, 0xb9eb, 0xa862,
-            0x9af9, 0x8b70, 0x8408, 0x9581, 0xa71a, 0xb693, 0xc22c, 0xd3a5, 0xe13e, 0xf0b7, 0x0840, 0x19c9, 0x2b52, 0x3adb,
-            0x4e64, 0x5fed, 0x6d76, 0x7cff, 0x9489, 0x8500, 0xb79b, 0xa612, 0xd2ad, 0xc324, 0xf1bf, 0xe036, 0x18c1, 0x0948,
-            0x3bd3, 0x2a5a, 0x5ee5, 0x4f6c, 0x7df7, 0x6c7e, 0xa50a, 0xb483, 0x8618, 0x9791, 0xe32e, 0xf2a7, 0xc03c, 0xd1b5,
-            0x2942, 0x38cb, 0x0a50, 0x1bd9, 0x6f66, 0x7eef, 0x4c74, 0x5dfd, 0xb58b, 0xa402, 0x9699, 0x8710, 0xf3af, 0xe226,
-            0xd0bd, 0xc134, 0x39c3, 0x284a, 0x1ad1, 0x0b58, 0x7fe7, 0x6e6e, 0x5cf5, 0x4d7c, 0xc60c, 0xd785, 0xe51e, 0xf497,
-            0x8028, 0x91a1, 0xa33a, 0xb2b3, 0x4a44, 0x5bcd, 0x6956, 0x78df, 0x0c60, 0x1de9, 0x2f72, 0x3efb, 0xd68d, 0xc704,
-            0xf59f, 0xe416, 0x90a9, 0x8120, 0xb3bb, 0xa232, 0x5ac5, 0x4b4c, 0x79d7, 0x685e, 0x1ce1, 0x0d68, 0x3ff3, 0x2e7a,
-            0xe70e, 0xf687, 0xc41c, 0xd595, 0xa12a, 0xb0a3, 0x8238, 0x93b1, 0x6b46, 0x7acf, 0x4854, 0x59dd, 0x2d62, 0x3ceb,
-            0x0e70, 0x1ff9, 0xf78f, 0xe606, 0xd49d, 0xc514, 0xb1ab, 0xa022, 0x92b9, 0x8330, 0x7bc7, 0x6a4e, 0x58d5, 0x495c,
-            0x3de3, 0x2c6a, 0x1ef1, 0x0f78};
-    return (aFcs >> 8) ^ sFcsTable[(aFcs ^ aByte) & 0xff];
-}
-
 void otPlatRadioGetIeeeEui64(otInstance *aInstance, uint8_t *aIeeeEui64)
 {
     OT_UNUSED_VARIABLE(aInstance);
@@ -381,7 +369,9 @@ otError otPlatRadioReceive(otInstance *aInstance, uint8_t aChannel)
 
     if (sState != OT_RADIO_STATE_DISABLED)
     {
-        if (sState == OT_RADIO_STATE_SLEEP && sSubState != RFSIM_RADIO_SUBSTATE_STARTUP) {
+        // a startup period that already ended (but wasn't processed yet) is followed by the ramp-up period.
+        if (sState == OT_RADIO_STATE_SLEEP &&
+            (sSubState != RFSIM_RADIO_SUBSTATE_STARTUP || otPlatTimeGet() >= sNextRadioEventTime)) {
             setRadioSubState(RFSIM_RADIO_SUBSTATE_STARTUP, RFSIM_RAMPUP_TIME_US);
         }
         error                  = OT_ERROR_NONE;
@@ -451,18 +441,28 @@ bool otPlatRadioGetPromiscuous(otInstance *aInstance)
 
 static void radioComputeCrc(struct RadioMessage *aMessage, uint16_t aLength)
 {
-    uint16_t crc        = 0;
     uint16_t crc_offset = aLength - sizeof(uint16_t);
-
-    for (uint16_t i = 0; i < crc_offset; i++)
-    {
-        crc = crc16_citt(crc, aMessage->mPsdu[i]);
-    }
+    uint16_t crc        = platformFcsCompute(0, aMessage->mPsdu, crc_offset);
 
     aMessage->mPsdu[crc_offset]     = crc & 0xff;
     aMessage->mPsdu[crc_offset + 1] = crc >> 8;
 }
 
+static bool radioIsCrcValid(const struct RadioMessage *aMessage, uint16_t aLength)
+{
+    bool     rval = false;
+    uint16_t crc_offset;
+    uint16_t crc;
+
+    otEXPECT(aLength >= sizeof(uint16_t));
+    crc_offset = aLength - sizeof(uint16_t);
+    crc        = platformFcsCompute(0, aMessage->mPsdu, crc_offset);
+    rval       = aMessage->mPsdu[crc_offset] == (crc & 0xff) && aMessage->mPsdu[crc_offset + 1] == (crc >> 8);
+
+    exit:
+    return rval;
+}
+
 static otError radioProcessTransmitSecurity(otRadioFrame *aFrame)
 {
     otError error = OT_ERROR_NONE;
@@ -1012,6 +1012,7 @@ void radioTransmit(struct RadioMessage *aMessage, const struct otRadioFrame *aFr
     otSimSendRadioCommEvent(&sLastTxEventData, (const uint8_t*) aMessage, aFrame->mLength + offsetof(struct RadioMessage, mPsdu));
 }
 
+#if OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
 void radioTransmitInterference(uint64_t frameDurationUs)
 {
     sLastTxEventData.mChannel  = sOngoingOperationChannel;
@@ -1021,6 +1022,7 @@ void radioTransmitInterference(uint64_t frameDurationUs)
 
     otSimSendRadioCommInterferenceEvent(&sLastTxEventData);
 }
+#endif
 
 void radioReceive(otInstance *aInstance, otError aError)
 {
@@ -1070,10 +1072,70 @@ static void signalRadioTxDone(otInstance *aInstance, otRadioFrame *aFrame, otRad
     }
 }
 
-void platformRadioReportStateToSimulator(bool aForce)
+// determine the energy-state from subState. Only in very particular substates,
+// the radio is actively transmitting.
+static uint8_t getEnergyState(void)
 {
-    struct RadioStateEventData stateReport;
+    uint8_t energyState = sState;
+    if (sSubState == RFSIM_RADIO_SUBSTATE_TX_FRAME_ONGOING || sSubState == RFSIM_RADIO_SUBSTATE_RX_ACK_TX_ONGOING)
+    {
+        energyState = OT_RADIO_STATE_TRANSMIT;
+    }
+    else if (sState == OT_RADIO_STATE_TRANSMIT || sSubState == RFSIM_RADIO_SUBSTATE_RX_FRAME_ONGOING)
+    {
+        energyState = OT_RADIO_STATE_RECEIVE;
+    }
+    return energyState;
+}
+
+// adds the time spent in the previous energy-state to its accumulator, and starts timing the current one.
+static void updateEnergyAccumulators(void)
+{
+    uint64_t now = otPlatTimeGet();
+
+    if (sEnergyState <= OT_RADIO_STATE_TRANSMIT)
+    {
+        sEnergyTimeUs[sEnergyState] += now - sEnergyLastTime;
+    }
+    sEnergyLastTime = now;
+    sEnergyState    = getEnergyState();
+}
 
+void platformRadioEnergyAccepted(uint64_t aReportInterval)
+{
+    updateEnergyAccumulators();
+    memset(sEnergyTimeUs, 0, sizeof(sEnergyTimeUs));
+    sEnergyReportInterval = aReportInterval;
+    sEnergyLastReportTime = otPlatTimeGet();
+}
+
+void platformRadioReportEnergy(bool aForce)
+{
+    struct RadioEnergyEventData energyReport;
+    uint64_t                    now = otPlatTimeGet();
+
+    otEXPECT(sEnergyReportInterval > 0);
+    otEXPECT(aForce || now >= sEnergyLastReportTime + sEnergyReportInterval);
+
+    updateEnergyAccumulators();
+    energyReport.mEnergyState = sEnergyState;
+    energyReport.mDisabledUs  = sEnergyTimeUs[OT_RADIO_STATE_DISABLED];
+    energyReport.mSleepUs     = sEnergyTimeUs[OT_RADIO_STATE_SLEEP];
+    energyReport.mRxUs        = sEnergyTimeUs[OT_RADIO_STATE_RECEIVE];
+    energyReport.mTxUs        = sEnergyTimeUs[OT_RADIO_STATE_TRANSMIT];
+    otSimSendRadioEnergyEvent(&energyReport);
+
+    memset(sEnergyTimeUs, 0, sizeof(sEnergyTimeUs));
+    sEnergyLastReportTime = now;
+
+exit:
+    return;
+}
+
+// fills in aStateReport, if the radio state changed since the last report or if aForce is set.
+// Returns true if a report is to be sent.
+static bool getRadioStateReport(bool aForce, struct RadioStateEventData *aStateReport, uint64_t *aDelayUntilNextRadioState)
+{
     if (aForce || sLastReportedState != sState || sLastReportedChannel != sOngoingOperationChannel ||
         sLastReportedSubState != sSubState || sLastReportedRadioEventTime != sNextRadioEventTime ||
         sLastReportedRxSensitivity != sRxSensitivity)
@@ -1084,37 +1146,66 @@ void platformRadioReportStateToSimulator(bool aForce)
         sLastReportedRadioEventTime = sNextRadioEventTime;
         sLastReportedRxSensitivity  = sRxSensitivity;
 
-        // determine the energy-state from subState. Only in very particular substates,
-        // the radio is actively transmitting.
-        uint8_t energyState = sState;
-        if (sSubState == RFSIM_RADIO_SUBSTATE_TX_FRAME_ONGOING || sSubState == RFSIM_RADIO_SUBSTATE_RX_ACK_TX_ONGOING)
-        {
-            energyState = OT_RADIO_STATE_TRANSMIT;
-        }
-        else if (sState == OT_RADIO_STATE_TRANSMIT || sSubState == RFSIM_RADIO_SUBSTATE_RX_FRAME_ONGOING)
-        {
-            energyState = OT_RADIO_STATE_RECEIVE;
-        }
-
-        stateReport.mChannel       = sOngoingOperationChannel;
-        stateReport.mEnergyState   = energyState;
-        stateReport.mSubState      = sSubState;
-        stateReport.mTxPower       = sTxPower;
-        stateReport.mRxSensitivity = sRxSensitivity;
-        stateReport.mState         = sState; // also include the OT radio state.
-        stateReport.mRadioTime     = otPlatTimeGet();
+        aStateReport->mChannel       = sOngoingOperationChannel;
+        aStateReport->mEnergyState   = getEnergyState();
+        aStateReport->mSubState      = sSubState;
+        aStateReport->mTxPower       = sTxPower;
+        aStateReport->mRxSensitivity = sRxSensitivity;
+        aStateReport->mState         = sState; // also include the OT radio state.
+        aStateReport->mRadioTime     = otPlatTimeGet();
 
         // determine next radio-event time, so that simulator can guarantee this node will
         // execute again at that time.
-        uint64_t delayUntilNextRadioState = 0;
+        *aDelayUntilNextRadioState = 0;
         if (sNextRadioEventTime > otPlatTimeGet())
         {
-            delayUntilNextRadioState = sNextRadioEventTime - otPlatTimeGet();
+            *aDelayUntilNextRadioState = sNextRadioEventTime - otPlatTimeGet();
         }
+        return true;
+    }
+    return false;
+}
+
+void platformRadioReportStateToSimulator(bool aForce)
+{
+    struct RadioStateEventData stateReport;
+    uint64_t                   delayUntilNextRadioState;
+
+    if (getRadioStateReport(aForce, &stateReport, &delayUntilNextRadioState))
+    {
         otSimSendRadioStateEvent(&stateReport, delayUntilNextRadioState);
     }
 }
 
+bool platformRadioGetNextWakeup(uint64_t *aDelay, bool *aIsUnconditional)
+{
+    uint64_t now = otPlatTimeGet();
+
+    if (sNextRadioEventTime <= now) // also covers UNDEFINED_TIME_US
+    {
+        return false;
+    }
+
+    *aDelay = sNextRadioEventTime - now;
+
+    // with the radio off, the end of the startup period has no effect until the radio is turned on. The
+    // overdue substate change is then done by platformRadioProcess() at the next wake-up.
+    *aIsUnconditional = !(sTxInterfererLevel == 0 && sSubState == RFSIM_RADIO_SUBSTATE_STARTUP &&
+                          (sState == OT_RADIO_STATE_SLEEP || sState == OT_RADIO_STATE_DISABLED));
+    return true;
+}
+
+void platformRadioReportStateAndSleep(void)
+{
+    struct RadioStateEventData stateReport;
+    uint64_t                   delayUntilNextRadioState = 0;
+    bool                       isReport;
+
+    platformRadioReportEnergy(false);
+    isReport = getRadioStateReport(false, &stateReport, &delayUntilNextRadioState);
+    otSimSendRadioStateSleepEvent(isReport ? &stateReport : NULL, delayUntilNextRadioState);
+}
+
 static void applyRadioDelayedSleep() {
     if (sDelaySleep) {
         setRadioState(OT_RADIO_STATE_SLEEP);
@@ -1136,6 +1227,7 @@ void setRadioState(otRadioState aState)
         }
     }
     sState = aState;
+    updateEnergyAccumulators();
 }
 
 static void setRadioSubState(RadioSubState aState, uint64_t timeToRemainInState)
@@ -1148,6 +1240,7 @@ static void setRadioSubState(RadioSubState aState, uint64_t timeToRemainInState)
         sNextRadioEventTime = otPlatTimeGet() + timeToRemainInState;
     }
     sSubState = aState;
+    updateEnergyAccumulators();
 }
 
 static void startCcaForTransmission(otInstance *aInstance, uint64_t ccaDurationUs)
@@ -1202,12 +1295,20 @@ void platformRadioRxDone(otInstance *aInstance, const uint8_t *aBuf, uint16_t aB
 {
     OT_UNUSED_VARIABLE(aInstance);
     OT_ASSERT(sizeof(sReceiveMessage) >= aBufLength);
+    otError error;
 
     // only process in valid substates:
     otEXPECT(sSubState == RFSIM_RADIO_SUBSTATE_RX_FRAME_ONGOING || sSubState == RFSIM_RADIO_SUBSTATE_TX_ACK_RX_ONGOING );
 
     memcpy(&sReceiveMessage, aBuf, aBufLength);
     sReceiveFrame.mLength             = (uint8_t) aBufLength - offsetof(struct RadioMessage, mPsdu);
+
+    // a frame reported as received ok by the simulator must still have a valid FCS.
+    error = aRxParams->mError;
+    if (error == OT_ERROR_NONE && !radioIsCrcValid(&sReceiveMessage, sReceiveFrame.mLength))
+    {
+        error = OT_ERROR_FCS;
+    }
     sReceiveFrame.mInfo.mRxInfo.mRssi = aRxParams->mPower;
     sReceiveFrame.mInfo.mRxInfo.mLqi  = OT_RADIO_LQI_NONE; // No support of LQI reporting.
 
@@ -1216,7 +1317,7 @@ void platformRadioRxDone(otInstance *aInstance, const uint8_t *aBuf, uint16_t aB
     bool isAddressedToMe = otMacFrameDoesAddrMatch(&sReceiveFrame, sPanId, sShortAddress, &sExtAddress);
 
     if (sSubState == RFSIM_RADIO_SUBSTATE_RX_FRAME_ONGOING && isAckRequested && !isAck && isAddressedToMe &&
-        aRxParams->mError == OT_ERROR_NONE)
+        error == OT_ERROR_NONE)
     {
         // Rx done ok, need to send Ack. Wait exactly time AIFS before sending out the Ack.
         setRadioSubState(RFSIM_RADIO_SUBSTATE_RX_AIFS_WAIT, OT_RADIO_AIFS_TIME_US);
@@ -1235,7 +1336,7 @@ void platformRadioRxDone(otInstance *aInstance, const uint8_t *aBuf, uint16_t aB
         setRadioSubState(RFSIM_RADIO_SUBSTATE_IFS_WAIT, ifsTime);
     }
 
-    radioReceive(aInstance, aRxParams->mError );
+    radioReceive(aInstance, error);
 
     exit:
     return;
@@ -1314,12 +1415,25 @@ void platformRadioRfSimParamGet(otInstance *aInstance, struct RfSimParamEventDat
         case RFSIM_PARAM_CSL_UNCERTAINTY:
             value = (int32_t) sCslUncertainty;
             break;
+#if OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
         case RFSIM_PARAM_TX_INTERFERER:
             value = (int32_t) sTxInterfererLevel;
             break;
+#endif
         case RFSIM_PARAM_CLOCK_DRIFT:
             value = platformAlarmGetClockDrift();
             break;
+        case RFSIM_PARAM_LOG_LEVEL:
+            value = (int32_t) platformLoggingGetLevel();
+            break;
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+        case RFSIM_PARAM_PROFILE:
+            // if enabled, the counters are pushed first, so that they are available once the response arrives.
+            value = (int32_t) gProfileEnabled;
+            if (gProfileEnabled)
+                platformProfileReport();
+            break;
+#endif
         default:
             param = RFSIM_PARAM_UNKNOWN;
             value = 0;
@@ -1344,18 +1458,34 @@ void platformRadioRfSimParamSet(otInstance *aInstance, struct RfSimParamEventDat
         case RFSIM_PARAM_CSL_UNCERTAINTY:
             sCslUncertainty = (uint8_t) params->mValue;
             break;
+#if OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
         case RFSIM_PARAM_TX_INTERFERER:
             sTxInterfererLevel = (uint8_t) params->mValue;
             if (sTxInterfererLevel > 100)
                 sTxInterfererLevel = 100; // cap to 100
             if (sTxInterfererLevel > 0) // start operating as Wi-Fi interferer node
+            {
                 sTurnaroundTimeUs = OT_RADIO_WIFI_SLOT_TIME_US;
+                platformSetProcessHandler(RFSIM_PROCESS_HANDLER_TX_INTERFERER, platformRadioInterfererProcess);
+            }
             else
+            {
                 sTurnaroundTimeUs = RFSIM_TURNAROUND_TIME_US;
+                platformSetProcessHandler(RFSIM_PROCESS_HANDLER_TX_INTERFERER, NULL);
+            }
             break;
+#endif
         case RFSIM_PARAM_CLOCK_DRIFT:
             platformAlarmSetClockDrift((int8_t) params->mValue);
             break;
+        case RFSIM_PARAM_LOG_LEVEL:
+            platformLoggingSetLevel((otLogLevel) params->mValue);
+            break;
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+        case RFSIM_PARAM_PROFILE:
+            platformProfileSetEnabled(params->mValue != 0);
+            break;
+#endif
         default:
             break;
     }
@@ -1493,6 +1623,7 @@ void platformRadioProcess(otInstance *aInstance)
     }
 }
 
+#if OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
 void platformRadioInterfererProcess(otInstance *aInstance) {
     if (sTxInterfererLevel == 0)
         return;
@@ -1559,3 +1690,4 @@ void platformRadioInterfererProcess(otInstance *aInstance) {
         }
     }
 }
+#endif // OPENTHREAD_CONFIG_RFSIM_TX_INTERFERER_ENABLE
@@ -77,6 +77,8 @@ typedef enum
     RFSIM_PARAM_CSL_UNCERTAINTY,
     RFSIM_PARAM_TX_INTERFERER,
     RFSIM_PARAM_CLOCK_DRIFT,
+    RFSIM_PARAM_LOG_LEVEL,
+    RFSIM_PARAM_PROFILE,
     RFSIM_PARAM_UNKNOWN = 255,
 } RfSimParam;
 
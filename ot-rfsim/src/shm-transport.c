@@ -0,0 +1,203 @@
+/*
+ *  Copyright (c) 2024, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief
+ *   This file implements the optional shared-memory event transport between node and simulator.
+ */
+
+#include "platform-rfsim.h"
+
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+
+#include <sys/mman.h>
+
+#include "common/debug.hpp"
+#include "common/logging.hpp"
+
+#define SHM_NAME_MAX_LEN 64
+
+static struct ShmRegion *sShmRegion = NULL;
+static char              sShmName[SHM_NAME_MAX_LEN];
+static bool              sShmIsLinked   = false;
+static bool              sShmIsAccepted = false;
+
+static void unlinkShm(void)
+{
+    if (sShmIsLinked)
+    {
+        shm_unlink(sShmName);
+        sShmIsLinked = false;
+    }
+}
+
+void platformShmInit(void)
+{
+    int fd;
+
+    sShmIsAccepted = false;
+    snprintf(sShmName, sizeof(sShmName), "/otns_%d_%u", (int)getpid(), gNodeId);
+
+    fd = shm_open(sShmName, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        // not fatal: the socket transport is used instead.
+        perror("shm_open");
+        return;
+    }
+    sShmIsLinked = true;
+
+    if (ftruncate(fd, sizeof(struct ShmRegion)) < 0)
+    {
+        perror("ftruncate");
+        close(fd);
+        unlinkShm();
+        return;
+    }
+
+    sShmRegion = mmap(NULL, sizeof(struct ShmRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (sShmRegion == MAP_FAILED)
+    {
+        perror("mmap");
+        sShmRegion = NULL;
+        unlinkShm();
+        return;
+    }
+
+    memset(sShmRegion, 0, offsetof(struct ShmRegion, mToSimulator));
+    sShmRegion->mToSimulator.mHead = 0;
+    sShmRegion->mToSimulator.mTail = 0;
+    sShmRegion->mToNode.mHead      = 0;
+    sShmRegion->mToNode.mTail      = 0;
+    sShmRegion->mMagic             = OT_SHM_MAGIC;
+    sShmRegion->mVersion           = OT_SHM_VERSION;
+    __atomic_store_n(&sShmRegion->mRingSize, OT_SHM_RING_SIZE, __ATOMIC_RELEASE);
+}
+
+void platformShmDeinit(void)
+{
+    unlinkShm();
+    if (sShmRegion != NULL)
+    {
+        munmap(sShmRegion, sizeof(struct ShmRegion));
+        sShmRegion = NULL;
+    }
+    sShmIsAccepted = false;
+}
+
+const char *platformShmGetName(void)
+{
+    return (sShmRegion != NULL) ? sShmName : NULL;
+}
+
+void platformShmAccepted(void)
+{
+    OT_ASSERT(sShmRegion != NULL);
+
+    // simulator has mapped the region now, so the name isn't needed anymore.
+    unlinkShm();
+    sShmIsAccepted = true;
+}
+
+bool platformShmIsActive(void)
+{
+    return sShmIsAccepted;
+}
+
+static uint32_t ringCopyIn(struct ShmRing *aRing, uint32_t aHead, const void *aSrc, size_t aLen)
+{
+    size_t offset = aHead & (OT_SHM_RING_SIZE - 1);
+    size_t chunk  = OT_SHM_RING_SIZE - offset;
+
+    // copy in at most two parts, in case the data wraps around the end of the ring.
+    if (chunk > aLen)
+    {
+        chunk = aLen;
+    }
+    memcpy(&aRing->mData[offset], aSrc, chunk);
+    memcpy(&aRing->mData[0], (const uint8_t *)aSrc + chunk, aLen - chunk);
+
+    return aHead + (uint32_t)aLen;
+}
+
+bool platformShmWriteEvent(const uint8_t *aHeader, size_t aHeaderLen, const struct iovec *aPayload, size_t aPayloadCount)
+{
+    struct ShmRing *ring  = &sShmRegion->mToSimulator;
+    uint32_t        head  = ring->mHead;
+    uint32_t        tail  = __atomic_load_n(&ring->mTail, __ATOMIC_ACQUIRE);
+    size_t          evLen = aHeaderLen;
+
+    for (size_t i = 0; i < aPayloadCount; i++)
+    {
+        evLen += aPayload[i].iov_len;
+    }
+    if (OT_SHM_RING_SIZE - (head - tail) < evLen)
+    {
+        return false;
+    }
+
+    head = ringCopyIn(ring, head, aHeader, aHeaderLen);
+    for (size_t i = 0; i < aPayloadCount; i++)
+    {
+        head = ringCopyIn(ring, head, aPayload[i].iov_base, aPayload[i].iov_len);
+    }
+
+    __atomic_store_n(&ring->mHead, head, __ATOMIC_RELEASE);
+    return true;
+}
+
+size_t platformShmRead(uint8_t *aBuf, size_t aLen)
+{
+    struct ShmRing *ring  = &sShmRegion->mToNode;
+    uint32_t        tail  = ring->mTail;
+    uint32_t        head  = __atomic_load_n(&ring->mHead, __ATOMIC_ACQUIRE);
+    size_t          avail = head - tail;
+    size_t          offset, chunk;
+
+    if (aLen > avail)
+    {
+        aLen = avail;
+    }
+
+    // copy out in at most two parts, in case the data wraps around the end of the ring.
+    offset = tail & (OT_SHM_RING_SIZE - 1);
+    chunk  = OT_SHM_RING_SIZE - offset;
+    if (chunk > aLen)
+    {
+        chunk = aLen;
+    }
+    memcpy(aBuf, &ring->mData[offset], chunk);
+    memcpy(aBuf + chunk, &ring->mData[0], aLen - chunk);
+
+    __atomic_store_n(&ring->mTail, tail + (uint32_t)aLen, __ATOMIC_RELEASE);
+    return aLen;
+}
+
+#endif // OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
@@ -45,16 +45,19 @@
 
 #include "common/debug.hpp"
 
-extern void platformReceiveEvent(otInstance *aInstance);
 extern bool gPlatformPseudoResetWasRequested;
 
 static void socket_init(char *socketFilePath);
+static void platformInstanceInit(otInstance *aInstance);
 static void handleSignal(int aSignal);
 
 volatile bool gTerminate = false;
 uint32_t gNodeId = 0;
 int gSockFd = 0;
 static uint16_t sIsInstanceInitDone = false;
+static RfSimProcessHandler sProcessHandlers[RFSIM_PROCESS_NUM_HANDLERS];
+static RfSimProcessHandler sActiveProcessHandlers[RFSIM_PROCESS_NUM_HANDLERS];
+static uint8_t sNumActiveProcessHandlers = 0;
 
 void otSysInit(int argc, char *argv[]) {
     char *endptr;
@@ -65,13 +68,18 @@ void otSysInit(int argc, char *argv[]) {
         return;
     }
 
+    // in zygote mode, this only returns in a forked child with regular node arguments.
+    platformZygoteRun(&argc, argv);
+
     signal(SIGTERM, &handleSignal);
     signal(SIGHUP, &handleSignal);
 
     if (argc < 3 || argc > 4) {
+        char *exeName = basename(argv[0]);
         fprintf(stderr,
-                "Usage: %s <NodeId> <OTNS-Unix-socket-file> [<random-seed>]\n",
-                basename(argv[0]));
+                "Usage: %s <NodeId> <OTNS-Unix-socket-file> [<random-seed>]\n"
+                "       %s zygote <OTNS-Unix-socket-file> <control-fd>\n",
+                exeName, exeName);
         platformExit(EXIT_FAILURE);
     }
 
@@ -100,8 +108,21 @@ void otSysInit(int argc, char *argv[]) {
     platformAlarmInit();
     platformRadioInit();
     platformRfsimInit();
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    platformShmInit();
+#endif
 
     otSimSendNodeInfoEvent(gNodeId);
+#if OPENTHREAD_CONFIG_RFSIM_COMPACT_HEADER_ENABLE
+    otSimSendHeaderFormatOfferEvent(OT_EVENT_HEADER_FORMAT_COMPACT);
+#endif
+#if OPENTHREAD_CONFIG_RFSIM_RADIO_STATE_SLEEP_ENABLE
+    otSimSendRadioStateSleepOfferEvent();
+#if OPENTHREAD_CONFIG_RFSIM_SLEEP_WAKEUPS_ENABLE
+    otSimSendSleepWakeupsOfferEvent();
+#endif
+#endif
+    otSimSendRadioEnergyOfferEvent();
 }
 
 bool otSysPseudoResetWasRequested(void) {
@@ -109,10 +130,30 @@ bool otSysPseudoResetWasRequested(void) {
 }
 
 void otSysDeinit(void) {
+    platformUartFlush();
+    platformLoggingFlush();
+    otSimFlushEvents();
+    platformFlashDeinit();
+#if OPENTHREAD_CONFIG_RFSIM_SHM_TRANSPORT_ENABLE
+    platformShmDeinit();
+#endif
     close(gSockFd);
     gSockFd = 0;
 }
 
+void platformSetProcessHandler(RfSimProcessHandlerId aId, RfSimProcessHandler aHandler) {
+    OT_ASSERT(aId < RFSIM_PROCESS_NUM_HANDLERS);
+    sProcessHandlers[aId] = aHandler;
+
+    // keep the registered handlers compact, in the order of their id, for otSysProcessDrivers().
+    sNumActiveProcessHandlers = 0;
+    for (uint8_t i = 0; i < RFSIM_PROCESS_NUM_HANDLERS; i++) {
+        if (sProcessHandlers[i] != NULL) {
+            sActiveProcessHandlers[sNumActiveProcessHandlers++] = sProcessHandlers[i];
+        }
+    }
+}
+
 void otSysProcessDrivers(otInstance *aInstance) {
     fd_set read_fds;
     fd_set write_fds;
@@ -124,12 +165,13 @@ void otSysProcessDrivers(otInstance *aInstance) {
         platformExit(EXIT_SUCCESS);
     }
 
-    // on the first call, perform any init that requires the aInstance.
-    if (!sIsInstanceInitDone) { // TODO move to own function
-#if OPENTHREAD_CONFIG_UDP_FORWARD_ENABLE && OPENTHREAD_CONFIG_BORDER_ROUTING_ENABLE
-        otUdpForwardSetForwarder(aInstance, handleUdpForwarding, aInstance);
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+    platformProfileDriversEnter();
 #endif
-        platformNetifSetUp(aInstance);
+
+    // on the first call, perform any init that requires the aInstance.
+    if (!sIsInstanceInitDone) {
+        platformInstanceInit(aInstance);
         sIsInstanceInitDone = true;
     }
 
@@ -142,29 +184,52 @@ void otSysProcessDrivers(otInstance *aInstance) {
 
     if (!otTaskletsArePending(aInstance) && platformAlarmGetNext() > 0 &&
         (!platformRadioIsTransmitPending() || platformRadioIsBusy())) {
-        // report my final radio state at end of this time instant, then go to sleep.
-        platformRadioReportStateToSimulator(false);
-        otSimSendSleepEvent();
+        if (platformIsEventPending()) {
+            // handle already received event(s), without going to sleep.
+            platformReceiveEvent(aInstance);
+        } else {
+            // report my final radio state at end of this time instant, then go to sleep.
+            platformFlashSleep();
+            platformRadioReportStateAndSleep();
+
+            // wake up by reception of socket event from simulator.
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+            uint64_t selectStartNs = RFSIM_PROFILE_TIME_NS();
+            rval = select(max_fd + 1, &read_fds, &write_fds, &error_fds, NULL);
+            RFSIM_PROFILE_ADD(RFSIM_PROFILE_SELECT_NS, platformProfileGetTimeNs() - selectStartNs);
+#else
+            rval = select(max_fd + 1, &read_fds, &write_fds, &error_fds, NULL);
+#endif
 
-        // wake up by reception of socket event from simulator.
-        rval = select(max_fd + 1, &read_fds, &write_fds, &error_fds, NULL);
+            if ((rval < 0) && (errno != EINTR)) {
+                perror("select");
+                platformExit(EXIT_FAILURE);
+            }
 
-        if ((rval < 0) && (errno != EINTR)) {
-            perror("select");
-            platformExit(EXIT_FAILURE);
-        }
-
-        if (rval > 0 && FD_ISSET(gSockFd, &read_fds)) {
-            platformReceiveEvent(aInstance);
+            if (rval > 0 && FD_ISSET(gSockFd, &read_fds)) {
+                platformReceiveEvent(aInstance);
+            }
         }
     }
 
     platformAlarmProcess(aInstance);
     platformRadioProcess(aInstance);
-    platformRadioInterfererProcess(aInstance);
-#if OPENTHREAD_CONFIG_BLE_TCAT_ENABLE
-    platformBleProcess(aInstance);
+    for (uint8_t i = 0; i < sNumActiveProcessHandlers; i++) {
+        sActiveProcessHandlers[i](aInstance);
+    }
+#if OPENTHREAD_CONFIG_RFSIM_PROFILE_ENABLE
+    platformProfileDriversExit();
+#endif
+}
+
+/**
+ * Performs the platform init that requires the OT instance, once it exists.
+ */
+static void platformInstanceInit(otInstance *aInstance) {
+#if OPENTHREAD_CONFIG_UDP_FORWARD_ENABLE && OPENTHREAD_CONFIG_BORDER_ROUTING_ENABLE
+    otUdpForwardSetForwarder(aInstance, handleUdpForwarding, aInstance);
 #endif
+    platformNetifSetUp(aInstance);
 }
 
 /**
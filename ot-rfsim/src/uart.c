@@ -37,6 +37,11 @@
 #include "event-sim.h"
 #include "utils/uart.h"
 
+// UART output is collected, and sent to the simulator in a single event per time instant; or earlier,
+// when the buffer is full.
+static uint8_t sUartTxBuf[OT_EVENT_DATA_MAX_SIZE];
+static size_t  sUartTxBufLen = 0;
+
 otError otPlatUartEnable(void)
 {
     return OT_ERROR_NONE;
@@ -49,7 +54,24 @@ otError otPlatUartDisable(void)
 
 otError otPlatUartSend(const uint8_t *aData, uint16_t aLength)
 {
-    otSimSendUartWriteEvent(aData, aLength);
+    while (aLength > 0)
+    {
+        size_t len = sizeof(sUartTxBuf) - sUartTxBufLen;
+
+        if (len == 0)
+        {
+            platformUartFlush();
+            continue;
+        }
+        if (len > aLength)
+        {
+            len = aLength;
+        }
+        memcpy(sUartTxBuf + sUartTxBufLen, aData, len);
+        sUartTxBufLen += len;
+        aData += len;
+        aLength -= (uint16_t)len;
+    }
     otPlatUartSendDone();
 
     return OT_ERROR_NONE;
@@ -57,9 +79,23 @@ otError otPlatUartSend(const uint8_t *aData, uint16_t aLength)
 
 otError otPlatUartFlush(void)
 {
+    platformUartFlush();
+
     return OT_ERROR_NONE;
 }
 
+void platformUartFlush(void)
+{
+    size_t len = sUartTxBufLen;
+
+    if (len == 0)
+        return;
+
+    // reset first, since a failing event write exits via platformExit(), which calls this function again.
+    sUartTxBufLen = 0;
+    otSimSendUartWriteEvent(sUartTxBuf, (uint16_t)len);
+}
+
 void platformUartRestore(void)
 {
 }
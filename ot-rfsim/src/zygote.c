@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2024, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the zygote (fork-server) mode for fast node startup.
+ *
+ *   In zygote mode the node executable is loaded, linked and statically initialized once. The simulator then
+ *   requests new nodes over a control socket; each request is served by a fork() of the zygote, so that the
+ *   children share the read-only pages of the zygote copy-on-write. A child continues with the regular
+ *   otSysInit() as if it was started by the simulator with the requested arguments.
+ */
+
+#include "platform-rfsim.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define ZYGOTE_ARG "zygote"
+#define ZYGOTE_NUM_FDS 3 // stdin, stdout, stderr of the child
+
+/**
+ * A node start request, as sent by the simulator over the (SOCK_SEQPACKET) control socket. The stdin, stdout
+ * and stderr file descriptors for the new node are passed along with it as SCM_RIGHTS ancillary data.
+ * The reply is the int32_t PID of the child, or -1 on failure.
+ */
+struct ZygoteRequest
+{
+    uint32_t mNodeId;
+    int32_t mRandomSeed; // 0 if not set
+};
+
+static char sNodeIdArg[16];
+static char sRandomSeedArg[16];
+
+static ssize_t receiveRequest(int aCtlFd, struct ZygoteRequest *aRequest, int aFds[ZYGOTE_NUM_FDS])
+{
+    char cmsgBuf[CMSG_SPACE(sizeof(int) * ZYGOTE_NUM_FDS)];
+    struct iovec iov = {aRequest, sizeof(*aRequest)};
+    struct msghdr msg;
+    struct cmsghdr *cmsg;
+    int numFds = 0;
+    ssize_t rval;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = cmsgBuf;
+    msg.msg_controllen = sizeof(cmsgBuf);
+
+    rval = recvmsg(aCtlFd, &msg, 0);
+    if (rval <= 0) {
+        return rval;
+    }
+
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            int *fds = (int *) CMSG_DATA(cmsg);
+            int n = (int) ((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+
+            for (int i = 0; i < n; i++) {
+                if (numFds < ZYGOTE_NUM_FDS) {
+                    aFds[numFds++] = fds[i];
+                } else {
+                    close(fds[i]);
+                }
+            }
+        }
+    }
+
+    if (rval != sizeof(*aRequest) || numFds != ZYGOTE_NUM_FDS || (msg.msg_flags & MSG_CTRUNC)) {
+        for (int i = 0; i < numFds; i++) {
+            close(aFds[i]);
+        }
+        errno = EBADMSG;
+        return -1;
+    }
+    return rval;
+}
+
+static void setupChild(int aCtlFd, const struct ZygoteRequest *aRequest, const int aFds[ZYGOTE_NUM_FDS],
+                       int *aArgc, char *aArgv[])
+{
+    close(aCtlFd);
+    signal(SIGCHLD, SIG_DFL);
+
+    for (int i = 0; i < ZYGOTE_NUM_FDS; i++) {
+        if (dup2(aFds[i], i) < 0) {
+            perror("zygote dup2");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < ZYGOTE_NUM_FDS; i++) {
+        if (aFds[i] >= ZYGOTE_NUM_FDS) {
+            close(aFds[i]);
+        }
+    }
+
+    // rewrite the arguments in place, so that a later execvp() on node reset starts a regular node.
+    snprintf(sNodeIdArg, sizeof(sNodeIdArg), "%u", aRequest->mNodeId);
+    aArgv[1] = sNodeIdArg;
+    if (aRequest->mRandomSeed != 0) {
+        snprintf(sRandomSeedArg, sizeof(sRandomSeedArg), "%d", aRequest->mRandomSeed);
+        aArgv[3] = sRandomSeedArg;
+        *aArgc = 4;
+    } else {
+        aArgv[3] = NULL;
+        *aArgc = 3;
+    }
+}
+
+void platformZygoteRun(int *aArgc, char *aArgv[])
+{
+    char *endptr;
+    long ctlFd;
+
+    if (*aArgc != 4 || strcmp(aArgv[1], ZYGOTE_ARG) != 0) {
+        return;
+    }
+
+    ctlFd = strtol(aArgv[3], &endptr, 0);
+    if (*endptr != '\0' || ctlFd <= STDERR_FILENO || ctlFd > INT32_MAX) {
+        fprintf(stderr, "Invalid zygote control fd: %s\n", aArgv[3]);
+        exit(EXIT_FAILURE);
+    }
+
+    // children are reaped automatically; the simulator tracks them by their PID.
+    signal(SIGCHLD, SIG_IGN);
+
+    while (true) {
+        struct ZygoteRequest request;
+        int fds[ZYGOTE_NUM_FDS];
+        int32_t reply;
+        ssize_t rval = receiveRequest((int) ctlFd, &request, fds);
+
+        if (rval == 0) {
+            exit(EXIT_SUCCESS); // simulator closed the control socket.
+        } else if (rval < 0) {
+            if (errno == EINTR) {
+                continue;
+            } else if (errno == EBADMSG) {
+                reply = -1;
+                send((int) ctlFd, &reply, sizeof(reply), 0);
+                continue;
+            }
+            perror("zygote recvmsg");
+            exit(EXIT_FAILURE);
+        }
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            setupChild((int) ctlFd, &request, fds, aArgc, aArgv);
+            return;
+        }
+
+        for (int i = 0; i < ZYGOTE_NUM_FDS; i++) {
+            close(fds[i]);
+        }
+        reply = (pid > 0) ? (int32_t) pid : -1;
+        if (send((int) ctlFd, &reply, sizeof(reply), 0) < 0) {
+            perror("zygote send");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
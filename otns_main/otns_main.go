@@ -69,9 +69,19 @@ type MainArgs struct {
 	DispatcherPort int
 	DumpPackets    bool
 	PcapType       string
+	PcapCompress   bool
+	PcapRingSize   int
+	PcapNodes      string
+	PcapChannels   string
 	NoReplay       bool
 	RandomSeed     int64
 	PhyTxStats     bool
+	ShmTransport   bool
+	CompactHeader  bool
+	Pdes           bool
+	TraceFile      string
+	FlashSync      string
+	Zygote         bool
 }
 
 var (
@@ -104,12 +114,38 @@ func parseArgs() {
 	flag.StringVar(&args.ListenAddr, "listen", fmt.Sprintf("localhost:%d", InitialDispatcherPort), "specify UDP listen address and port-base")
 	flag.BoolVar(&args.DumpPackets, "dump-packets", false, "dump packets")
 	flag.StringVar(&args.PcapType, "pcap", pcap.FrameTypeWpanStr, "PCAP file type: 'off', 'wpan', or 'wpan-tap' (name is \"current.pcap\")")
+	flag.BoolVar(&args.PcapCompress, "pcap-compress", false, "gzip-compress the PCAP file (name is \"current.pcap.gz\")")
+	flag.IntVar(&args.PcapRingSize, "pcap-ring", 0, "keep only the last frames of about this many MB in the PCAP file, and an older one with suffix \".1\"")
+	flag.StringVar(&args.PcapNodes, "pcap-nodes", "", "comma-separated list of node IDs: only capture frames sent by these nodes")
+	flag.StringVar(&args.PcapChannels, "pcap-channels", "", "comma-separated list of channels: only capture frames on these channels")
 	flag.BoolVar(&args.NoReplay, "no-replay", false, "do not generate Replay file (named \"otns_?.replay\")")
 	flag.Int64Var(&args.RandomSeed, "seed", 0, "set specific random-seed value (for reproducability)")
 	flag.BoolVar(&args.PhyTxStats, "phy-tx-stats", false, "generate PHY Tx statistics CSV file")
+	flag.BoolVar(&args.ShmTransport, "shm", false, "use shared-memory event transport with nodes that offer it")
+	flag.BoolVar(&args.CompactHeader, "compact-header", false, "use compact event header format with nodes that offer it")
+	flag.BoolVar(&args.Pdes, "pdes", false, "run radio-isolated partitions of nodes in parallel, each at their own time")
+	flag.StringVar(&args.TraceFile, "trace", "", "record an event trace in this file, to replay it with 'otns-replay -trace'")
+	flag.StringVar(&args.FlashSync, "flash-sync", "exit", "node flash file sync policy: 'exit', 'sleep', 'write', or 'ram' (no flash file)")
+	flag.BoolVar(&args.Zygote, "zygote", false, "start nodes by forking a pre-started zygote process per node executable")
 	flag.Parse()
 }
 
+// parseIntList parses a comma-separated list of integers, which may be empty.
+func parseIntList[T NodeId | ChannelId](s string) ([]T, error) {
+	var list []T
+	if s == "" {
+		return list, nil
+	}
+	for _, item := range strings.Split(s, ",") {
+		v, err := strconv.Atoi(strings.TrimSpace(item))
+		if err != nil || v < 0 || int(T(v)) != v {
+			return nil, fmt.Errorf("invalid item '%s'", item)
+		}
+		list = append(list, T(v))
+	}
+	return list, nil
+}
+
 func parseListenAddr() (int, error) {
 	var err error
 
@@ -293,6 +329,13 @@ func createSimulation(simId int, ctx *progctx.ProgCtx) (*simulation.Simulation,
 		}
 	}
 	simcfg.RandomSeed = prng.RandomSeed(args.RandomSeed)
+	simcfg.Zygote = args.Zygote
+	switch args.FlashSync {
+	case "exit", "sleep", "write", "ram":
+		simcfg.FlashSync = args.FlashSync
+	default:
+		return nil, fmt.Errorf("invalid flash sync policy: %s (must be exit, sleep, write or ram)", args.FlashSync)
+	}
 
 	dispatcherCfg := dispatcher.DefaultConfig()
 	dispatcherCfg.SimulationId = simcfg.Id
@@ -301,6 +344,14 @@ func createSimulation(simId int, ctx *progctx.ProgCtx) (*simulation.Simulation,
 	if dispatcherCfg.PcapFrameType == pcap.FrameTypeUnknown {
 		logger.Fatalf("Unknown PCAP frame type '%s', use -h flag for an overview.", args.PcapType)
 	}
+	dispatcherCfg.PcapOptions.Compress = args.PcapCompress
+	dispatcherCfg.PcapOptions.RingSize = int64(args.PcapRingSize) * 1024 * 1024
+	if dispatcherCfg.PcapNodes, err = parseIntList[NodeId](args.PcapNodes); err != nil {
+		return nil, fmt.Errorf("invalid -pcap-nodes list: %v", err)
+	}
+	if dispatcherCfg.PcapChannels, err = parseIntList[ChannelId](args.PcapChannels); err != nil {
+		return nil, fmt.Errorf("invalid -pcap-channels list: %v", err)
+	}
 	dispatcherCfg.DefaultWatchLevel = args.WatchLevel
 	watchLevel, err := logger.ParseLevelString(args.WatchLevel)
 	if err != nil {
@@ -308,6 +359,11 @@ func createSimulation(simId int, ctx *progctx.ProgCtx) (*simulation.Simulation,
 	}
 	dispatcherCfg.DefaultWatchOn = watchLevel != logger.OffLevel
 	dispatcherCfg.PhyTxStats = args.PhyTxStats
+	dispatcherCfg.ShmTransport = args.ShmTransport
+	dispatcherCfg.CompactHeader = args.CompactHeader
+	dispatcherCfg.Pdes = args.Pdes
+	dispatcherCfg.TraceFile = args.TraceFile
+	dispatcherCfg.RandomSeed = args.RandomSeed
 
 	sim, err := simulation.NewSimulation(ctx, simcfg, dispatcherCfg)
 	return sim, err
@@ -29,7 +29,6 @@ package pcap
 import (
 	"encoding/binary"
 	"fmt"
-	"os"
 
 	"github.com/openthread/ot-ns/logger"
 	. "github.com/openthread/ot-ns/types"
@@ -80,24 +79,33 @@ type Frame struct {
 }
 
 type wpanFile struct {
-	fd *os.File
+	*output
 }
 
 // NewFile creates a new PCAP file with all frames using specified frameType
 func NewFile(filename string, frameType FrameType, useTimeRefFrame bool) (File, error) {
+	return NewFileWithOptions(filename, frameType, useTimeRefFrame, Options{})
+}
+
+// NewFileWithOptions creates a new PCAP file with all frames using specified frameType, written as
+// specified by the opts.
+func NewFileWithOptions(filename string, frameType FrameType, useTimeRefFrame bool, opts Options) (File, error) {
 	var f File
 	var err error
 
 	switch frameType {
 	case FrameTypeWpan:
-		f, err = newWpanFile(filename)
+		f, err = newWpanFile(filename, opts)
 	case FrameTypeWpanTap:
-		f, err = newWpanTapFile(filename)
+		f, err = newWpanTapFile(filename, opts)
 	default:
 		f, err = nil, fmt.Errorf("invalid PCAP frame type: %d", frameType)
 	}
+	if err != nil {
+		return nil, err
+	}
 
-	if useTimeRefFrame && err == nil && f != nil {
+	if useTimeRefFrame {
 		logger.PanicfIfError(f.AppendFrame(Frame{
 			Timestamp: 0,
 			Data:      []byte(timeReference802154frameData),
@@ -105,8 +113,9 @@ func NewFile(filename string, frameType FrameType, useTimeRefFrame bool) (File,
 			Rssi:      0,
 		}), "PCAP file time-reference 0 frame could not be written")
 	}
+	f.(interface{ endPrefix() }).endPrefix() // data written so far is repeated at the start of each ring file.
 
-	return f, err
+	return f, nil
 }
 
 func ParseFrameTypeStr(tp string) FrameType {
@@ -122,14 +131,14 @@ func ParseFrameTypeStr(tp string) FrameType {
 	}
 }
 
-func newWpanFile(filename string) (File, error) {
-	fd, err := os.OpenFile(filename, os.O_CREATE|os.O_TRUNC|os.O_WRONLY, 0644)
+func newWpanFile(filename string, opts Options) (File, error) {
+	o, err := newOutput(filename, opts)
 	if err != nil {
 		return nil, err
 	}
 
 	pf := &wpanFile{
-		fd: fd,
+		output: o,
 	}
 
 	if err = pf.writeHeader(); err != nil {
@@ -150,23 +159,7 @@ func (pf *wpanFile) AppendFrame(frame Frame) error {
 	binary.LittleEndian.PutUint32(header[8:12], plen)
 	binary.LittleEndian.PutUint32(header[12:16], plen)
 
-	var err error
-
-	_, err = pf.fd.Write(header[:])
-	if err != nil {
-		return err
-	}
-
-	_, err = pf.fd.Write(frame.Data)
-	return err
-}
-
-func (pf *wpanFile) Sync() error {
-	return pf.fd.Sync()
-}
-
-func (pf *wpanFile) Close() error {
-	return pf.fd.Close()
+	return pf.write(header[:], frame.Data)
 }
 
 func (pf *wpanFile) writeHeader() error {
@@ -178,8 +171,8 @@ func (pf *wpanFile) writeHeader() error {
 	binary.LittleEndian.PutUint32(header[12:16], 0)
 	binary.LittleEndian.PutUint32(header[16:20], 256)
 	binary.LittleEndian.PutUint32(header[20:24], dltIeee802154)
-	if _, err := pf.fd.Write(header[:]); err != nil {
+	if err := pf.write(header[:], nil); err != nil {
 		return err
 	}
-	return pf.fd.Sync()
+	return pf.Sync()
 }
@@ -27,6 +27,8 @@
 package pcap
 
 import (
+	"compress/gzip"
+	"io"
 	"os"
 	"testing"
 
@@ -146,6 +148,97 @@ func TestPcapFileWithTimeRefFrame(t *testing.T) {
 	}
 }
 
+func TestPcapFileCompressed(t *testing.T) {
+	pcapFilename := "test_compressed.pcap"
+	pcap, err := NewFileWithOptions(pcapFilename, FrameTypeWpan, false, Options{Compress: true})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	for i := 0; i < 1000; i++ {
+		frame := Frame{
+			Timestamp: uint64(i) * 1000,
+			Data:      []byte{0x12, 0x10, 0xa6, 0x80, 0x65},
+			Channel:   12,
+			Rssi:      -60.0,
+		}
+		err = pcap.AppendFrame(frame)
+		if err != nil {
+			t.Fatal(err)
+		}
+	}
+	err = pcap.Close()
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	fd, err := os.Open(pcapFilename + ".gz")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer fd.Close()
+	gz, err := gzip.NewReader(fd)
+	if err != nil {
+		t.Fatal(err)
+	}
+	data, err := io.ReadAll(gz)
+	if err != nil {
+		t.Fatal(err)
+	}
+	assert.Equal(t, pcapFileHeaderSize+(pcapFrameHeaderSize+5)*1000, len(data))
+	assert.True(t, getFileSize(t, pcapFilename+".gz") < len(data))
+}
+
+func TestPcapFileRing(t *testing.T) {
+	pcapFilename := "test_ring.pcap"
+	const ringSize = 4000
+	pcap, err := NewFileWithOptions(pcapFilename, FrameTypeWpan, true, Options{RingSize: ringSize})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	defer func() {
+		_ = pcap.Close()
+	}()
+
+	err = pcap.Sync()
+	if err != nil {
+		t.Fatal(err)
+	}
+	pcapStartSize := getFileSize(t, pcapFilename)
+
+	for i := 0; i < 1000; i++ {
+		frame := Frame{
+			Timestamp: uint64(i) * 1000,
+			Data:      []byte{0x12, 0x10, 0xa6, 0x80, 0x65},
+			Channel:   12,
+			Rssi:      -60.0,
+		}
+		err = pcap.AppendFrame(frame)
+		if err != nil {
+			t.Fatal(err)
+		}
+	}
+	err = pcap.Sync()
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	// both files are at most half the ring size, and start with the file header and time-reference frame.
+	framesPerFile := (ringSize/2 - pcapStartSize) / (pcapFrameHeaderSize + 5)
+	assert.Equal(t, pcapStartSize+framesPerFile*(pcapFrameHeaderSize+5), getFileSize(t, pcapFilename+".1"))
+	assert.True(t, getFileSize(t, pcapFilename) <= ringSize/2)
+	current, err := os.ReadFile(pcapFilename)
+	if err != nil {
+		t.Fatal(err)
+	}
+	older, err := os.ReadFile(pcapFilename + ".1")
+	if err != nil {
+		t.Fatal(err)
+	}
+	assert.Equal(t, older[:pcapStartSize], current[:pcapStartSize])
+}
+
 func getFileSize(t *testing.T, fp string) int {
 	info, err := os.Stat(fp)
 	if err != nil {
@@ -0,0 +1,195 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package pcap
+
+import (
+	"bufio"
+	"compress/gzip"
+	"os"
+	"strings"
+	"sync"
+)
+
+const (
+	defaultBufferSize = 1 << 20
+	gzipSuffix        = ".gz"
+	ringFileSuffix    = ".1"
+)
+
+// Options configure how a PCAP File is written.
+type Options struct {
+	// Compress enables gzip-compression of the output. The suffix ".gz" is appended to the filename.
+	Compress bool
+	// RingSize, if > 0, is the max number of (uncompressed) bytes to keep. The frames are then written to
+	// two alternating files, the current one and an older one with suffix ".1", each at most half of RingSize.
+	RingSize int64
+	// BufferSize is the size of the write buffer; if 0, a default size is used.
+	BufferSize int
+}
+
+// output writes the PCAP data to file, through a large write buffer so that frames are written in batches.
+// It may be used concurrently, e.g. to Sync() while frames are appended.
+type output struct {
+	mu       sync.Mutex
+	filename string
+	opts     Options
+	fd       *os.File
+	gz       *gzip.Writer
+	buf      *bufio.Writer
+	size     int64  // bytes written to the current file, uncompressed.
+	prefix   []byte // file header and any initial frames, repeated at the start of each ring file.
+	isPrefix bool
+}
+
+func newOutput(filename string, opts Options) (*output, error) {
+	if opts.Compress {
+		filename += gzipSuffix
+	}
+	if opts.BufferSize <= 0 {
+		opts.BufferSize = defaultBufferSize
+	}
+	o := &output{
+		filename: filename,
+		opts:     opts,
+		isPrefix: true,
+	}
+	if err := o.open(); err != nil {
+		return nil, err
+	}
+	return o, nil
+}
+
+func (o *output) open() error {
+	fd, err := os.OpenFile(o.filename, os.O_CREATE|os.O_TRUNC|os.O_WRONLY, 0644)
+	if err != nil {
+		return err
+	}
+	o.fd = fd
+	if o.opts.Compress {
+		o.gz = gzip.NewWriter(fd)
+		o.buf = bufio.NewWriterSize(o.gz, o.opts.BufferSize)
+	} else {
+		o.buf = bufio.NewWriterSize(fd, o.opts.BufferSize)
+	}
+	o.size = 0
+	return nil
+}
+
+// write writes the header and data of a single PCAP record, or of the file header.
+func (o *output) write(header []byte, data []byte) error {
+	o.mu.Lock()
+	defer o.mu.Unlock()
+
+	n := int64(len(header) + len(data))
+	if o.isPrefix {
+		o.prefix = append(o.prefix, header...)
+		o.prefix = append(o.prefix, data...)
+	} else if o.opts.RingSize > 0 && o.size > int64(len(o.prefix)) && o.size+n > o.opts.RingSize/2 {
+		if err := o.rotate(); err != nil {
+			return err
+		}
+	}
+
+	if _, err := o.buf.Write(header); err != nil {
+		return err
+	}
+	if _, err := o.buf.Write(data); err != nil {
+		return err
+	}
+	o.size += n
+	return nil
+}
+
+// endPrefix marks the end of the data that's repeated at the start of each ring file.
+func (o *output) endPrefix() {
+	o.mu.Lock()
+	defer o.mu.Unlock()
+	o.isPrefix = false
+}
+
+// rotate turns the current file into the older ring file, and starts a new current file.
+func (o *output) rotate() error {
+	if err := o.close(); err != nil {
+		return err
+	}
+	if err := os.Rename(o.filename, o.getRingFilename()); err != nil {
+		return err
+	}
+	if err := o.open(); err != nil {
+		return err
+	}
+	if _, err := o.buf.Write(o.prefix); err != nil {
+		return err
+	}
+	o.size = int64(len(o.prefix))
+	return nil
+}
+
+func (o *output) getRingFilename() string {
+	if o.opts.Compress {
+		return strings.TrimSuffix(o.filename, gzipSuffix) + ringFileSuffix + gzipSuffix
+	}
+	return o.filename + ringFileSuffix
+}
+
+func (o *output) flush() error {
+	if err := o.buf.Flush(); err != nil {
+		return err
+	}
+	if o.gz != nil {
+		return o.gz.Flush()
+	}
+	return nil
+}
+
+func (o *output) Sync() error {
+	o.mu.Lock()
+	defer o.mu.Unlock()
+	if err := o.flush(); err != nil {
+		return err
+	}
+	return o.fd.Sync()
+}
+
+func (o *output) close() error {
+	err := o.buf.Flush()
+	if o.gz != nil {
+		if gzErr := o.gz.Close(); err == nil {
+			err = gzErr
+		}
+	}
+	if fdErr := o.fd.Close(); err == nil {
+		err = fdErr
+	}
+	return err
+}
+
+func (o *output) Close() error {
+	o.mu.Lock()
+	defer o.mu.Unlock()
+	return o.close()
+}
@@ -29,7 +29,6 @@ package pcap
 import (
 	"encoding/binary"
 	"math"
-	"os"
 )
 
 // wpan-tap / DLT IEEE802 15 4 TAP specification is at
@@ -48,17 +47,17 @@ const (
 )
 
 type tapFile struct {
-	fd *os.File
+	*output
 }
 
-func newWpanTapFile(filename string) (File, error) {
-	fd, err := os.OpenFile(filename, os.O_CREATE|os.O_TRUNC|os.O_WRONLY, 0644)
+func newWpanTapFile(filename string, opts Options) (File, error) {
+	o, err := newOutput(filename, opts)
 	if err != nil {
 		return nil, err
 	}
 
 	pf := &tapFile{
-		fd: fd,
+		output: o,
 	}
 
 	if err = pf.writeHeader(); err != nil {
@@ -113,23 +112,7 @@ func (pf *tapFile) AppendFrame(frame Frame) error {
 	channelAssign[2] = 0 // 0 == IEEE 802.15.4 channel page 0
 	setTlv(&header, &n, tlvChannelAssignment, channelAssign)
 
-	var err error
-
-	_, err = pf.fd.Write(header[:])
-	if err != nil {
-		return err
-	}
-
-	_, err = pf.fd.Write(frame.Data)
-	return err
-}
-
-func (pf *tapFile) Sync() error {
-	return pf.fd.Sync()
-}
-
-func (pf *tapFile) Close() error {
-	return pf.fd.Close()
+	return pf.write(header[:], frame.Data)
 }
 
 func (pf *tapFile) writeHeader() error {
@@ -141,8 +124,8 @@ func (pf *tapFile) writeHeader() error {
 	binary.LittleEndian.PutUint32(header[12:16], 0)
 	binary.LittleEndian.PutUint32(header[16:20], 256)
 	binary.LittleEndian.PutUint32(header[20:24], dltIeee802154Tap)
-	if _, err := pf.fd.Write(header[:]); err != nil {
+	if err := pf.write(header[:], nil); err != nil {
 		return err
 	}
-	return pf.fd.Sync()
+	return pf.Sync()
 }
@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024, The OTNS Authors.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the
+#    names of its contributors may be used to endorse or promote products
+#    derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# End-to-end simulation benchmark suite.
+#
+# Each scenario is a fixed topology and traffic pattern, run with a fixed random seed so that successive runs
+# (e.g. before and after a change) simulate the same network. For each scenario, one JSON result line is
+# reported with the simulated-seconds per wall-second rate, the dispatcher event rate, and the CPU time and peak
+# RSS of both the OTNS (dispatcher) process and the aggregate of all simulated node processes.
+#
+# With --trace-dir, the dispatcher event stream of each scenario is recorded to a trace file (otns -trace), and with
+# --replay each recorded trace is replayed against the dispatcher alone (otns-replay -trace), which isolates the
+# dispatcher cost from the node processes.
+#
+# Usage: run_benchmarks.py [--output <file>] [--trace-dir <dir>] [--replay] [<scenario> ...]
+#
+
+import argparse
+import json
+import logging
+import os
+import shutil
+import subprocess
+import sys
+import time
+from typing import Callable, Dict, List, Tuple
+
+from otns.cli import OTNS
+
+SCRIPT_DIR = os.path.abspath(os.path.dirname(__file__))
+TOPOLOGIES_DIR = os.path.join(SCRIPT_DIR, '..', '..', 'etc', 'mesh-topologies')
+
+CLK_TCK = os.sysconf('SC_CLK_TCK')
+
+
+class Scenario(object):
+
+    def __init__(self, name: str, seed: int, setup: Callable[[OTNS], None], form_time: float, run_time: float,
+                 traffic: Callable[[OTNS, float], None] = None):
+        self.name = name
+        self.seed = seed
+        self.setup = setup
+        self.form_time = form_time
+        self.run_time = run_time
+        self.traffic = traffic
+
+
+def _load_topology(filename: str) -> Callable[[OTNS], None]:
+
+    def setup(ns: OTNS):
+        ns.load(os.path.join(TOPOLOGIES_DIR, filename))
+
+    return setup
+
+
+def _router_grid(n: int, spacing: int = 80) -> Callable[[OTNS], None]:
+
+    def setup(ns: OTNS):
+        cols = int(n**0.5 + 0.999)
+        for i in range(n):
+            ns.add('router', x=100 + (i % cols) * spacing, y=100 + (i // cols) * spacing)
+
+    return setup
+
+
+def _routers_with_children(n_routers: int, n_children: int, child_type: str) -> Callable[[OTNS], None]:
+
+    def setup(ns: OTNS):
+        _router_grid(n_routers, spacing=120)(ns)
+        cols = int(n_routers**0.5 + 0.999)
+        for i in range(n_children):
+            r = i % n_routers
+            ns.add(child_type, x=130 + (r % cols) * 120 + (i // n_routers) % 5 * 10, y=130 + (r // cols) * 120)
+
+    return setup
+
+
+def _udp_traffic(period: float, datasize: int) -> Callable[[OTNS, float], None]:
+
+    def traffic(ns: OTNS, duration: float):
+        n = len(ns.nodes())
+        t = 0.0
+        i = 0
+        while t < duration:
+            src = 1 + i % n
+            dst = 1 + (i * 7 + 3) % n
+            if src != dst:
+                ns.cmd(f'send udp {src} {dst} ds {datasize}')
+            ns.go(period)
+            t += period
+            i += 1
+
+    return traffic
+
+
+SCENARIOS = [
+    Scenario('office_50', 1001, _load_topology('office_50.yaml'), form_time=300, run_time=300),
+    Scenario('office_200', 1002, _load_topology('office_200.yaml'), form_time=300, run_time=300),
+    Scenario('grid_500', 1003, _router_grid(500), form_time=600, run_time=120),
+    Scenario('grid_2000', 1004, _router_grid(2000), form_time=600, run_time=60),
+    Scenario('sed_heavy', 1005, _routers_with_children(16, 300, 'sed'), form_time=300, run_time=300),
+    Scenario('csl_heavy', 1006, _routers_with_children(16, 200, 'ssed'), form_time=300, run_time=300),
+    Scenario('udp_traffic', 1007, _load_topology('office_50.yaml'), form_time=300, run_time=120,
+             traffic=_udp_traffic(0.05, 64)),
+]
+
+
+def _read_proc_stat(pid: int) -> Tuple[int, float]:
+    """Returns (ppid, cpu-seconds) of a process from /proc/<pid>/stat."""
+    with open(f'/proc/{pid}/stat') as f:
+        stat = f.read()
+    # the command name may contain spaces; the fields of interest follow the closing parenthesis.
+    fields = stat[stat.rindex(')') + 2:].split()
+    ppid = int(fields[1])
+    cpu = (int(fields[11]) + int(fields[12])) / CLK_TCK
+    return ppid, cpu
+
+
+def _read_peak_rss_kb(pid: int) -> int:
+    with open(f'/proc/{pid}/status') as f:
+        for line in f:
+            if line.startswith('VmHWM:'):
+                return int(line.split()[1])
+    return 0
+
+
+def _descendants(pid: int) -> List[int]:
+    children = {}
+    for entry in os.listdir('/proc'):
+        if not entry.isdigit():
+            continue
+        try:
+            ppid, _ = _read_proc_stat(int(entry))
+        except (OSError, ValueError):
+            continue
+        children.setdefault(ppid, []).append(int(entry))
+
+    result = []
+    todo = [pid]
+    while todo:
+        p = todo.pop()
+        for c in children.get(p, []):
+            result.append(c)
+            todo.append(c)
+    return result
+
+
+def _sample_resources(otns_pid: int) -> Dict[str, float]:
+    _, otns_cpu = _read_proc_stat(otns_pid)
+    nodes_cpu = 0.0
+    nodes_rss = 0
+    nodes_rss_max = 0
+    num_nodes = 0
+    for pid in _descendants(otns_pid):
+        try:
+            _, cpu = _read_proc_stat(pid)
+            rss = _read_peak_rss_kb(pid)
+        except (OSError, ValueError):
+            continue  # process exited meanwhile.
+        nodes_cpu += cpu
+        nodes_rss += rss
+        nodes_rss_max = max(nodes_rss_max, rss)
+        num_nodes += 1
+
+    return {
+        'otns_cpu': otns_cpu,
+        'otns_peak_rss_kb': _read_peak_rss_kb(otns_pid),
+        'nodes_cpu': nodes_cpu,
+        'nodes_peak_rss_kb_sum': nodes_rss,
+        'nodes_peak_rss_kb_max': nodes_rss_max,
+        'num_node_processes': num_nodes,
+    }
+
+
+def _count_events(ns: OTNS) -> int:
+    return sum(val for name, val in ns.counters().items() if name.endswith('Events'))
+
+
+def run_scenario(sc: Scenario, trace_dir: str = None) -> Dict:
+    otns_args = ['-log', 'warn', '-logfile', 'none', '-pcap', 'off', '-seed', str(sc.seed)]
+    trace_file = None
+    if trace_dir:
+        trace_file = os.path.join(trace_dir, f'{sc.name}.trace')
+        otns_args += ['-trace', trace_file]
+
+    ns = OTNS(otns_args=otns_args)
+    try:
+        ns.speed = OTNS.MAX_SIMULATE_SPEED
+        t0 = time.time()
+        sc.setup(ns)
+        ns.go(sc.form_time)
+        form_wall = time.time() - t0
+
+        otns_pid = ns._otns.pid
+        res0 = _sample_resources(otns_pid)
+        ev0 = _count_events(ns)
+        t0 = time.time()
+        if sc.traffic:
+            sc.traffic(ns, sc.run_time)
+        else:
+            ns.go(sc.run_time)
+        run_wall = time.time() - t0
+        ev1 = _count_events(ns)
+        res1 = _sample_resources(otns_pid)
+        num_nodes = len(ns.nodes())
+    finally:
+        ns.close()
+
+    return {
+        'scenario': sc.name,
+        'seed': sc.seed,
+        'nodes': num_nodes,
+        'form_sim_sec': sc.form_time,
+        'form_wall_sec': round(form_wall, 3),
+        'run_sim_sec': sc.run_time,
+        'run_wall_sec': round(run_wall, 3),
+        'sim_sec_per_wall_sec': round(sc.run_time / run_wall, 3),
+        'events': ev1 - ev0,
+        'events_per_sec': round((ev1 - ev0) / run_wall, 1),
+        'otns_cpu_sec': round(res1['otns_cpu'] - res0['otns_cpu'], 3),
+        'otns_peak_rss_kb': res1['otns_peak_rss_kb'],
+        'nodes_cpu_sec': round(res1['nodes_cpu'] - res0['nodes_cpu'], 3),
+        'nodes_peak_rss_kb_sum': res1['nodes_peak_rss_kb_sum'],
+        'nodes_peak_rss_kb_max': res1['nodes_peak_rss_kb_max'],
+        'trace_file': trace_file,
+    }
+
+
+def replay_trace(trace_file: str) -> Dict:
+    replay_path = shutil.which('otns-replay')
+    if not replay_path:
+        raise RuntimeError('otns-replay not found in PATH')
+    output = subprocess.check_output([replay_path, '-trace', trace_file])
+    return json.loads(output)
+
+
+def main():
+    logging.basicConfig(format='%(asctime)s - %(levelname)s - %(message)s', level=logging.INFO)
+
+    parser = argparse.ArgumentParser(description='OTNS end-to-end simulation benchmarks')
+    parser.add_argument('--output', help='file to append the JSON result lines to (default: stdout only)')
+    parser.add_argument('--trace-dir', help='directory to record a dispatcher event trace per scenario into')
+    parser.add_argument('--replay', action='store_true', help='replay each recorded trace on the dispatcher alone')
+    parser.add_argument('scenarios', nargs='*', help='scenario names to run (default: all)')
+    args = parser.parse_args()
+
+    names = [sc.name for sc in SCENARIOS]
+    for name in args.scenarios:
+        if name not in names:
+            logging.error('unknown scenario: %s (available: %s)', name, ', '.join(names))
+            sys.exit(1)
+    if args.replay and not args.trace_dir:
+        logging.error('--replay requires --trace-dir')
+        sys.exit(1)
+    if args.trace_dir:
+        os.makedirs(args.trace_dir, exist_ok=True)
+
+    for sc in SCENARIOS:
+        if args.scenarios and sc.name not in args.scenarios:
+            continue
+        logging.info('running benchmark scenario %s (seed %d) ...', sc.name, sc.seed)
+        result = run_scenario(sc, args.trace_dir)
+        if args.replay:
+            result['replay'] = replay_trace(result['trace_file'])
+
+        line = json.dumps(result)
+        print(line, flush=True)
+        if args.output:
+            with open(args.output, 'a') as f:
+                f.write(line + '\n')
+
+
+if __name__ == '__main__':
+    main()
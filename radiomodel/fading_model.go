@@ -61,6 +61,7 @@ func newFadingModel(rndSeed prng.RandomSeed) *fadingModel {
 }
 
 // computeFading calculates shadow fading (SF) and time-variant fading for a radio link based on a simple random process.
+// The link is identified by its linkUID, as computed by calcLinkUID().
 //
 // SF: models a fixed, position-dependent radio signal power attenuation (SF>0) or increase (SF<0) due to multipath effects
 // and static obstacles. In the dB domain it is modeled as a normal distribution (mu=0, sigma).
@@ -77,9 +78,9 @@ func newFadingModel(rndSeed prng.RandomSeed) *fadingModel {
 //   - https://uwspace.uwaterloo.ca/bitstream/handle/10012/16230/Jacob_Midul.pdf?sequence=3&isAllowed=y
 //
 // TODO: better implement the autocorrelation of SF over a correlation length d_cor = 6 m (NLOS case)
-func (sf *fadingModel) computeFading(src *RadioNode, dst *RadioNode, params *RadioModelParams) DbValue {
+func (sf *fadingModel) computeFading(linkUID int64, params *RadioModelParams) DbValue {
 	// each unique (src,dst) link gets a unique random seed
-	seed := int64(sf.rndSeed) + calcLinkUID(src, dst, params.MeterPerUnit)
+	seed := int64(sf.rndSeed) + linkUID
 
 	var vSF, vTVF float64
 	if v, ok := sf.shFadeMap[seed]; ok { // look up if that seed (radio link) was already precomputed.
@@ -0,0 +1,191 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package radiomodel
+
+import (
+	"math"
+	"sort"
+
+	. "github.com/openthread/ot-ns/types"
+)
+
+// txInterference holds the signal power contributions of a single transmission, in linear (mW) units.
+type txInterference struct {
+	channel   ChannelId
+	contribMw map[NodeId]float64 // received power of this transmission, per receiver in interference range
+	intfMw    map[NodeId]float64 // per receiver: accMw - cumMw before start; the total interference after stop
+	isDone    bool
+}
+
+// interferenceAccumulator keeps per-channel, per-receiver running sums of the power of ongoing transmissions,
+// in linear (mW) units. The sums are updated on start and stop of each transmission, only for receivers
+// within interference range, so that the interference seen by a receiver can be looked up in O(1).
+//
+// Besides the current power accMw, a cumulative sum cumMw of the power of all transmissions started on the
+// channel is kept. Together with the intfMw snapshot of a transmission, this gives the sum of received power
+// of all transmissions that overlapped (in time) with that transmission.
+type interferenceAccumulator struct {
+	accMw   map[ChannelId]map[NodeId]float64
+	cumMw   map[ChannelId]map[NodeId]float64
+	tx      map[NodeId]*txInterference
+	numDone int
+	nodeIds []NodeId // sorted, to find the receivers in a deterministic order if no NeighborFinder is set
+}
+
+func newInterferenceAccumulator() *interferenceAccumulator {
+	ia := &interferenceAccumulator{
+		accMw:   map[ChannelId]map[NodeId]float64{},
+		cumMw:   map[ChannelId]map[NodeId]float64{},
+		tx:      map[NodeId]*txInterference{},
+		nodeIds: []NodeId{},
+	}
+	for c := MinChannelNumber; c <= MaxChannelNumber; c++ {
+		ia.accMw[c] = map[NodeId]float64{}
+		ia.cumMw[c] = map[NodeId]float64{}
+	}
+	return ia
+}
+
+func (ia *interferenceAccumulator) addNode(nodeid NodeId) {
+	ia.nodeIds = append(ia.nodeIds, nodeid)
+	sort.Ints(ia.nodeIds)
+}
+
+func (ia *interferenceAccumulator) deleteNode(nodeid NodeId) {
+	ia.txStop(nodeid)
+	for c := MinChannelNumber; c <= MaxChannelNumber; c++ {
+		delete(ia.accMw[c], nodeid)
+		delete(ia.cumMw[c], nodeid)
+	}
+	for i, id := range ia.nodeIds {
+		if id == nodeid {
+			ia.nodeIds = append(ia.nodeIds[:i], ia.nodeIds[i+1:]...)
+			break
+		}
+	}
+}
+
+// txStart adds a new transmission by node src on channel ch to the accumulators, for the receivers dsts that
+// are within interference range. Function getRssi provides the received power (dBm) at a given receiver;
+// receivers where it is RssiMinusInfinity or lower are also skipped.
+func (ia *interferenceAccumulator) txStart(src NodeId, ch ChannelId, dsts []*RadioNode,
+	getRssi func(dst *RadioNode) DbValue) {
+	tx := &txInterference{
+		channel:   ch,
+		contribMw: map[NodeId]float64{},
+		intfMw:    map[NodeId]float64{},
+	}
+	accMw := ia.accMw[ch]
+	cumMw := ia.cumMw[ch]
+	for _, dst := range dsts {
+		if dst.Id == src {
+			continue
+		}
+		rssi := getRssi(dst)
+		if rssi <= RssiMinusInfinity {
+			continue
+		}
+		pMw := dbmToMw(rssi)
+		tx.contribMw[dst.Id] = pMw
+		tx.intfMw[dst.Id] = accMw[dst.Id] - cumMw[dst.Id]
+		accMw[dst.Id] += pMw
+		cumMw[dst.Id] += pMw
+	}
+	ia.tx[src] = tx
+}
+
+// txStop removes the transmission by node src from the current-power accumulators, and finalizes the
+// interference seen by its receivers. The transmission's data is kept until purgeDone() is called, so that
+// its receivers can still evaluate the interference.
+func (ia *interferenceAccumulator) txStop(src NodeId) {
+	tx := ia.tx[src]
+	if tx == nil || tx.isDone {
+		return
+	}
+	accMw := ia.accMw[tx.channel]
+	cumMw := ia.cumMw[tx.channel]
+	for dst, pMw := range tx.contribMw {
+		accMw[dst] -= pMw
+		tx.intfMw[dst] += cumMw[dst] - pMw
+	}
+	tx.isDone = true
+	ia.numDone++
+}
+
+// onChannelIdle resets the accumulators of channel ch, when no transmissions are ongoing anymore, to avoid
+// accumulating rounding errors.
+func (ia *interferenceAccumulator) onChannelIdle(ch ChannelId) {
+	if len(ia.accMw[ch]) > 0 {
+		ia.accMw[ch] = map[NodeId]float64{}
+		ia.cumMw[ch] = map[NodeId]float64{}
+	}
+}
+
+// purgeDone removes the data of all transmissions that were stopped.
+func (ia *interferenceAccumulator) purgeDone() {
+	if ia.numDone == 0 {
+		return
+	}
+	for id, tx := range ia.tx {
+		if tx.isDone {
+			delete(ia.tx, id)
+		}
+	}
+	ia.numDone = 0
+}
+
+// getChannelPowerMw gets the current sum of the received power (mW) of all ongoing transmissions on channel
+// ch, at receiver dst.
+func (ia *interferenceAccumulator) getChannelPowerMw(dst NodeId, ch ChannelId) float64 {
+	return math.Max(ia.accMw[ch][dst], 0.0)
+}
+
+// getTxPowerMw gets the received power (mW) of the (ongoing or just stopped) transmission by src, at
+// receiver dst. Returns 0 if dst is out of interference range.
+func (ia *interferenceAccumulator) getTxPowerMw(src NodeId, dst NodeId) float64 {
+	if tx := ia.tx[src]; tx != nil {
+		return tx.contribMw[dst]
+	}
+	return 0.0
+}
+
+// getInterferenceMw gets the sum of the received power (mW), at receiver dst, of all other transmissions
+// that overlapped in time with the transmission by src.
+func (ia *interferenceAccumulator) getInterferenceMw(src NodeId, dst NodeId) float64 {
+	tx := ia.tx[src]
+	if tx == nil {
+		return 0.0
+	}
+	intfMw, ok := tx.intfMw[dst]
+	if !ok {
+		return 0.0
+	}
+	if !tx.isDone {
+		intfMw += ia.cumMw[tx.channel][dst] - tx.contribMw[dst]
+	}
+	return math.Max(intfMw, 0.0)
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package radiomodel
+
+import (
+	"math"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+
+	"github.com/openthread/ot-ns/prng"
+	. "github.com/openthread/ot-ns/types"
+)
+
+func TestInterferenceAccumulator(t *testing.T) {
+	ia := newInterferenceAccumulator()
+	nodes := []*RadioNode{}
+	for id := 1; id <= 4; id++ {
+		ia.addNode(id)
+		nodes = append(nodes, &RadioNode{Id: id})
+	}
+	// every transmitter is received at -60 dBm (1e-6 mW), except for node 4 which is out of range.
+	getRssi := func(dst *RadioNode) DbValue {
+		if dst.Id == 4 {
+			return RssiMinusInfinity
+		}
+		return -60.0
+	}
+
+	ia.txStart(1, 11, nodes, getRssi)
+	assert.InDelta(t, 1e-6, ia.getChannelPowerMw(2, 11), 1e-12)
+	assert.InDelta(t, 0.0, ia.getChannelPowerMw(2, 12), 1e-12)
+	assert.InDelta(t, 0.0, ia.getChannelPowerMw(4, 11), 1e-12)
+	assert.InDelta(t, 1e-6, ia.getTxPowerMw(1, 3), 1e-12)
+	assert.InDelta(t, 0.0, ia.getInterferenceMw(1, 2), 1e-12)
+
+	// overlapping Tx by node 2, and later by node 3 after node 2 stopped.
+	ia.txStart(2, 11, nodes, getRssi)
+	assert.InDelta(t, 2e-6, ia.getChannelPowerMw(3, 11), 1e-12)
+	ia.txStop(2)
+	assert.InDelta(t, 1e-6, ia.getChannelPowerMw(3, 11), 1e-12)
+	ia.txStart(3, 11, nodes, getRssi)
+	ia.txStop(1)
+
+	// node 1's frame overlapped with both node 2 and node 3 frames.
+	assert.InDelta(t, 1e-6, ia.getInterferenceMw(1, 2), 1e-12) // node 3 (node 2 is the receiver itself)
+	assert.InDelta(t, 1e-6, ia.getInterferenceMw(1, 3), 1e-12) // node 2
+	assert.InDelta(t, 0.0, ia.getInterferenceMw(1, 4), 1e-12)  // out of range
+	assert.InDelta(t, 1e-6, ia.getInterferenceMw(2, 3), 1e-12) // node 1 only; node 3 started after node 2 stopped
+	assert.InDelta(t, 0.0, ia.getInterferenceMw(2, 1), 1e-12)
+
+	ia.txStop(3)
+	assert.InDelta(t, 1e-6, ia.getInterferenceMw(3, 2), 1e-12) // node 1
+	ia.onChannelIdle(11)
+	ia.purgeDone()
+	assert.InDelta(t, 0.0, ia.getChannelPowerMw(2, 11), 1e-12)
+	assert.Equal(t, 0, len(ia.tx))
+	assert.Equal(t, 0, len(ia.cumMw[11]))
+}
+
+func TestInterferenceRange(t *testing.T) {
+	prng.Init(0)
+	rm := NewRadioModel("MutualInterference").(*RadioModelMutualInterference)
+	n1 := NewRadioNode(1, &RadioNodeConfig{X: 0, Y: 0, RadioRange: 200})
+	n2 := NewRadioNode(2, &RadioNodeConfig{X: 100, Y: 0, RadioRange: 200})
+	n3 := NewRadioNode(3, &RadioNodeConfig{X: 1000000, Y: 0, RadioRange: 200})
+	for _, n := range []*RadioNode{n1, n2, n3} {
+		rm.AddNode(n)
+	}
+	n1.TxPower = 0.0
+
+	// only nearby receivers are evaluated for interference; the far node 3 is skipped.
+	r := rm.getInterferenceRange(n1)
+	assert.True(t, r > 100 && r < 1000000)
+	assert.Equal(t, []*RadioNode{n2}, rm.getInterferenceCandidates(n1))
+
+	// a NeighborFinder, if set, does the lookup.
+	rm.SetNeighborFinder(func(src *RadioNode, maxRange float64) []*RadioNode {
+		assert.Equal(t, n1, src)
+		assert.Equal(t, r, maxRange)
+		return []*RadioNode{n2}
+	})
+	assert.Equal(t, []*RadioNode{n2}, rm.getInterferenceCandidates(n1))
+	rm.SetNeighborFinder(nil)
+
+	// a higher Tx power has a larger range.
+	n1.TxPower = 10.0
+	assert.True(t, rm.getInterferenceRange(n1) > r)
+
+	// with disc limit, the range is the radio range.
+	rm.GetParameters().IsDiscLimit = true
+	rm.OnParametersModified()
+	assert.Equal(t, 200.0, rm.getInterferenceRange(n1))
+
+	// no range limit, if all receivers get at least the minimum RSSI.
+	rm.GetParameters().IsDiscLimit = false
+	rm.GetParameters().RssiMinDbm = -100.0
+	rm.OnParametersModified()
+	assert.True(t, math.IsInf(rm.getInterferenceRange(n1), 1))
+	assert.Equal(t, []*RadioNode{n2, n3}, rm.getInterferenceCandidates(n1))
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package radiomodel
+
+import (
+	"github.com/openthread/ot-ns/logger"
+	. "github.com/openthread/ot-ns/types"
+)
+
+// radioLink holds the Tx-power-independent, static properties of the radio link from one node to another.
+type radioLink struct {
+	dist     float64 // distance in grid/pixel units
+	pathloss DbValue // path loss in dB, excluding fading
+	uid      int64   // unique link identifier for the fading model
+	srcPosId uint32  // posId of src node at time of computation
+	dstPosId uint32  // posId of dst node at time of computation
+}
+
+// linkCache caches radioLink values per (src,dst) node pair. Because the path loss doesn't depend on
+// Tx power or channel, the only reasons for an entry to become stale are node moves and parameter changes.
+// Moves are detected by comparing the position identifiers of both nodes; parameter changes clear the cache.
+type linkCache struct {
+	links   map[NodeId]map[NodeId]radioLink
+	numLink int
+}
+
+func newLinkCache() *linkCache {
+	return &linkCache{
+		links: map[NodeId]map[NodeId]radioLink{},
+	}
+}
+
+// get gets the radioLink from src to dst, computing and storing it if not yet cached or stale.
+func (lc *linkCache) get(src *RadioNode, dst *RadioNode, compute func(link *radioLink)) radioLink {
+	srcLinks := lc.links[src.Id]
+	if srcLinks == nil {
+		srcLinks = map[NodeId]radioLink{}
+		lc.links[src.Id] = srcLinks
+	}
+	link, ok := srcLinks[dst.Id]
+	if ok && link.srcPosId == src.posId && link.dstPosId == dst.posId {
+		return link
+	}
+
+	link = radioLink{
+		dist:     src.GetDistanceTo(dst),
+		srcPosId: src.posId,
+		dstPosId: dst.posId,
+	}
+	compute(&link)
+	if !ok {
+		lc.numLink++
+	}
+	srcLinks[dst.Id] = link
+	return link
+}
+
+// deleteNode removes all links from and to the node.
+func (lc *linkCache) deleteNode(nodeid NodeId) {
+	lc.numLink -= len(lc.links[nodeid])
+	delete(lc.links, nodeid)
+	for _, srcLinks := range lc.links {
+		if _, ok := srcLinks[nodeid]; ok {
+			delete(srcLinks, nodeid)
+			lc.numLink--
+		}
+	}
+}
+
+func (lc *linkCache) onAdvanceTime() {
+	// same policy as the fading model: if storage gets too big (e.g. with many moving nodes, or a huge
+	// number of nodes without disc limit), purge it. Items will be recomputed.
+	if lc.numLink > maxCacheSize {
+		lc.clear()
+	}
+}
+
+func (lc *linkCache) clear() {
+	logger.Debugf("Radio model: purging link cache")
+	lc.links = map[NodeId]map[NodeId]radioLink{}
+	lc.numLink = 0
+}
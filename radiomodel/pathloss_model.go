@@ -28,9 +28,9 @@ package radiomodel
 
 import "math"
 
-// computeIndoorRssi computes the RSSI for a receiver at distance dist, using a simple indoor exponent loss model.
-// See https://en.wikipedia.org/wiki/ITU_model_for_indoor_attenuation
-func computeIndoorRssiItu(dist float64, txPower DbValue, modelParams *RadioModelParams) DbValue {
+// computeIndoorPathlossItu computes the path loss (dB) for a receiver at distance dist, using a simple indoor
+// exponent loss model. See https://en.wikipedia.org/wiki/ITU_model_for_indoor_attenuation
+func computeIndoorPathlossItu(dist float64, modelParams *RadioModelParams) DbValue {
 	pathloss := 0.0
 	distMeters := dist * modelParams.MeterPerUnit
 	if distMeters >= 0.01 {
@@ -39,13 +39,12 @@ func computeIndoorRssiItu(dist float64, txPower DbValue, modelParams *RadioModel
 			pathloss = 0.0
 		}
 	}
-	rssi := txPower - pathloss
-	return rssi
+	return pathloss
 }
 
-// computeIndoorRssi3gpp computes the RSSI for a receiver at distance dist, using the Indoor/Office 3GPP
-// model defined in 3GPP TR 38.901 V17.0.0, Table 7.4.1-1: Pathloss models.
-func computeIndoorRssi3gpp(dist float64, txPower DbValue, modelParams *RadioModelParams) DbValue {
+// computeIndoorPathloss3gpp computes the path loss (dB) for a receiver at distance dist, using the Indoor/Office
+// 3GPP model defined in 3GPP TR 38.901 V17.0.0, Table 7.4.1-1: Pathloss models.
+func computeIndoorPathloss3gpp(dist float64, modelParams *RadioModelParams) DbValue {
 	pathloss := 0.0
 	distMeters := dist * modelParams.MeterPerUnit
 	if distMeters >= 0.01 {
@@ -58,6 +57,5 @@ func computeIndoorRssi3gpp(dist float64, txPower DbValue, modelParams *RadioMode
 			pathloss = math.Max(pathloss, pathlossNLOS)
 		}
 	}
-	rssi := txPower - pathloss
-	return rssi
+	return pathloss
 }
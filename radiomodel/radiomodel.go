@@ -51,8 +51,20 @@ type ChannelStats struct {
 
 	numTransmitters map[NodeId]struct{} // internal bookkeeping: on-channel tx nodes
 	txStartTime     uint64              // internal bookkeeping: start of an initial tx on a clear channel
+	pendingEdges    []txEdge            // internal bookkeeping: tx starts/stops after the model time, in time order
 }
 
+// txEdge is the start or stop of a transmission by a node, as kept for the channel stats.
+type txEdge struct {
+	ts      uint64
+	nodeId  NodeId
+	isStart bool
+}
+
+// NeighborFinder gets the RadioNodes, other than src, that are within maxRange distance of src, sorted on NodeId.
+// The caller must not modify the returned slice.
+type NeighborFinder func(src *RadioNode, maxRange float64) []*RadioNode
+
 // RadioModel provides access to any type of radio model.
 type RadioModel interface {
 
@@ -65,6 +77,14 @@ type RadioModel interface {
 	// CheckRadioReachable checks if the srcNode radio can reach the dstNode radio, now, with a >0 probability.
 	CheckRadioReachable(srcNode *RadioNode, dstNode *RadioNode) bool
 
+	// GetMaxRadioRange gets the maximum distance (in grid/pixel units) at which the srcNode radio may reach
+	// another radio, according to the radio model. Returns +Inf if the model doesn't limit the range.
+	GetMaxRadioRange(srcNode *RadioNode) float64
+
+	// SetNeighborFinder sets the function the model uses to find the radio nodes within a given range of a
+	// transmitter, e.g. a spatial index kept by the Dispatcher. If not set, the model checks all nodes.
+	SetNeighborFinder(finder NeighborFinder)
+
 	// GetTxRssi calculates at what RSSI level a radio frame Tx would be received by
 	// dstNode, according to the radio model, in the ideal case of no other transmitters/interferers.
 	// It returns the expected RSSI value at dstNode, or RssiMinusInfinity if the RSSI value will
@@ -79,9 +99,15 @@ type RadioModel interface {
 	OnEventDispatch(srcNode *RadioNode, dstNode *RadioNode, evt *Event) bool
 
 	// OnNextEventTime is called when the Dispatcher moves the simulation time to a higher timestamp ts,
-	// where new event(s) will be executed.
+	// where new event(s) will be executed. No events before ts will be handled anymore.
 	OnNextEventTime(ts uint64)
 
+	// OnEventTime is called when the Dispatcher, in PDES mode, handles the events of a partition at time
+	// instant ts. A partition may run ahead of the simulation time, so ts is at or above the time of the last
+	// OnNextEventTime() call, but it may decrease when moving to the events of a partition that lags behind.
+	// As partitions are radio-isolated, each only sees its own time.
+	OnEventTime(ts uint64)
+
 	// HandleEvent handles all radio-model events coming out of the simulator event queue.
 	// node is the RadioNode object equivalent to evt.NodeId. Newly generated events may be put back into
 	// the EventQueue q for scheduled processing.
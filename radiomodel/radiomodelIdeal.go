@@ -27,6 +27,8 @@
 package radiomodel
 
 import (
+	"sort"
+
 	. "github.com/openthread/ot-ns/event"
 	"github.com/openthread/ot-ns/logger"
 	. "github.com/openthread/ot-ns/types"
@@ -42,7 +44,9 @@ type RadioModelIdeal struct {
 	nodes        map[NodeId]*RadioNode
 	eventQ       EventQueue
 	channelStats map[ChannelId]*ChannelStats
+	links        *linkCache
 	ts           uint64
+	neighbors    NeighborFinder
 }
 
 func (rm *RadioModelIdeal) AddNode(radioNode *RadioNode) {
@@ -50,6 +54,7 @@ func (rm *RadioModelIdeal) AddNode(radioNode *RadioNode) {
 }
 
 func (rm *RadioModelIdeal) DeleteNode(nodeid NodeId) {
+	rm.links.deleteNode(nodeid)
 	rm.statsDeleteNode(rm.nodes[nodeid])
 	delete(rm.nodes, nodeid)
 }
@@ -64,10 +69,21 @@ func (rm *RadioModelIdeal) CheckRadioReachable(src *RadioNode, dst *RadioNode) b
 	return false
 }
 
+func (rm *RadioModelIdeal) GetMaxRadioRange(src *RadioNode) float64 {
+	return src.RadioRange
+}
+
+func (rm *RadioModelIdeal) SetNeighborFinder(finder NeighborFinder) {
+	rm.neighbors = finder
+}
+
 func (rm *RadioModelIdeal) GetTxRssi(srcNode *RadioNode, dstNode *RadioNode) DbValue {
 	var rssi DbValue
 	if rm.params.RssiMinDbm < rm.params.RssiMaxDbm {
-		rssi = computeIndoorRssiItu(srcNode.GetDistanceTo(dstNode), srcNode.TxPower, rm.params)
+		link := rm.links.get(srcNode, dstNode, func(link *radioLink) {
+			link.pathloss = computeIndoorPathlossItu(link.dist, rm.params)
+		})
+		rssi = srcNode.TxPower - link.pathloss
 		if rssi < rm.params.RssiMinDbm {
 			rssi = rm.params.RssiMinDbm
 		} else if rssi > rm.params.RssiMaxDbm {
@@ -95,10 +111,18 @@ func (rm *RadioModelIdeal) OnEventDispatch(src *RadioNode, dst *RadioNode, evt *
 
 func (rm *RadioModelIdeal) OnNextEventTime(ts uint64) {
 	rm.ts = ts
+	rm.links.onAdvanceTime()
+	for _, chStats := range rm.channelStats {
+		rm.applyTxEdges(chStats)
+	}
+}
+
+func (rm *RadioModelIdeal) OnEventTime(ts uint64) {
+	// the Ideal model takes the time of events from the events themselves.
 }
 
 func (rm *RadioModelIdeal) OnParametersModified() {
-	//
+	rm.links.clear()
 }
 
 func (rm *RadioModelIdeal) HandleEvent(node *RadioNode, q EventQueue, evt *Event) {
@@ -133,6 +157,7 @@ func (rm *RadioModelIdeal) GetParameters() *RadioModelParams {
 
 func (rm *RadioModelIdeal) GetChannelStats(channel ChannelId) *ChannelStats {
 	if chanStats, ok := rm.channelStats[channel]; ok {
+		rm.applyTxEdges(chanStats)
 		// check if an operation is ongoing - if so, include portion of to-be-added Tx duration in stats.
 		if len(chanStats.numTransmitters) > 0 && rm.ts > chanStats.txStartTime {
 			chanStats.TxTimeUs += rm.ts - chanStats.txStartTime
@@ -162,6 +187,7 @@ func (rm *RadioModelIdeal) GetPhyStats() map[NodeId]PhyStats {
 func (rm *RadioModelIdeal) init() {
 	rm.nodes = map[NodeId]*RadioNode{}
 	rm.channelStats = make(map[ChannelId]*ChannelStats)
+	rm.links = newLinkCache()
 }
 
 func (rm *RadioModelIdeal) txStart(srcNode *RadioNode, evt *Event) {
@@ -214,11 +240,8 @@ func (rm *RadioModelIdeal) statsTxStart(node *RadioNode, evt *Event) {
 		}
 		rm.channelStats[ch] = chStats
 	}
-	if len(chStats.numTransmitters) == 0 {
-		chStats.txStartTime = evt.Timestamp
-	}
-	chStats.numTransmitters[node.Id] = struct{}{}
 	chStats.NumFrames++
+	rm.addTxEdge(chStats, txEdge{evt.Timestamp, node.Id, true})
 
 	// node stats
 	node.stats.TxBytes += uint64(len(evt.Data) - 1 + PhyHeaderLenBytes)
@@ -229,26 +252,59 @@ func (rm *RadioModelIdeal) statsTxStop(node *RadioNode, evt *Event) {
 	ch := evt.RadioCommData.Channel
 	chStats, ok := rm.channelStats[ch]
 	logger.AssertTrue(ok)
-	logger.AssertTrue(len(chStats.numTransmitters) > 0)
 
-	delete(chStats.numTransmitters, node.Id)
-	if len(chStats.numTransmitters) == 0 {
-		txDur := evt.Timestamp - chStats.txStartTime
-		chStats.TxTimeUs += txDur
-	}
+	rm.addTxEdge(chStats, txEdge{evt.Timestamp, node.Id, false})
 }
 
 func (rm *RadioModelIdeal) statsDeleteNode(node *RadioNode) {
 	ch := node.RadioChannel
 	if chStats, ok := rm.channelStats[ch]; ok {
-		if len(chStats.numTransmitters) == 0 {
-			return
+		rm.applyTxEdges(chStats)
+		if _, ok := chStats.numTransmitters[node.Id]; ok {
+			rm.addTxEdge(chStats, txEdge{rm.ts, node.Id, false})
+		}
+	}
+}
+
+// addTxEdge adds the start or stop of a transmission to the channel stats. In PDES mode, the events of a
+// partition that runs ahead are handled before earlier events of other partitions. The time during which
+// the channel is in use must not depend on that order, so the edges are applied in time order, once the
+// model time rm.ts has reached them.
+func (rm *RadioModelIdeal) addTxEdge(chStats *ChannelStats, edge txEdge) {
+	edges := chStats.pendingEdges
+	i := sort.Search(len(edges), func(i int) bool {
+		return edges[i].ts > edge.ts
+	})
+	edges = append(edges, txEdge{})
+	copy(edges[i+1:], edges[i:])
+	edges[i] = edge
+	chStats.pendingEdges = edges
+	rm.applyTxEdges(chStats)
+}
+
+// applyTxEdges applies the pending tx starts/stops of the channel stats, up to the model time rm.ts.
+func (rm *RadioModelIdeal) applyTxEdges(chStats *ChannelStats) {
+	n := 0
+	for _, edge := range chStats.pendingEdges {
+		if edge.ts > rm.ts {
+			break
 		}
-		delete(chStats.numTransmitters, node.Id)
-		if len(chStats.numTransmitters) == 0 {
-			txDur := rm.ts - chStats.txStartTime
-			chStats.TxTimeUs += txDur
+		if edge.isStart {
+			if len(chStats.numTransmitters) == 0 {
+				chStats.txStartTime = edge.ts
+			}
+			chStats.numTransmitters[edge.nodeId] = struct{}{}
+		} else {
+			logger.AssertTrue(len(chStats.numTransmitters) > 0)
+			delete(chStats.numTransmitters, edge.nodeId)
+			if len(chStats.numTransmitters) == 0 {
+				chStats.TxTimeUs += edge.ts - chStats.txStartTime
+			}
 		}
+		n++
+	}
+	if n > 0 {
+		chStats.pendingEdges = append(chStats.pendingEdges[:0], chStats.pendingEdges[n:]...)
 	}
 }
 
@@ -47,15 +47,30 @@ type RadioModelMutualInterference struct {
 	activeTransmitters    map[ChannelId]map[NodeId]*RadioNode
 	activeChannelSamplers map[ChannelId]map[NodeId]*RadioNode
 	interferedBy          map[NodeId]map[NodeId]*RadioNode
+	intf                  *interferenceAccumulator
+	intfRange             map[DbValue]float64 // cached interference range, per Tx power
 }
 
+const (
+	// interferenceMarginDb is how far (dB) below the noise floor the received power of a transmission may be,
+	// for the receiver to be out of interference range. I.e. it then adds less than 1% to the noise floor.
+	interferenceMarginDb DbValue = 20.0
+
+	// fadingMarginSigmas is the number of standard deviations of the (shadow plus time-variant) fading that
+	// is added to the received power, when determining the interference range.
+	fadingMarginSigmas = 3.0
+)
+
 func (rm *RadioModelMutualInterference) AddNode(radioNode *RadioNode) {
 	rm.nodes[radioNode.Id] = radioNode
 	rm.interferedBy[radioNode.Id] = map[NodeId]*RadioNode{}
+	rm.intf.addNode(radioNode.Id)
 }
 
 func (rm *RadioModelMutualInterference) DeleteNode(nodeid NodeId) {
 	rm.statsDeleteNode(rm.nodes[nodeid])
+	rm.links.deleteNode(nodeid)
+	rm.intf.deleteNode(nodeid)
 	delete(rm.nodes, nodeid)
 	for c := MinChannelNumber; c <= MaxChannelNumber; c++ {
 		delete(rm.activeTransmitters[c], nodeid)
@@ -76,18 +91,29 @@ func (rm *RadioModelMutualInterference) CheckRadioReachable(src *RadioNode, dst
 	return rssi >= RssiMin && rssi <= RssiMax && rssi >= floorDbm
 }
 
+func (rm *RadioModelMutualInterference) GetMaxRadioRange(src *RadioNode) float64 {
+	if rm.params.IsDiscLimit {
+		return src.RadioRange
+	}
+	return math.Inf(1)
+}
+
 func (rm *RadioModelMutualInterference) GetTxRssi(src *RadioNode, dst *RadioNode) DbValue {
 	var rssi DbValue
 
-	dist := src.GetDistanceTo(dst)
-	if rm.params.IsDiscLimit && dist > src.RadioRange {
+	// distance, path loss and fading link id only change when nodes move or parameters change.
+	link := rm.links.get(src, dst, func(link *radioLink) {
+		link.pathloss = computeIndoorPathloss3gpp(link.dist, rm.params)
+		link.uid = calcLinkUID(src, dst, rm.params.MeterPerUnit)
+	})
+	if rm.params.IsDiscLimit && link.dist > src.RadioRange {
 		return RssiMinusInfinity
 	}
 
 	if rm.params.RssiMinDbm < rm.params.RssiMaxDbm {
-		rssi = computeIndoorRssi3gpp(dist, src.TxPower, rm.params)
+		rssi = src.TxPower - link.pathloss
 		if rm.params.ShadowFadingSigmaDb > 0 || rm.params.TimeFadingSigmaMaxDb > 0 {
-			rssi -= rm.fading.computeFading(src, dst, rm.params)
+			rssi -= rm.fading.computeFading(link.uid, rm.params)
 		}
 		if rssi < rm.params.RssiMinDbm {
 			rssi = rm.params.RssiMinDbm
@@ -133,8 +159,14 @@ func (rm *RadioModelMutualInterference) OnEventDispatch(src *RadioNode, dst *Rad
 }
 
 func (rm *RadioModelMutualInterference) OnNextEventTime(ts uint64) {
-	rm.ts = ts
+	rm.RadioModelIdeal.OnNextEventTime(ts)
+	rm.OnEventTime(ts)
+}
+
+func (rm *RadioModelMutualInterference) OnEventTime(ts uint64) {
+	// the fading of a link is evaluated at the time of its partition.
 	rm.fading.onAdvanceTime(ts)
+	rm.intf.purgeDone()
 }
 
 func (rm *RadioModelMutualInterference) OnParametersModified() {
@@ -146,6 +178,8 @@ func (rm *RadioModelMutualInterference) OnParametersModified() {
 		rm.prevParams.MeanTimeFadingChange != rm.params.MeanTimeFadingChange {
 		rm.fading.clearCaches()
 	}
+	rm.links.clear()
+	rm.intfRange = map[DbValue]float64{}
 	rm.prevParams = *rm.params
 }
 
@@ -182,6 +216,8 @@ func (rm *RadioModelMutualInterference) init() {
 		rm.activeChannelSamplers[c] = map[NodeId]*RadioNode{}
 	}
 	rm.interferedBy = map[NodeId]map[NodeId]*RadioNode{}
+	rm.intf = newInterferenceAccumulator()
+	rm.intfRange = map[DbValue]float64{}
 }
 
 func (rm *RadioModelMutualInterference) getRssiAmbientNoise() DbValue {
@@ -189,16 +225,8 @@ func (rm *RadioModelMutualInterference) getRssiAmbientNoise() DbValue {
 }
 
 func (rm *RadioModelMutualInterference) getRssiOnChannel(node *RadioNode, channel ChannelId) DbValue {
-	rssiMax := rm.getRssiAmbientNoise()
-	// loop all active transmitters
-	for _, v := range rm.activeTransmitters[channel] {
-		rssi := rm.GetTxRssi(v, node)
-		if rssi == RssiInvalid {
-			continue
-		}
-		rssiMax = addSignalPowersDbm(rssi, rssiMax)
-	}
-	return rssiMax
+	// ambient noise plus the running sum of all active transmitters.
+	return mwToDbm(dbmToMw(rm.getRssiAmbientNoise()) + rm.intf.getChannelPowerMw(node.Id, channel))
 }
 
 func (rm *RadioModelMutualInterference) txStart(node *RadioNode, evt *Event) {
@@ -231,6 +259,9 @@ func (rm *RadioModelMutualInterference) txStart(node *RadioNode, evt *Event) {
 	}
 
 	rm.activeTransmitters[ch][node.Id] = node
+	rm.intf.txStart(node.Id, ch, rm.getInterferenceCandidates(node), func(dst *RadioNode) DbValue {
+		return rm.GetTxRssi(node, dst)
+	})
 
 	if evt.RadioCommData.Error == OT_ERROR_NONE {
 		// dispatch radio event RadioComm 'start of frame Rx' to listening nodes.
@@ -249,6 +280,63 @@ func (rm *RadioModelMutualInterference) txStart(node *RadioNode, evt *Event) {
 	rm.eventQ.Add(&txDoneEvt)
 }
 
+// getInterferenceRange gets the distance (in grid/pixel units) beyond which a transmission by src, at its
+// current Tx power, does not interfere with other transmissions: its received power is then, even with a
+// fading margin, interferenceMarginDb below the noise floor. Returns +Inf if the range isn't limited.
+func (rm *RadioModelMutualInterference) getInterferenceRange(src *RadioNode) float64 {
+	if rm.params.IsDiscLimit {
+		return src.RadioRange
+	}
+	if r, ok := rm.intfRange[src.TxPower]; ok {
+		return r
+	}
+
+	p := rm.params
+	r := math.Inf(1)
+	thresholdDbm := p.NoiseFloorDbm - interferenceMarginDb
+	if p.NoiseFloorDbm != UndefinedDbValue && p.ShadowFadingSigmaDb != UndefinedDbValue &&
+		p.TimeFadingSigmaMaxDb != UndefinedDbValue && p.RssiMinDbm < p.RssiMaxDbm && p.RssiMinDbm < thresholdDbm {
+		fadingMarginDb := fadingMarginSigmas * math.Hypot(p.ShadowFadingSigmaDb, p.TimeFadingSigmaMaxDb)
+		isInRange := func(dist float64) bool {
+			return src.TxPower-computeIndoorPathloss3gpp(dist, p)+fadingMarginDb >= thresholdDbm
+		}
+		// the path loss increases with distance: find the range by doubling, then bisection.
+		const maxDist = 1e9
+		hi := 1.0
+		for hi < maxDist && isInRange(hi) {
+			hi *= 2
+		}
+		if hi < maxDist {
+			lo := hi / 2
+			for hi-lo > 1.0 {
+				if mid := (lo + hi) / 2; isInRange(mid) {
+					lo = mid
+				} else {
+					hi = mid
+				}
+			}
+			r = hi
+		}
+	}
+	rm.intfRange[src.TxPower] = r
+	return r
+}
+
+// getInterferenceCandidates gets the nodes, sorted on NodeId, that may be within interference range of src.
+func (rm *RadioModelMutualInterference) getInterferenceCandidates(src *RadioNode) []*RadioNode {
+	maxRange := rm.getInterferenceRange(src)
+	if rm.neighbors != nil && !math.IsInf(maxRange, 1) {
+		return rm.neighbors(src, maxRange)
+	}
+	list := make([]*RadioNode, 0, len(rm.intf.nodeIds))
+	for _, id := range rm.intf.nodeIds {
+		if dst := rm.nodes[id]; dst != src && src.GetDistanceTo(dst) <= maxRange {
+			list = append(list, dst)
+		}
+	}
+	return list
+}
+
 func (rm *RadioModelMutualInterference) txStop(node *RadioNode, evt *Event) {
 	ch := evt.RadioCommData.Channel
 	// if channel changed during operation, we need to stop it also at the old channel.
@@ -259,6 +347,10 @@ func (rm *RadioModelMutualInterference) txStop(node *RadioNode, evt *Event) {
 
 	// stop active transmission
 	delete(rm.activeTransmitters[ch], node.Id)
+	rm.intf.txStop(node.Id)
+	if len(rm.activeTransmitters[ch]) == 0 {
+		rm.intf.onChannelIdle(ch)
+	}
 
 	// Dispatch TxDone event back to the source, at time==now
 	txDoneEvt := evt.Copy()
@@ -280,18 +372,14 @@ func (rm *RadioModelMutualInterference) txStop(node *RadioNode, evt *Event) {
 }
 
 func (rm *RadioModelMutualInterference) applyInterference(src *RadioNode, dst *RadioNode, evt *Event) {
-	// Apply interference. Loop all interferers that were active during Tx by 'src' and add their signal powers.
-	powIntfMax := rm.getRssiAmbientNoise()
-	for _, interferer := range rm.interferedBy[src.Id] {
-		if interferer == dst { // if dst node was at some point transmitting itself, fail the Rx
-			rm.log(evt.Timestamp, dst.Id, "Detected self-transmission of Node, set Rx OT_ERROR_ABORT")
-			evt.RadioCommData.Error = OT_ERROR_ABORT
-			return
-		}
-		// calculate how strong the interferer was, as seen by dst
-		powIntf := rm.GetTxRssi(interferer, dst)
-		powIntfMax = addSignalPowersDbm(powIntf, powIntfMax)
+	// Apply interference. If dst node was at some point transmitting itself, fail the Rx.
+	if _, ok := rm.interferedBy[src.Id][dst.Id]; ok {
+		rm.log(evt.Timestamp, dst.Id, "Detected self-transmission of Node, set Rx OT_ERROR_ABORT")
+		evt.RadioCommData.Error = OT_ERROR_ABORT
+		return
 	}
+	// the accumulated signal power of all interferers that were active during Tx by 'src', as seen by dst.
+	powIntfMax := mwToDbm(dbmToMw(rm.getRssiAmbientNoise()) + rm.intf.getInterferenceMw(src.Id, dst.Id))
 
 	// probabilistic BER model
 	rssi := rm.GetTxRssi(src, dst)
@@ -307,9 +395,10 @@ func (rm *RadioModelMutualInterference) updateChannelSamplingNodes(src *RadioNod
 	logger.AssertTrue(evt.Type == EventTypeRadioCommStart)
 	ch := evt.RadioCommData.Channel
 	for _, samplingNode := range rm.activeChannelSamplers[ch] {
-		r := rm.GetTxRssi(src, samplingNode)
-		if r != RssiInvalid {
-			samplingNode.rssiSampleMax = addSignalPowersDbm(r, samplingNode.rssiSampleMax)
+		// the received power was already computed by txStart() for all nodes in range.
+		pMw := rm.intf.getTxPowerMw(src.Id, samplingNode.Id)
+		if pMw > 0 {
+			samplingNode.rssiSampleMax = addSignalPowersDbm(mwToDbm(pMw), samplingNode.rssiSampleMax)
 		}
 	}
 }
@@ -56,6 +56,9 @@ type RadioNode struct {
 	// Node position in units/pixels.
 	X, Y, Z float64
 
+	// posId identifies the current node position; it changes on each position change.
+	posId uint32
+
 	// rssiSampleMax tracks the max RSSI detected during a channel sampling operation.
 	rssiSampleMax DbValue
 
@@ -100,6 +103,7 @@ func (rn *RadioNode) SetRxSensitivity(rxSens DbValue) {
 func (rn *RadioNode) SetNodePos(x, y, z int) {
 	// simplified model: ignore pos changes during Rx.
 	rn.X, rn.Y, rn.Z = float64(x), float64(y), float64(z)
+	rn.posId++
 }
 
 // GetDistanceTo gets the distance to another RadioNode (in grid/pixel units).
@@ -48,6 +48,16 @@ func addSignalPowersDbm(p1 DbValue, p2 DbValue) DbValue {
 	return 10.0 * math.Log10(math.Pow(10, p1/10.0)+math.Pow(10, p2/10.0))
 }
 
+// dbmToMw converts a signal power p (dBm) to linear units (mW).
+func dbmToMw(p DbValue) float64 {
+	return math.Pow(10, p/10.0)
+}
+
+// mwToDbm converts a signal power p (mW) to dBm.
+func mwToDbm(p float64) DbValue {
+	return 10.0 * math.Log10(p)
+}
+
 // clipRssi clips the RSSI value (in dBm, as DbValue) to int8 range for return to OT nodes.
 func clipRssi(rssi DbValue) int8 {
 	if rssi > RssiMax {
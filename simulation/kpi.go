@@ -146,7 +146,8 @@ func (km *KpiManager) retrieveNodeCounters() NodeCountersStore {
 		counters4["phy.tx.bytes"] = phyStats[nid].TxBytes
 		counters4["phy.tx.timeus"] = phyStats[nid].TxTimeUs
 		counters4["phy.chansample.count"] = phyStats[nid].ChanSampleCount
-		nodesMap[nid] = mergeNodeCounters(counters1, counters2, counters3, counters4)
+		counters5 := km.sim.nodes[nid].GetProfileCounters("prof.")
+		nodesMap[nid] = mergeNodeCounters(counters1, counters2, counters3, counters4, counters5)
 		km.sim.nodes[nid].DisplayPendingLogEntries()
 		km.sim.nodes[nid].DisplayPendingLines()
 	}
@@ -28,6 +28,7 @@ package simulation
 
 import (
 	"bufio"
+	"bytes"
 	"context"
 	"encoding/hex"
 	"fmt"
@@ -55,8 +56,14 @@ const (
 	SendCoapResourceName  = "t"
 	SendMcastPrefix       = "ff13::deed"
 	SendUdpPort           = 10000
+
+	// maxUartBlockLines is the max number of lines in a block of UART output, which is at most one
+	// UART-write event's data (OT_EVENT_DATA_MAX_SIZE in OT-RFSIM).
+	maxUartBlockLines = 2048
 )
 
+var uartPrompt = []byte("> ")
+
 type Node struct {
 	S      *Simulation
 	Id     int
@@ -64,11 +71,13 @@ type Node struct {
 	Logger *logger.NodeLogger
 
 	cfg           *NodeConfig
-	cmd           *exec.Cmd
-	cmdErr        error // store the last CLI command error; nil if none.
+	cmd           *exec.Cmd   // nil if the process was spawned by a zygote.
+	process       *os.Process // the node process; nil if not (yet) started.
+	cmdErr        error       // store the last CLI command error; nil if none.
 	version       string
 	threadVersion uint16
 	isSendStarted bool
+	isProfiling   bool // if profiling counters were enabled on the node, via ParamProfile.
 	sendGroupIds  map[int]struct{}
 
 	pendingLines  chan string       // OT node CLI output lines, pending processing.
@@ -76,7 +85,8 @@ type Node struct {
 	pipeIn        io.WriteCloser
 	pipeOut       io.ReadCloser
 	pipeErr       io.ReadCloser
-	uartReader    chan []byte
+	uartReader    chan []byte // blocks of OT node UART output, pending processing.
+	uartLine      []byte      // incomplete last line of the UART output, if any.
 	uartType      NodeUartType
 }
 
@@ -86,28 +96,19 @@ func newNode(s *Simulation, nodeid NodeId, cfg *NodeConfig, dnode *dispatcher.No
 	var err error
 
 	if !cfg.Restore {
-		flashFile := fmt.Sprintf("%s/%d_%d.flash", s.cfg.OutputDir, s.cfg.Id, nodeid)
+		flashFile := s.flashFileName(nodeid)
 		if err = os.RemoveAll(flashFile); err != nil {
 			logger.Errorf("Remove flash file %s failed: %+v", flashFile, err)
 			return nil, err
 		}
 	}
 
-	var cmd *exec.Cmd
-	if cfg.RandomSeed == 0 {
-		cmd = exec.CommandContext(context.Background(), cfg.ExecutablePath, strconv.Itoa(nodeid), s.d.GetUnixSocketName())
-	} else {
-		seedParam := fmt.Sprintf("%d", cfg.RandomSeed)
-		cmd = exec.CommandContext(context.Background(), cfg.ExecutablePath, strconv.Itoa(nodeid), s.d.GetUnixSocketName(), seedParam)
-	}
-
 	node := &Node{
 		S:             s,
 		Id:            nodeid,
 		Logger:        logger.GetNodeLogger(s.cfg.OutputDir, s.cfg.Id, cfg),
 		DNode:         dnode,
 		cfg:           cfg,
-		cmd:           cmd,
 		pendingLines:  make(chan string, 10000),
 		pendingEvents: make(chan *event.Event, 100),
 		uartType:      nodeUartTypeUndefined,
@@ -119,28 +120,70 @@ func newNode(s *Simulation, nodeid NodeId, cfg *NodeConfig, dnode *dispatcher.No
 	node.Logger.SetFileLevel(s.cfg.LogFileLevel)
 	node.Logger.Debugf("Node config: type=%s IsMtd=%t IsRouter=%t IsBR=%t RxOffWhenIdle=%t", cfg.Type, cfg.IsMtd,
 		cfg.IsRouter, cfg.IsBorderRouter, cfg.RxOffWhenIdle)
+
+	if s.cfg.Zygote {
+		err = node.startFromZygote()
+	} else {
+		err = node.startProcess()
+	}
+	if err != nil {
+		return node, err
+	}
+
+	go node.lineReaderStdErr(node.pipeErr) // reads StdErr output from OT node exe and acts on failures
+
+	return node, err
+}
+
+// startProcess executes the node's executable as a new child process.
+func (node *Node) startProcess() error {
+	var err error
+	var cmd *exec.Cmd
+	cfg := node.cfg
+	s := node.S
+	if cfg.RandomSeed == 0 {
+		cmd = exec.CommandContext(context.Background(), cfg.ExecutablePath, strconv.Itoa(node.Id), s.d.GetUnixSocketName())
+	} else {
+		seedParam := fmt.Sprintf("%d", cfg.RandomSeed)
+		cmd = exec.CommandContext(context.Background(), cfg.ExecutablePath, strconv.Itoa(node.Id), s.d.GetUnixSocketName(), seedParam)
+	}
+	cmd.Env = s.nodeEnv()
+	node.cmd = cmd
+
 	node.Logger.Debugf("  exe cmd : %v", cmd)
 	node.Logger.Debugf("  position: (%d,%d,%d)", cfg.X, cfg.Y, cfg.Z)
 
 	if node.pipeIn, err = cmd.StdinPipe(); err != nil {
-		return node, err
+		return err
 	}
 
 	if node.pipeOut, err = cmd.StdoutPipe(); err != nil {
-		return node, err
+		return err
 	}
 
 	if node.pipeErr, err = cmd.StderrPipe(); err != nil {
-		return node, err
+		return err
 	}
 
 	if err = cmd.Start(); err != nil {
-		return node, err
+		return err
 	}
+	node.process = cmd.Process
+	return nil
+}
 
-	go node.lineReaderStdErr(node.pipeErr) // reads StdErr output from OT node exe and acts on failures
+// startFromZygote starts the node process by a fork of the zygote process for the node's executable.
+func (node *Node) startFromZygote() error {
+	z, err := node.S.getZygote(node.cfg.ExecutablePath)
+	if err != nil {
+		return err
+	}
 
-	return node, err
+	node.Logger.Debugf("  zygote  : %s (PID %d)", z.exePath, z.cmd.Process.Pid)
+	node.Logger.Debugf("  position: (%d,%d,%d)", node.cfg.X, node.cfg.Y, node.cfg.Z)
+
+	node.process, node.pipeIn, node.pipeOut, node.pipeErr, err = z.spawn(node.Id, int32(node.cfg.RandomSeed))
+	return err
 }
 
 func (node *Node) String() string {
@@ -177,11 +220,11 @@ func (node *Node) runScript(cfg []string) error {
 }
 
 func (node *Node) signalExit() error {
-	if node.cmd.Process == nil {
+	if node.process == nil {
 		return nil
 	}
-	node.Logger.Tracef("Sending SIGTERM to node process PID %d", node.cmd.Process.Pid)
-	return node.cmd.Process.Signal(syscall.SIGTERM)
+	node.Logger.Tracef("Sending SIGTERM to node process PID %d", node.process.Pid)
+	return node.process.Signal(syscall.SIGTERM)
 }
 
 func (node *Node) exit() error {
@@ -199,9 +242,9 @@ func (node *Node) exit() error {
 	}
 
 	var err error = nil
-	if node.cmd.Process != nil {
+	if node.process != nil {
 		processDone := make(chan bool)
-		node.Logger.Tracef("Waiting for process PID %d to exit ...", node.cmd.Process.Pid)
+		node.Logger.Tracef("Waiting for process PID %d to exit ...", node.process.Pid)
 		timeout := time.After(NodeExitTimeout)
 		go func() {
 			select {
@@ -209,11 +252,15 @@ func (node *Node) exit() error {
 				break
 			case <-timeout:
 				node.Logger.Warn("Node did not exit in time, sending SIGKILL.")
-				_ = node.cmd.Process.Kill()
+				_ = node.process.Kill()
 				processDone <- true
 			}
 		}()
-		err = node.cmd.Wait() // wait for process end
+		if node.cmd != nil {
+			err = node.cmd.Wait() // wait for process end
+		} else {
+			err = waitZygoteChild(node.process)
+		}
 		node.Logger.Tracef("Node process exited. Wait().err=%v", err)
 		<-processDone // signal above kill-goroutine to end
 	}
@@ -408,7 +455,8 @@ func (node *Node) GetRfSimParam(param RfSimParam) RfSimParamValue {
 		ParamCslUncertainty,
 		ParamTxInterferer,
 		ParamClockDrift,
-		ParamCslAccuracy:
+		ParamCslAccuracy,
+		ParamProfile:
 		return node.getOrSetRfSimParam(false, param, 0)
 	case ParamCcaThreshold:
 		return node.GetCcaThreshold()
@@ -442,6 +490,12 @@ func (node *Node) SetRfSimParam(param RfSimParam, value RfSimParamValue) {
 			return
 		}
 		node.getOrSetRfSimParam(true, param, value)
+	case ParamProfile:
+		if value < 0 || value > 1 {
+			node.error(fmt.Errorf("parameter out of range 0-1"))
+			return
+		}
+		node.isProfiling = node.getOrSetRfSimParam(true, param, value) == 1
 	default:
 		node.error(fmt.Errorf("unknown RfSim parameter: %d", param))
 	}
@@ -486,6 +540,10 @@ func (node *Node) getOrSetRfSimParam(isSet bool, param RfSimParam, value RfSimPa
 			if evt.NodeId == node.Id && evt.RfSimParamData.Param == param {
 				return RfSimParamValue(evt.RfSimParamData.Value)
 			}
+			if evt.NodeId == node.Id && evt.RfSimParamData.Param == ParamUnknown {
+				node.error(fmt.Errorf("RfSim parameter %d not supported by node", param))
+				return value
+			}
 		}
 	}
 	node.error(err)
@@ -993,54 +1051,57 @@ func (node *Node) GetCounters(counterType string, keyPrefix string) NodeCounters
 	return res
 }
 
+// GetProfileCounters retrieves the profiling counters of the node process, if profiling was enabled on
+// the node using ParamProfile. Otherwise, it returns empty counters.
+func (node *Node) GetProfileCounters(keyPrefix string) NodeCounters {
+	res := make(NodeCounters)
+	if !node.isProfiling || node.getOrSetRfSimParam(false, ParamProfile, 0) != 1 {
+		return res
+	}
+	for key, val := range node.DNode.GetProfileCounters() {
+		res[keyPrefix+key] = val
+	}
+	return res
+}
+
+// processUartData splits the UART output blocks received from the node into lines, which are put in
+// node.pendingLines. A block may contain many lines, and may end with an incomplete line, which is kept
+// in node.uartLine until its remainder is received. Blocks are only taken from node.uartReader while
+// node.pendingLines has room for all lines of a block; otherwise, they wait for the lines to be read.
 func (node *Node) processUartData() {
-	var deadline <-chan time.Time
 	done := node.S.ctx.Done()
 
 loop:
-	for {
+	for cap(node.pendingLines)-len(node.pendingLines) >= maxUartBlockLines {
 		select {
 		case <-done:
 			break loop
 		case data := <-node.uartReader:
-			line := string(data)
-			if line == "> " { // filter out the prompt.
-				continue
-			}
-			idxNewLine := strings.IndexByte(line, '\n')
-			lineTrim := strings.TrimSpace(line)
-			if idxNewLine == -1 { // if no newline, get more items until a line can be formed.
-				deadline = time.After(dispatcher.DefaultReadTimeout)
-
-			loop2:
-				for {
-					select {
-					case nextData := <-node.uartReader:
-						nextPart := string(nextData)
-						idxNewLinePart := strings.IndexByte(nextPart, '\n')
-						line += nextPart
-						if idxNewLinePart >= 0 {
-							node.pendingLines <- strings.TrimSpace(line)
-							break loop2
-						}
-					case <-done:
-						break loop
-					case <-deadline:
-						line = strings.TrimSpace(line)
-						node.Logger.Panicf("processUart deadline: line=%s", line)
-						break loop2
-					}
-				}
-			} else {
-				node.pendingLines <- lineTrim
-			}
-
+			node.addUartData(data)
 		default:
 			break loop
 		}
 	}
 }
 
+func (node *Node) addUartData(data []byte) {
+	for len(data) > 0 {
+		if len(node.uartLine) == 0 && bytes.HasPrefix(data, uartPrompt) { // filter out the prompt.
+			data = data[len(uartPrompt):]
+			continue
+		}
+		idxNewLine := bytes.IndexByte(data, '\n')
+		if idxNewLine < 0 {
+			node.uartLine = append(node.uartLine, data...)
+			return
+		}
+		node.uartLine = append(node.uartLine, data[:idxNewLine]...)
+		node.pendingLines <- strings.TrimSpace(string(node.uartLine))
+		node.uartLine = node.uartLine[:0]
+		data = data[idxNewLine+1:]
+	}
+}
+
 func (node *Node) onStart() {
 	if node.Logger.IsLevelVisible(logger.InfoLevel) {
 		node.Logger.Infof("started, panid=0x%04x, chan=%d, eui64=%#v, extaddr=%#v, state=%s, key=%#v, mode=%v",
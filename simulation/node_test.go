@@ -0,0 +1,61 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package simulation
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func readPendingLines(node *Node) []string {
+	var lines []string
+	for len(node.pendingLines) > 0 {
+		lines = append(lines, <-node.pendingLines)
+	}
+	return lines
+}
+
+func TestAddUartData(t *testing.T) {
+	node := &Node{pendingLines: make(chan string, 100)}
+
+	// a block with multiple lines, a prompt and an incomplete last line.
+	node.addUartData([]byte("fd00::1\r\nfe80::2\r\nDone\r\n> ipad"))
+	assert.Equal(t, []string{"fd00::1", "fe80::2", "Done"}, readPendingLines(node))
+	assert.Equal(t, []byte("ipad"), node.uartLine)
+
+	// remainder of the line, in two blocks; the prompt is only filtered at the start of a line.
+	node.addUartData([]byte("dr"))
+	node.addUartData([]byte(" > x\r\n"))
+	assert.Equal(t, []string{"ipaddr > x"}, readPendingLines(node))
+	assert.Equal(t, 0, len(node.uartLine))
+
+	// a prompt-only block, and an empty line.
+	node.addUartData([]byte("> "))
+	node.addUartData([]byte("\r\n"))
+	assert.Equal(t, []string{""}, readPendingLines(node))
+}
@@ -63,6 +63,7 @@ type Simulation struct {
 	nodePlacer     *NodeAutoPlacer
 	kpiMgr         *KpiManager
 	simHosts       *SimHosts
+	zygotes        map[string]*zygote // zygote per node executable path, if cfg.Zygote is set.
 }
 
 func NewSimulation(ctx *progctx.ProgCtx, cfg *Config, dispatcherCfg *dispatcher.Config) (*Simulation, error) {
@@ -72,6 +73,7 @@ func NewSimulation(ctx *progctx.ProgCtx, cfg *Config, dispatcherCfg *dispatcher.
 		ctx:          ctx,
 		cfg:          cfg,
 		nodes:        map[NodeId]*Node{},
+		zygotes:      map[string]*zygote{},
 		autoGo:       cfg.AutoGo || cfg.Realtime,
 		autoGoChange: make(chan bool, 1),
 		networkInfo:  visualize.DefaultNetworkInfo(),
@@ -343,9 +345,39 @@ func (s *Simulation) Stop() {
 		_ = node.exit()
 	}
 
+	for _, z := range s.zygotes {
+		z.close()
+	}
+
 	logger.Debugf("all simulation nodes exited.")
 }
 
+// getZygote returns the zygote for the given node executable, starting it if needed.
+func (s *Simulation) getZygote(exePath string) (*zygote, error) {
+	if z, ok := s.zygotes[exePath]; ok {
+		return z, nil
+	}
+	z, err := newZygote(exePath, s.d.GetUnixSocketName(), s.nodeEnv())
+	if err != nil {
+		return nil, errors.Wrapf(err, "start zygote for %s", exePath)
+	}
+	s.zygotes[exePath] = z
+	return z, nil
+}
+
+// flashFileName returns the name of the flash file of a node, as used by the node.
+func (s *Simulation) flashFileName(nodeid NodeId) string {
+	return fmt.Sprintf("%s/%d_%d.flash", s.cfg.OutputDir, s.cfg.Id, nodeid)
+}
+
+// nodeEnv returns the environment for node processes, or nil to use the simulator's environment.
+func (s *Simulation) nodeEnv() []string {
+	if s.cfg.FlashSync != "" {
+		return append(os.Environ(), "RFSIM_FLASH_SYNC="+s.cfg.FlashSync)
+	}
+	return nil
+}
+
 func (s *Simulation) SetVisualizer(vis visualize.Visualizer) {
 	logger.AssertNotNil(vis)
 	s.vis = vis
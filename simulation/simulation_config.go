@@ -61,6 +61,8 @@ type Config struct {
 	LogFileLevel     logger.Level
 	RandomSeed       prng.RandomSeed
 	OutputDir        string
+	FlashSync        string // node flash sync policy, passed to ot-rfsim nodes; empty for node default.
+	Zygote           bool   // start nodes by forking a zygote process, instead of executing each node.
 }
 
 func DefaultConfig() *Config {
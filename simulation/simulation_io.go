@@ -27,7 +27,9 @@
 package simulation
 
 import (
+	"encoding/base64"
 	"fmt"
+	"os"
 
 	"github.com/openthread/ot-ns/logger"
 )
@@ -81,6 +83,25 @@ func (s *Simulation) ExportNodes(nwConfig *YamlNetworkConfig) []YamlNodeConfig {
 	return res
 }
 
+// ExportNodesFlash adds the current flash contents of each node to the exported nodes, so that the nodes can be
+// restored later from this checkpoint with their Thread network state. It must be called while the simulation is
+// paused, such that the nodes are not writing their flash.
+func (s *Simulation) ExportNodesFlash(nodes []YamlNodeConfig) error {
+	if s.cfg.FlashSync == "ram" {
+		return fmt.Errorf("nodes have no flash file (flash-sync is 'ram')")
+	}
+	for i := range nodes {
+		flash, err := os.ReadFile(s.flashFileName(nodes[i].ID))
+		if os.IsNotExist(err) {
+			continue // node without flash, e.g. an interferer node.
+		} else if err != nil {
+			return err
+		}
+		nodes[i].Flash = base64.StdEncoding.EncodeToString(flash)
+	}
+	return nil
+}
+
 func (s *Simulation) ImportNodes(nwConfig YamlNetworkConfig, nodes []YamlNodeConfig) error {
 	allOk := true
 	rr := defaultRadioRange
@@ -111,6 +132,19 @@ func (s *Simulation) ImportNodes(nwConfig YamlNetworkConfig, nodes []YamlNodeCon
 		if node.Version != nil {
 			cfg.Version = *node.Version
 		}
+		if len(node.Flash) > 0 {
+			// restore the node from the checkpoint flash contents.
+			flash, err := base64.StdEncoding.DecodeString(node.Flash)
+			if err == nil {
+				err = os.WriteFile(s.flashFileName(cfg.ID), flash, 0600)
+			}
+			if err != nil {
+				logger.Warnf("Warn: node %d flash restore failed: %s", cfg.ID, err)
+				allOk = false
+				continue
+			}
+			cfg.Restore = true
+		}
 
 		s.NodeConfigFinalize(&cfg)
 		_, err := s.AddNode(&cfg)
@@ -103,6 +103,7 @@ type YamlNodeConfig struct {
 	Version    *string `yaml:"version,omitempty"` // Thread version string or "" for default
 	Position   [3]int  `yaml:"pos,flow"`
 	RadioRange *int    `yaml:"radio-range,omitempty"`
+	Flash      string  `yaml:"flash,omitempty"` // base64 node flash (settings) contents, only in a checkpoint.
 }
 
 func (yc *YamlConfigFile) MinNodeId() NodeId {
@@ -0,0 +1,172 @@
+// Copyright (c) 2024, The OTNS Authors.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. Neither the name of the copyright holder nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+package simulation
+
+import (
+	"encoding/binary"
+	"io"
+	"net"
+	"os"
+	"os/exec"
+	"strconv"
+	"sync"
+	"syscall"
+	"time"
+
+	"github.com/pkg/errors"
+
+	"github.com/openthread/ot-ns/logger"
+	. "github.com/openthread/ot-ns/types"
+)
+
+const (
+	zygoteCtlFd           = 3 // fd number of the control socket in the zygote process (first of ExtraFiles)
+	zygoteRequestSize     = 8
+	zygoteReplySize       = 4
+	zygoteProcessPollTime = time.Millisecond * 10
+)
+
+// zygote is a node executable started in zygote (fork-server) mode. It is loaded and initialized once, and forks
+// a new node process for each spawn request. Requests are sent over a SOCK_SEQPACKET control socket, along with the
+// stdin/stdout/stderr file descriptors for the new node.
+type zygote struct {
+	exePath string
+	cmd     *exec.Cmd
+	ctl     *net.UnixConn
+	mutex   sync.Mutex
+}
+
+func newZygote(exePath string, socketName string, env []string) (*zygote, error) {
+	fds, err := syscall.Socketpair(syscall.AF_UNIX, syscall.SOCK_SEQPACKET, 0)
+	if err != nil {
+		return nil, err
+	}
+	syscall.CloseOnExec(fds[0])
+	syscall.CloseOnExec(fds[1])
+	ctlFile := os.NewFile(uintptr(fds[0]), "zygote-ctl")
+	childCtlFile := os.NewFile(uintptr(fds[1]), "zygote-ctl-child")
+	defer ctlFile.Close()
+	defer childCtlFile.Close()
+
+	cmd := exec.Command(exePath, "zygote", socketName, strconv.Itoa(zygoteCtlFd))
+	cmd.Env = env
+	cmd.ExtraFiles = []*os.File{childCtlFile}
+	cmd.Stderr = os.Stderr
+	if err = cmd.Start(); err != nil {
+		return nil, err
+	}
+
+	conn, err := net.FileConn(ctlFile)
+	if err != nil {
+		_ = cmd.Process.Kill()
+		_ = cmd.Wait()
+		return nil, err
+	}
+
+	logger.Debugf("Started zygote PID %d for %s", cmd.Process.Pid, exePath)
+	return &zygote{
+		exePath: exePath,
+		cmd:     cmd,
+		ctl:     conn.(*net.UnixConn),
+	}, nil
+}
+
+// spawn requests the zygote to fork a new node process. It returns the new process and the pipes connected
+// to its stdin, stdout and stderr.
+func (z *zygote) spawn(nodeid NodeId, randomSeed int32) (*os.Process, io.WriteCloser, io.ReadCloser, io.ReadCloser, error) {
+	var pipes [6]*os.File // stdin r/w, stdout r/w, stderr r/w
+	var err error
+	for i := 0; i < len(pipes); i += 2 {
+		if pipes[i], pipes[i+1], err = os.Pipe(); err != nil {
+			closeFiles(pipes[:i])
+			return nil, nil, nil, nil, err
+		}
+	}
+	childFiles := []*os.File{pipes[0], pipes[3], pipes[5]}
+	defer closeFiles(childFiles)
+
+	req := make([]byte, zygoteRequestSize)
+	binary.LittleEndian.PutUint32(req[0:4], uint32(nodeid))
+	binary.LittleEndian.PutUint32(req[4:8], uint32(randomSeed))
+	rights := syscall.UnixRights(int(pipes[0].Fd()), int(pipes[3].Fd()), int(pipes[5].Fd()))
+	reply := make([]byte, zygoteReplySize)
+
+	z.mutex.Lock()
+	_, _, err = z.ctl.WriteMsgUnix(req, rights, nil)
+	if err == nil {
+		var n int
+		if n, err = z.ctl.Read(reply); err == nil && n != zygoteReplySize {
+			err = errors.Errorf("zygote reply has invalid size %d", n)
+		}
+	}
+	z.mutex.Unlock()
+
+	var proc *os.Process
+	if err == nil {
+		pid := int32(binary.LittleEndian.Uint32(reply))
+		if pid <= 0 {
+			err = errors.Errorf("zygote %s failed to fork node %d", z.exePath, nodeid)
+		} else {
+			proc, err = os.FindProcess(int(pid))
+		}
+	}
+	if err != nil {
+		closeFiles([]*os.File{pipes[1], pipes[2], pipes[4]})
+		return nil, nil, nil, nil, err
+	}
+	return proc, pipes[1], pipes[2], pipes[4], nil
+}
+
+// close stops the zygote. Node processes spawned by it are not affected.
+func (z *zygote) close() {
+	_ = z.ctl.Close() // the zygote exits when its control socket is closed.
+	done := make(chan struct{})
+	go func() {
+		select {
+		case <-done:
+		case <-time.After(NodeExitTimeout):
+			_ = z.cmd.Process.Kill()
+		}
+	}()
+	_ = z.cmd.Wait()
+	close(done)
+}
+
+// waitZygoteChild waits until a process spawned by a zygote has ended. Such a process is not a child of the
+// simulator (it is reaped by the zygote), so it can't be waited on and is polled instead.
+func waitZygoteChild(proc *os.Process) error {
+	for proc.Signal(syscall.Signal(0)) == nil {
+		time.Sleep(zygoteProcessPollTime)
+	}
+	return nil
+}
+
+func closeFiles(files []*os.File) {
+	for _, f := range files {
+		_ = f.Close()
+	}
+}
@@ -114,6 +114,8 @@ const (
 	ParamCslUncertainty RfSimParam = 3
 	ParamTxInterferer   RfSimParam = 4
 	ParamClockDrift     RfSimParam = 5
+	ParamLogLevel       RfSimParam = 6 // internal use by the dispatcher; not user-settable.
+	ParamProfile        RfSimParam = 7
 	ParamUnknown        RfSimParam = 255
 )
 
@@ -125,9 +127,9 @@ const (
 )
 
 var RfSimParamsList = []RfSimParam{ParamRxSensitivity, ParamCcaThreshold, ParamCslAccuracy, ParamCslUncertainty,
-	ParamTxInterferer, ParamClockDrift}
-var RfSimParamNamesList = []string{"rxsens", "ccath", "cslacc", "cslunc", "txintf", "clkdrift"}
-var RfSimParamUnitsList = []string{"dBm", "dBm", "PPM", "10-us", "%", "PPM"}
+	ParamTxInterferer, ParamClockDrift, ParamProfile}
+var RfSimParamNamesList = []string{"rxsens", "ccath", "cslacc", "cslunc", "txintf", "clkdrift", "profile"}
+var RfSimParamUnitsList = []string{"dBm", "dBm", "PPM", "10-us", "%", "PPM", "on/off"}
 
 func ParseRfSimParam(parName string) RfSimParam {
 	for i := 0; i < len(RfSimParamsList); i++ {